@@ -102,6 +102,8 @@
  * For ADVANCED OK (M105) you need 32 bytes.
  * For debug-echo: 128 bytes for the optimal speed.
  * Other output doesn't need to be that speedy.
+ * With a TX buffer, auto-reports wait for free space while moving,
+ * instead of stalling the main loop.
  * 0, 2, 4, 8, 16, 32, 64, 128, 256
  */
 #define TX_BUFFER_SIZE 0
@@ -132,6 +134,25 @@
  */
 //#define SERIAL_STATS_DROPPED_RX
 
+/**
+ * Selective resend
+ * Lines that arrive after a missing or corrupt one are held, so the host
+ * needs to resend only that line. Lines received twice are skipped with "ok".
+ * Lines may end with "^<crc>", a CRC16 (CCITT, init 0xFFFF) of the text
+ * before '^', in place of the "*<xor>" checksum.
+ * SELECTIVE_RESEND_WINDOW lines of MAX_CMD_SIZE bytes are used to hold lines.
+ */
+//#define SELECTIVE_RESEND
+#define SELECTIVE_RESEND_WINDOW    4  // Lines held while waiting for a missing one
+#define SELECTIVE_RESEND_HISTORY  16  // Line numbers kept to recognize duplicates
+#define SELECTIVE_RESEND_TIMEOUT 500  // ms before asking again for the same line
+
+/**
+ * Enable this option to measure the time spent waiting for
+ * free space in the TX buffer. Report it with M576.
+ */
+//#define SERIAL_STATS_TX_BLOCKED
+
 /**
  * User-specified version info of this build to display in [Pronterface, etc] terminal window during
  * startup. Implementation of an idea by Prof Braino to inform user that any changes made to this
@@ -173,7 +194,16 @@
 //#define FASTER_GCODE_PARSER
 
 /**
- * Spend more bytes of SRAM to optimize the GCode execute
+ * Spend 208 bytes of SRAM to tokenize the GCode line in a single pass,
+ * storing pre-converted values for all the parameters.
+ * Requires FASTER_GCODE_PARSER
+ */
+//#define FASTER_GCODE_VALUES
+
+/**
+ * Spend more bytes of SRAM to optimize the GCode execute.
+ * G and M codes are dispatched through direct index tables built at compile time
+ * and kept in flash (2 bytes per code, M-codes up to M1001).
  */
 //#define FASTER_GCODE_EXECUTE
 
@@ -230,10 +230,22 @@
 
 // Z Probe repetitions, median for best result
 #define Z_PROBE_REPETITIONS 1
+// With more repetitions, stop as soon as the samples agree within this deviation in mm
+#define Z_PROBE_REPETITIONS_SIGMA 0.005
+// Discard samples further than this many deviations from the mean (0 to keep all)
+#define Z_PROBE_OUTLIER_SIGMA 3
 
 // Enable Z Probe Repeatability test to see how accurate your probe is
 //#define PROBE_REPEATABILITY_TEST
 
+// Flying probing for G29 with fast probes (inductive, BLTouch in HIGH SPEED mode).
+// Each point is a single probe at Z_PROBE_SPEED_FAST, the trigger Z is taken
+// from the step position recorded by the endstop interrupt (ENDSTOP_INTERRUPTS_FEATURE).
+// The lift to Z_PROBE_BETWEEN_HEIGHT, the travel to the next point and the descent
+// are queued one after the other, so the only stop is at the trigger.
+// Use "G29 K0" to probe with the normal cycle.
+//#define PROBE_FLYING
+
 // Before deploy/stow pause for user confirmation
 //#define PAUSE_BEFORE_DEPLOY_STOW
 
@@ -473,6 +485,13 @@
 
 // When the nozzle is off the mesh, this value is used as the Z-Height correction value.
 //#define UBL_Z_RAISE_WHEN_OFF_MESH 2.5
+
+// Blend the meshes stored with G29 S at several bed temperatures by the
+// current bed temperature, so a heat soak doesn't need a new probing.
+// Store a mesh at each bed temperature, then turn it on with M424 S1.
+//#define UBL_MESH_TEMP_BLEND
+#define MESH_BLEND_SLOTS        4     // Max number of meshes in the blend
+#define MESH_BLEND_RESOLUTION   0.5   // (C) Bed temperature change to update the mesh
 /** END UNIFIED BED LEVELING **/
 
 /** START MESH BED LEVELING or AUTO BED LEVELING LINEAR or AUTO BED LEVELING BILINEAR or UNIFIED BED LEVELING **/
@@ -490,6 +509,13 @@
 //#define ABL_BILINEAR_SUBDIVISION
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
+
+// Adaptive mesh. "G29 A" probes only the print area of the selected SD file,
+// at the same grid spacing. The area is read from the slicer bounds in the
+// file header (;MINX: ;MINY: ;MAXX: ;MAXY:) or else from a scan of the
+// extrusion moves, the first time G29 A runs for the file.
+//#define ADAPTIVE_MESH
+#define ADAPTIVE_MESH_MARGIN 5  // (mm) Margin around the print area
 /** END AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR **/
 
 // Commands to execute at the end of G29 probing.
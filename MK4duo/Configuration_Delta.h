@@ -293,6 +293,10 @@
 
 // Z Probe repetitions, median for best result
 #define Z_PROBE_REPETITIONS 1
+// With more repetitions, stop as soon as the samples agree within this deviation in mm
+#define Z_PROBE_REPETITIONS_SIGMA 0.005
+// Discard samples further than this many deviations from the mean (0 to keep all)
+#define Z_PROBE_OUTLIER_SIGMA 3
 
 // Enable Z Probe Repeatability test to see how accurate your probe is
 //#define PROBE_REPEATABILITY_TEST
@@ -449,6 +453,13 @@
 
 // When the nozzle is off the mesh, this value is used as the Z-Height correction value.
 //#define UBL_Z_RAISE_WHEN_OFF_MESH 2.5
+
+// Blend the meshes stored with G29 S at several bed temperatures by the
+// current bed temperature, so a heat soak doesn't need a new probing.
+// Store a mesh at each bed temperature, then turn it on with M424 S1.
+//#define UBL_MESH_TEMP_BLEND
+#define MESH_BLEND_SLOTS        4     // Max number of meshes in the blend
+#define MESH_BLEND_RESOLUTION   0.5   // (C) Bed temperature change to update the mesh
 /** END Unified Bed Leveling */
 
 // Set the number of grid points per dimension
@@ -465,6 +476,13 @@
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
 
+// Adaptive mesh. "G29 A" probes only the print area of the selected SD file,
+// at the same grid spacing. The area is read from the slicer bounds in the
+// file header (;MINX: ;MINY: ;MAXX: ;MAXY:) or else from a scan of the
+// extrusion moves, the first time G29 A runs for the file.
+//#define ADAPTIVE_MESH
+#define ADAPTIVE_MESH_MARGIN 5  // (mm) Margin around the print area
+
 // Commands to execute at the end of G29 probing.
 // Useful to retract or move the Z probe out of the way.
 //#define Z_PROBE_END_SCRIPT "G1 Z10 F8000\nG1 X10 Y10\nG1 Z0.5"
@@ -486,6 +504,7 @@
 //#define DELTA_AUTO_CALIBRATION_1
 //#define DELTA_AUTO_CALIBRATION_2
 
+// Factors 3, 4, 6 or 7 (with diagonal rod)
 #define DELTA_AUTO_CALIBRATION_1_DEFAULT_FACTOR 6
 #define DELTA_AUTO_CALIBRATION_1_DEFAULT_POINTS 7
 
@@ -105,6 +105,19 @@
 #define CALIBRATION_CURRENT 250
 #define CALIBRATION_EXTRA_HEIGHT 10
 
+// M916 Sensorless homing calibration
+// - Search the most sensitive StallGuard threshold that runs the axis free
+//   and still stalls at its end,
+// - Raise the homing feedrate by steps while a threshold is found, and
+// - Keep the fastest feedrate with its threshold (M914). Save with M500.
+// Requires SENSORLESS_HOMING on a Cartesian or Core machine. Z only with "M916 Z"
+// and when it homes to max. The feedrate stays under the axis max feedrate.
+//#define TMC_SENSORLESS_CALIBRATION
+#define SENSORLESS_CALIBRATION_TRAVEL       50  // Free run of each trial (mm)
+#define SENSORLESS_CALIBRATION_CLEARANCE     5  // Free run stops this far from the end (mm)
+#define SENSORLESS_CALIBRATION_MARGIN        2  // Threshold steps added to the one found
+#define SENSORLESS_CALIBRATION_MAX_FEEDRATE 150  // Highest homing feedrate tried (mm/s)
+
 // Software enable
 // Use for drivers that do not use a dedicated enable pin, but rather handle the same
 // function through a communication line such as SPI or UART.
@@ -148,6 +161,7 @@
 // M922 - Report driver parameters. (Requires TMC_DEBUG)
 //#define MONITOR_DRIVER_STATUS
 //#define MONITOR_DRIVER_STATUS_INTERVAL_MS 500u
+//#define TMC_QUEUE_TIME_US     250u  // Max time each idle loop spends in driver reads
 //#define CURRENT_STEP_DOWN     50  // [mA]
 //#define REPORT_CURRENT_CHANGE
 //#define STOP_ON_ERROR
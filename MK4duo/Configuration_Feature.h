@@ -113,6 +113,7 @@
  * - Advanced Pause Park
  * - G20/G21 Inch mode support
  * - Report JSON-style response
+ * - Status snapshot
  * - Scad Mesh Output
  * - M43 command for pins info and testing
  * - Debug Feature
@@ -242,7 +243,13 @@
 #define CONTROLLERFAN_MIN_SPEED       0
 
 // Add Tachometric option for fan ONLY FOR DUE. (Add TACHOMETRIC PIN in configuration pins)
+// M106 R<rpm> holds the fan at the given RPM, a fan driven without tach pulses is reported as stalled
 //#define TACHOMETRIC
+#define FAN_RPM_PERIOD    100   // (ms) RPM control period
+#define FAN_RPM_KP        0.01  // PWM for each RPM of error
+#define FAN_RPM_KI        0.05  // PWM per second for each RPM of error
+#define FAN_STALL_TIME      5   // (s) Time without tach pulses before a fan is stalled
+#define FAN_STALL_MIN_PWM  64   // Minimum PWM that must spin the fan
 /****************************************************************************/
 
 
@@ -2096,6 +2103,62 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ *********************************** STATUS SNAPSHOT *************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * The text of M105, M114 and M408 S0 is built in a buffer and sent with a single write. *
+ * It is rebuilt only if the values shown are changed, auto-reports at most once every   *
+ * STATUS_SNAPSHOT_PERIOD ms, so hosts polling many times a second cost little time.     *
+ * Adds auto report of the position with M154 S<seconds> or P<ms>,                       *
+ * of the temperatures with M155 P<ms> and of the JSON status with M408 A<ms>.           *
+ * Uses about 350 bytes of RAM, about 400 more with JSON_OUTPUT.                         *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define STATUS_SNAPSHOT
+#define STATUS_SNAPSHOT_PERIOD 250
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ *********************************** TEMPERATURE HISTORY *********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Keep the last TEMP_HISTORY_SAMPLES samples of temperature, target and PWM of every    *
+ * heater, one every TEMP_HISTORY_PERIOD ms (multiple of 100).                           *
+ * M156 dumps them as CSV (S0) or delta-encoded (S1), M156 L1 writes every new sample    *
+ * to temphist.csv on the SD until M156 L0.                                              *
+ * Uses 3 bytes of RAM for each heater and sample.                                       *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define TEMP_HISTORY
+#define TEMP_HISTORY_SAMPLES  300
+#define TEMP_HISTORY_PERIOD  1000
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ********************************* LAYER TIME SCHEDULER **********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Estimate the time of each layer from the moves queued in the planner. A layer begins  *
+ * with the first extrusion at a higher Z. If the last layer took less than              *
+ * MIN_LAYER_TIME the speed is lowered (down to MIN_LAYER_SPEED % of the M220 speed) so  *
+ * the next one takes MIN_LAYER_TIME, and the fan LAYER_FAN is raised from the speed of  *
+ * the slicer at LAYER_FAN_TIME to LAYER_FAN_MAX_SPEED at MIN_LAYER_TIME.                *
+ * Speed and fan are restored when the planner is empty for 10 seconds.                  *
+ * Set with M157.                                                                        *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define LAYER_TIME_SCHEDULER
+#define MIN_LAYER_TIME        10  // (s)
+#define MIN_LAYER_SPEED       30  // (%)
+#define LAYER_FAN_TIME        30  // (s)
+#define LAYER_FAN_MAX_SPEED  255
+#define LAYER_FAN              0
+/*****************************************************************************************/
+
+
 /**************************************************************************
  ************************* Scad Mesh Output *******************************
  **************************************************************************
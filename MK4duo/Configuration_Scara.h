@@ -232,6 +232,10 @@
 
 // Z Probe repetitions, median for best result
 #define Z_PROBE_REPETITIONS 1
+// With more repetitions, stop as soon as the samples agree within this deviation in mm
+#define Z_PROBE_REPETITIONS_SIGMA 0.005
+// Discard samples further than this many deviations from the mean (0 to keep all)
+#define Z_PROBE_OUTLIER_SIGMA 3
 
 // Enable Z Probe Repeatability test to see how accurate your probe is
 //#define PROBE_REPEATABILITY_TEST
@@ -465,6 +469,13 @@
 //#define ABL_BILINEAR_SUBDIVISION
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
+
+// Adaptive mesh. "G29 A" probes only the print area of the selected SD file,
+// at the same grid spacing. The area is read from the slicer bounds in the
+// file header (;MINX: ;MINY: ;MAXX: ;MAXY:) or else from a scan of the
+// extrusion moves, the first time G29 A runs for the file.
+//#define ADAPTIVE_MESH
+#define ADAPTIVE_MESH_MARGIN 5  // (mm) Margin around the print area
 /** END AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR **/
 
 // Commands to execute at the end of G29 probing.
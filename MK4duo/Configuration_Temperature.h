@@ -252,9 +252,13 @@
 
 // this adds an experimental additional term to the heating power, proportional to the extrusion speed.
 // if Kc is chosen well, the additional required power due to increased melting should be compensated.
+// The extrusion speed is averaged over the moves queued in the planner for the next L (M301) PID samples.
 //#define PID_ADD_EXTRUSION_RATE
 #define LPQ_MAX_LEN 50
 
+// Smoothing of the derivative term, 0.0 - 1.0 (1.0 = no filter). The PID runs every 100ms.
+#define PID_DERIVATIVE_FILTER 0.15
+
 //      HotEnd    {HE0,HE1,HE2,HE3,HE4,HE5}
 #define HOTEND_Kp {40, 40, 40, 40, 40, 40}
 #define HOTEND_Ki {07, 07, 07, 07, 07, 07}
@@ -263,6 +267,37 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ********************** MPC Settings - HOTEND **************************
+ ***********************************************************************
+ *                                                                     *
+ * Model predictive control for the hotends, in place of the PID.      *
+ * A thermal model of the heater block (heater power, heat capacity,   *
+ * loss to ambient, extra loss with the part fan FAN0 and to the       *
+ * extruded filament) plans the heater power every 100ms.              *
+ * It holds the temperature through fan and flow changes and heats up  *
+ * without overshoot.                                                  *
+ *                                                                     *
+ * Set MPC_HEATER_POWER to the cartridge power, then run               *
+ * M307 H<hotend> T S<temp> U to measure the other values.             *
+ *                                                                     *
+ ***********************************************************************/
+//#define MPC_TEMP
+
+//      HotEnd                          {HE0,   HE1,   HE2,   HE3,   HE4,   HE5}
+#define MPC_HEATER_POWER                {40.0,  40.0,  40.0,  40.0,  40.0,  40.0}   // (W) Heater cartridge power
+#define MPC_BLOCK_HEAT_CAPACITY         {16.7,  16.7,  16.7,  16.7,  16.7,  16.7}   // (J/K) Heat block heat capacity
+#define MPC_SENSOR_RESPONSIVENESS       {0.22,  0.22,  0.22,  0.22,  0.22,  0.22}   // (1/s) Sensor lag behind the block
+#define MPC_AMBIENT_XFER_COEFF          {0.068, 0.068, 0.068, 0.068, 0.068, 0.068}  // (W/K) Heat loss with the part fan off
+#define MPC_AMBIENT_XFER_COEFF_FAN255   {0.097, 0.097, 0.097, 0.097, 0.097, 0.097}  // (W/K) Heat loss with the part fan at 255
+#define MPC_FILAMENT_HEAT_CAPACITY_PERMM {5.6e-3, 5.6e-3, 5.6e-3, 5.6e-3, 5.6e-3, 5.6e-3} // (J/K/mm) 1.75mm PLA 5.6e-3, 2.85mm PLA 1.4e-2
+
+#define MPC_SMOOTHING_FACTOR   0.5  // (0.0 - 1.0) How fast the model follows the measured temperature
+#define MPC_MIN_AMBIENT_CHANGE 1.0  // (K/s) Minimum ambient correction rate near steady state
+#define MPC_STEADYSTATE        0.5  // (K/s) Block temperature rate below which the state is steady
+/***********************************************************************/
+
+
 /***********************************************************************
  ************************ PID Settings - BED ***************************
  ***********************************************************************
@@ -336,6 +371,49 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ************************ Heater simulation ****************************
+ ***********************************************************************
+ *                                                                     *
+ * Replace every heater with a simulated thermal plant, to check the   *
+ * PID, MPC and thermal protection settings without real hardware.     *
+ * The heater pins are never switched on and the sensors read the      *
+ * temperature of the plants.                                          *
+ * M309 sets the plants, injects heater and sensor faults and runs a   *
+ * step response in accelerated time reporting rise time, overshoot,   *
+ * settling time and final error.                                      *
+ *                                                                     *
+ * Never enable it on a printer used for printing.                     *
+ *                                                                     *
+ ***********************************************************************/
+//#define HEATER_SIMULATION
+/***********************************************************************/
+
+
+/***********************************************************************
+ ********************** Heat-up power budget ***************************
+ ***********************************************************************
+ *                                                                     *
+ * Heat beds, chambers and hotends at the same time while keeping      *
+ * their total power within the PSU budget.                            *
+ * Heaters holding their target are served first, then the heaters     *
+ * with the longest time to target. While waiting with M109/M190/M191  *
+ * the estimated time until all heaters are ready is reported.         *
+ *                                                                     *
+ * Set the budget and the power of each heater in Watt.                *
+ *                                                                     *
+ ***********************************************************************/
+//#define HEATUP_POWER_BUDGET 300
+
+//      HotEnd                {HE0,  HE1,  HE2,  HE3,  HE4,  HE5}
+#define HEATUP_HOTEND_WATTS   {40.0, 40.0, 40.0, 40.0, 40.0, 40.0}
+//      Bed                   {BED0, BED1, BED2, BED3}
+#define HEATUP_BED_WATTS      {240.0, 240.0, 240.0, 240.0}
+//      Chamber               {CHAMBER0, CHAMBER1, CHAMBER2, CHAMBER3}
+#define HEATUP_CHAMBER_WATTS  {200.0, 200.0, 200.0, 200.0}
+/***********************************************************************/
+
+
 /********************************************************************************
  **************************** Inverted PINS *************************************
  ********************************************************************************
@@ -384,6 +462,18 @@
 // If thermal protection hotends is true, this parameter adapt fan speed if temperature drops
 //#define ADAPTIVE_FAN_SPEED
 
+/**
+ * With MPC_TEMP the hotends with a valid thermal model (M307) are also checked against it
+ * once the target is reached: the temperature predicted every 100ms from PWM, part fan
+ * and flow is compared to the measured one. Deviations, in standard deviations of the
+ * sensor noise, are summed and the hotend is halted over the limit.
+ * This replaces the hysteresis check above for those hotends once the target is reached,
+ * the watch period below still applies to the heat-up.
+ * A lower limit stops sooner on a real fault, a higher one trips less on a noisy sensor.
+ */
+//#define THERMAL_PROTECTION_MODEL
+#define THERMAL_PROTECTION_MODEL_LIMIT  30
+
 /**
  * When ever increases the target temperature the firmware will wait for the
  * WATCH TEMP PERIOD to expire, and if the temperature hasn't increased by WATCH TEMP INCREASE
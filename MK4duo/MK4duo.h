@@ -37,6 +37,7 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
@@ -109,6 +110,7 @@
 #include "src/lib/driver_types.h"
 #include "src/lib/duration_t.h"
 #include "src/lib/matrix.h"
+#include "src/lib/running_stats.h"
 #include "src/lib/vector_3/vector_3.h"
 #include "src/lib/least_squares_fit/least_squares_fit.h"
 
@@ -179,3 +181,8 @@
 #include "src/feature/rgbled/led_events.h"
 #include "src/feature/caselight/caselight.h"
 #include "src/feature/restart/restart.h"
+#include "src/feature/status_snapshot/status_snapshot.h"
+#include "src/feature/selective_resend/selective_resend.h"
+#include "src/feature/temp_history/temp_history.h"
+#include "src/feature/layer_time/layer_time.h"
+#include "src/feature/mesh_blend/mesh_blend.h"
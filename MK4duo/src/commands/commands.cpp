@@ -47,6 +47,8 @@ char Commands::injected_cmd[64] = { 0 };
 
 long Commands::gcode_last_N = 0;
 
+line_stats_t Commands::line_stats = { 0 };
+
 /** Private Parameters */
 long Commands::gcode_N = 0;
 
@@ -54,11 +56,25 @@ int Commands::serial_count[NUM_SERIAL] = { 0 };
 
 /** Public Function */
 void Commands::flush_and_request_resend() {
-  SERIAL_FLUSH();
+  #if DISABLED(SELECTIVE_RESEND)
+    SERIAL_FLUSH();
+  #endif
   SERIAL_LV(RESEND, gcode_last_N + 1);
+  line_stats.resend++;
   ok_to_send();
 }
 
+void Commands::print_line_stats() {
+  SERIAL_STR(ECHO);
+  SERIAL_PRINTF("Line errors checksum:%u number:%u resend:%u duplicate:%u held:%u\n",
+    line_stats.checksum, line_stats.line_number, line_stats.resend, line_stats.duplicate, line_stats.held
+  );
+}
+
+void Commands::reset_line_stats() {
+  memset(&line_stats, 0, sizeof(line_stats));
+}
+
 /**
  * Add to the circular command queue the next command from:
  *  - The command-injection queues (injected_cmd_P, injected_cmd)
@@ -340,6 +356,18 @@ void Commands::get_serial() {
     }
   #endif
 
+  #if ENABLED(SELECTIVE_RESEND)
+    // Lines held while waiting for a resend go first
+    while (!buffer_ring.isFull()) {
+      held_line_t * const line = resend.held(gcode_last_N + 1);
+      if (!line) break;
+      gcode_last_N = line->N;
+      resend.accepted(gcode_last_N);
+      enqueue(line->gcode, true, line->s_port);
+      resend.release(line);
+    }
+  #endif
+
   /**
    * Loop while serial characters are incoming and the buffer_ring is not full
    */
@@ -375,26 +403,45 @@ void Commands::get_serial() {
 
           gcode_N = strtol(npos + 1, nullptr, 10);
 
-          if (gcode_N != gcode_last_N + 1 && !M110) {
-            gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
-            return;
-          }
-
+          PGM_P checksum_error = nullptr;
           char *apos = strrchr(command, '*');
+          #if ENABLED(SELECTIVE_RESEND)
+            char *cpos = strrchr(command, '^');
+            if (cpos && (!apos || cpos > apos)) {
+              if (!resend.check_crc16(command, cpos))
+                checksum_error = PSTR(STR_ERR_CHECKSUM_MISMATCH);
+            }
+            else
+          #endif
           if (apos) {
             uint8_t checksum = 0, count = uint8_t(apos - command);
             while (count) checksum ^= command[--count];
-            if (strtol(apos + 1, nullptr, 10) != checksum) {
-              gcode_line_error(PSTR(STR_ERR_CHECKSUM_MISMATCH), i);
-              return;
-            }
+            if (strtol(apos + 1, nullptr, 10) != checksum)
+              checksum_error = PSTR(STR_ERR_CHECKSUM_MISMATCH);
           }
-          else {
-            gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
+          else
+            checksum_error = PSTR(STR_ERR_NO_CHECKSUM);
+
+          if (gcode_N != gcode_last_N + 1 && !M110) {
+            #if ENABLED(SELECTIVE_RESEND)
+              if (!checksum_error && resend.out_of_order(gcode_N, gcode_last_N + 1, command, i)) continue;
+            #endif
+            line_stats.line_number++;
+            gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
+            return;
+          }
+
+          if (checksum_error) {
+            line_stats.checksum++;
+            gcode_line_error(checksum_error, i);
             return;
           }
 
           gcode_last_N = gcode_N;
+          #if ENABLED(SELECTIVE_RESEND)
+            if (M110) resend.reset();
+            resend.accepted(gcode_N);
+          #endif
         }
         #if HAS_SD_SUPPORT
           // Pronterface "M29" and "M29 " has no line number
@@ -544,11 +591,20 @@ void Commands::unknown_warning() {
 }
 
 void Commands::gcode_line_error(PGM_P const err, const int8_t port) {
+  #if ENABLED(SELECTIVE_RESEND)
+    // The missing line is already asked for: drop this one, as the flush would
+    if (!resend.request(gcode_last_N + 1)) {
+      serial_count[port] = 0;
+      return;
+    }
+  #endif
   SERIAL_PORT(port);
   SERIAL_STR(ER);
   SERIAL_STR(err);
   SERIAL_EV(gcode_last_N);
-  while (Com::serialRead(port) != -1);
+  #if DISABLED(SELECTIVE_RESEND)
+    while (Com::serialRead(port) != -1);
+  #endif
   flush_and_request_resend();
   serial_count[port] = 0;
   SERIAL_PORT(-1);
@@ -650,6 +706,66 @@ bool Commands::process_injected() {
   #define EXECUTE_G0_G1(NUM) gcode_G0_G1()
 #endif
 
+#if ENABLED(FASTER_GCODE_EXECUTE)
+
+  /**
+   * Binary search of a code in a G or M code table.
+   * Return its position or CODE_NO_INDEX if it's not available.
+   */
+  template<typename T, size_t N>
+  static uint16_t code_search(const T (&table)[N], const uint16_t code_num) {
+    int16_t start = 0, end = N - 1;
+    if (!WITHIN(code_num, table[start].code, table[end].code)) return CODE_NO_INDEX;
+    while (start <= end) {
+      const int16_t middle = (start + end) >> 1;
+      if (table[middle].code == code_num)
+        return middle;
+      else if (table[middle].code < code_num)
+        start = middle + 1;
+      else
+        end = middle - 1;
+    }
+    return CODE_NO_INDEX;
+  }
+
+  #if ENABLED(DEBUG_GCODE_PARSER)
+
+    template<typename T, size_t N, size_t S>
+    static void benchmark_table(const char code_letter, const T (&table)[N], const code_index_t<S> &code_index, const uint16_t loops) {
+      uint32_t found_search = 0, found_index = 0;
+
+      // Before: binary search of every code in the table
+      uint32_t start = micros();
+      for (uint16_t l = 0; l < loops; l++)
+        for (uint16_t code_num = 0; code_num < S; code_num++)
+          if (code_search(table, code_num) != CODE_NO_INDEX) found_search++;
+      const uint32_t search_time = micros() - start;
+
+      // After: direct index table
+      start = micros();
+      for (uint16_t l = 0; l < loops; l++)
+        for (uint16_t code_num = 0; code_num < S; code_num++)
+          if (pgm_read_word(&code_index.index[code_num]) != CODE_NO_INDEX) found_index++;
+      const uint32_t index_time = micros() - start;
+
+      SERIAL_CHR(code_letter);
+      SERIAL_MV("-code lookups ", uint32_t(loops) * S);
+      SERIAL_MV(": binary search ", search_time);
+      SERIAL_MV(" us (found ", found_search);
+      SERIAL_MV("), direct index ", index_time);
+      SERIAL_MV(" us (found ", found_index);
+      SERIAL_EM(")");
+    }
+
+    void Commands::benchmark_lookup(const uint16_t loops) {
+      benchmark_table('G', GCode_Table, GCode_Index, loops);
+      benchmark_table('M', MCode_Table, MCode_Index, loops);
+    }
+
+  #endif
+
+#endif
+
 void Commands::process_parsed(const bool say_ok/*=true*/) {
 
   PRINTER_KEEPALIVE(InHandler);
@@ -661,46 +777,21 @@ void Commands::process_parsed(const bool say_ok/*=true*/) {
 
       case 'G': {
         const uint16_t code_num = parser.codenum;
-        G_CODE_TYPE start   = 0,
-                    middle  = 0,
-                    end     = COUNT(GCode_Table) - 1;
-
         if (code_num <= 1) EXECUTE_G0_G1(code_num); // Execute directly the most common Gcodes
-        else if (WITHIN(code_num, GCode_Table[start].code, GCode_Table[end].code)) {
-          while (start <= end) {
-            middle = (start + end) >> 1;
-            if (GCode_Table[middle].code == code_num) {
-              GCode_Table[middle].command(); // Command found, execute it
-              break;
-            }
-            else if (GCode_Table[middle].code < code_num)
-              start = middle + 1;
-            else
-              end = middle - 1;
-          }
+        else if (code_num < GCODE_INDEX_SIZE) {
+          const uint16_t index = pgm_read_word(&GCode_Index.index[code_num]);
+          if (index != CODE_NO_INDEX) GCode_Table[index].command(); // Command found, execute it
         }
       }
       break;
 
       case 'M': {
         const uint16_t code_num = parser.codenum;
-        M_CODE_TYPE start   = 0,
-                    middle  = 0,
-                    end     = COUNT(MCode_Table) - 1;
-
-        if (WITHIN(code_num, MCode_Table[start].code, MCode_Table[end].code)) {
-          while (start <= end) {
-            middle = (start + end) >> 1;
-            if (MCode_Table[middle].code == code_num) {
-              MCode_Table[middle].command(); // Command found, execute it
-              break;
-            }
-            else if (MCode_Table[middle].code < code_num)
-              start = middle + 1;
-            else
-              end = middle - 1;
-          }
-        }
+
+        const uint16_t index = code_num < MCODE_INDEX_SIZE
+          ? pgm_read_word(&MCode_Index.index[code_num])
+          : mcode_search(code_num);
+        if (index != CODE_NO_INDEX) MCode_Table[index].command(); // Command found, execute it
 
         // With M105 "ok" already sended
         if (code_num == 105) return;
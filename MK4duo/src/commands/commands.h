@@ -35,6 +35,14 @@
 #define PS_PAREN  3
 #define PS_ESC    4
     
+struct line_stats_t {
+  uint16_t  checksum,     // Lines with a wrong or missing checksum
+            line_number,  // Lines out of sequence
+            resend,       // Resend requests sent to the host
+            duplicate,    // Lines received again and skipped
+            held;         // Lines held while waiting for a missing one
+};
+
 struct gcode_t {
   char    gcode[MAX_CMD_SIZE];  // Char for gcode
   bool    send_ok = true;       // Send "ok" after commands by default
@@ -80,6 +88,11 @@ class Commands {
      */
     static long gcode_last_N;
 
+    /**
+     * Errors and resends of the serial line protocol, reported by M576
+     */
+    static line_stats_t line_stats;
+
   private: /** Private Parameters */
 
     static long gcode_N;
@@ -91,9 +104,17 @@ class Commands {
     /**
      * Send a "Resend: nnn" message to the host to
      * indicate that a command needs to be re-sent.
+     * With SELECTIVE_RESEND the lines in flight are
+     * not flushed, they may be held until nnn comes.
      */
     static void flush_and_request_resend();
 
+    /**
+     * Report and clear the line protocol counters
+     */
+    static void print_line_stats();
+    static void reset_line_stats();
+
     /**
      * Add to the buffer ring the next command from:
      *  - The command-injection queue (injected_cmd_P)
@@ -180,6 +201,14 @@ class Commands {
      */
     static Heater* get_target_heater();
 
+    /**
+     * Time the G and M code lookups with the binary
+     * search and with the direct index tables
+     */
+    #if ENABLED(DEBUG_GCODE_PARSER) && ENABLED(FASTER_GCODE_EXECUTE)
+      static void benchmark_lookup(const uint16_t loops);
+    #endif
+
   private: /** Private Function */
 
     /**
@@ -114,6 +114,17 @@
  *     Include "E" to engage/disengage the Z probe for each sample.
  *     There's no extra effect if you have a fixed Z probe.
  *
+ * With ADAPTIVE_MESH:
+ *
+ *  A  Probe only the print area of the selected SD file, plus
+ *     ADAPTIVE_MESH_MARGIN, at the same grid spacing. With BILINEAR
+ *     the points out of the area take the nearest probed point.
+ *
+ * With PROBE_FLYING:
+ *
+ *  K  Flying probing, on by default. "G29 K0" probes each point with
+ *     the normal stop, probe, raise cycle. Ignored with "E".
+ *
  */
 inline void gcode_G29() {
 
@@ -202,6 +213,13 @@ inline void gcode_G29() {
       constexpr int abl_points = GRID_MAX_POINTS;
     #endif
 
+    #if ENABLED(ADAPTIVE_MESH)
+      ABL_VAR bool adaptive = false;
+      #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+        ABL_VAR xy_uint8_t area_lo, area_hi;
+      #endif
+    #endif
+
     #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
 
       ABL_VAR float zoffset = 0.0;
@@ -381,6 +399,65 @@ inline void gcode_G29() {
       gridSpacing.set((probe_position_rb.x - probe_position_lf.x) / (abl_grid_points.x - 1),
                       (probe_position_rb.y - probe_position_lf.y) / (abl_grid_points.y - 1));
 
+      #if ENABLED(ADAPTIVE_MESH)
+
+        // Probe only the print area of the selected file
+        if (parser.boolval('A')) {
+          const bool has_area = card.hasPrintArea();
+          const xy_pos_t  area_lf = { NATIVE_X_POSITION(card.printMin.x) - (ADAPTIVE_MESH_MARGIN),
+                                      NATIVE_Y_POSITION(card.printMin.y) - (ADAPTIVE_MESH_MARGIN) },
+                          area_rb = { NATIVE_X_POSITION(card.printMax.x) + (ADAPTIVE_MESH_MARGIN),
+                                      NATIVE_Y_POSITION(card.printMax.y) + (ADAPTIVE_MESH_MARGIN) };
+
+          adaptive = has_area
+                  && area_lf.x < probe_position_rb.x && area_rb.x > probe_position_lf.x
+                  && area_lf.y < probe_position_rb.y && area_rb.y > probe_position_lf.y;
+
+          if (!adaptive)
+            SERIAL_EM("No print area on the bed, probing the whole grid.");
+          else {
+
+            #if ENABLED(AUTO_BED_LEVELING_LINEAR)
+
+              // Shrink the grid to the area with no wider spacing
+              probe_position_lf.set(MAX(probe_position_lf.x, area_lf.x), MAX(probe_position_lf.y, area_lf.y));
+              probe_position_rb.set(MIN(probe_position_rb.x, area_rb.x), MIN(probe_position_rb.y, area_rb.y));
+
+              const xy_pos_t area_size = probe_position_rb - probe_position_lf;
+              abl_grid_points.set(
+                constrain(1 + CEIL(area_size.x / gridSpacing.x), 2, abl_grid_points.x),
+                constrain(1 + CEIL(area_size.y / gridSpacing.y), 2, abl_grid_points.y)
+              );
+              abl_points = abl_grid_points.x * abl_grid_points.y;
+
+              gridSpacing.set(area_size.x / (abl_grid_points.x - 1), area_size.y / (abl_grid_points.y - 1));
+
+            #elif ENABLED(AUTO_BED_LEVELING_BILINEAR)
+
+              // Keep the grid, take the points that cover the area
+              area_lo.set(
+                constrain(FLOOR((area_lf.x - probe_position_lf.x) / gridSpacing.x), 0, GRID_MAX_POINTS_X - 2),
+                constrain(FLOOR((area_lf.y - probe_position_lf.y) / gridSpacing.y), 0, GRID_MAX_POINTS_Y - 2)
+              );
+              area_hi.set(
+                constrain(CEIL((area_rb.x - probe_position_lf.x) / gridSpacing.x), area_lo.x + 1, GRID_MAX_POINTS_X - 1),
+                constrain(CEIL((area_rb.y - probe_position_lf.y) / gridSpacing.y), area_lo.y + 1, GRID_MAX_POINTS_Y - 1)
+              );
+
+            #endif
+
+            if (verbose_level > 0) {
+              SERIAL_MV("Adaptive mesh X", LOGICAL_X_POSITION(area_lf.x), 1);
+              SERIAL_MV(":", LOGICAL_X_POSITION(area_rb.x), 1);
+              SERIAL_MV(" Y", LOGICAL_Y_POSITION(area_lf.y), 1);
+              SERIAL_EMV(":", LOGICAL_Y_POSITION(area_rb.y), 1);
+            }
+
+          }
+        }
+
+      #endif // ADAPTIVE_MESH
+
     #endif // ABL_GRID
 
     if (verbose_level > 0) {
@@ -608,6 +685,10 @@ inline void gcode_G29() {
   {
     const ProbePtRaiseEnum raise_after = parser.boolval('E') ? PROBE_PT_STOW : PROBE_PT_RAISE;
 
+    #if ENABLED(PROBE_FLYING)
+      const bool flying = !faux && raise_after == PROBE_PT_RAISE && parser.boolval('K', true);
+    #endif
+
     measured_z = 0.0;
 
     #if ABL_GRID
@@ -648,6 +729,11 @@ inline void gcode_G29() {
             indexIntoAB[meshCount.x][meshCount.y] = ++abl_probe_index; // 0...
           #endif
 
+          #if ENABLED(ADAPTIVE_MESH) && ENABLED(AUTO_BED_LEVELING_BILINEAR)
+            // Skip the points out of the print area
+            if (adaptive && !(WITHIN(meshCount.x, area_lo.x, area_hi.x) && WITHIN(meshCount.y, area_lo.y, area_hi.y))) continue;
+          #endif
+
           #if IS_KINEMATIC
             // Avoid probing outside the round or hexagonal area
             if (!mechanics.position_is_reachable_by_probe(probePos)) continue;
@@ -662,7 +748,11 @@ inline void gcode_G29() {
             lcdui.status_printf_P(0, PSTR(S_FMT " %i/%i"), GET_TEXT(MSG_PROBING_MESH), int(pt_index), int(GRID_MAX_POINTS));
           #endif
 
-          measured_z = faux ? 0.001f * random(-100, 101) : probe.check_at_point(probePos, raise_after, verbose_level);
+          measured_z = faux ? 0.001f * random(-100, 101)
+            #if ENABLED(PROBE_FLYING)
+              : flying ? probe.fly_to_point(probePos, verbose_level)
+            #endif
+            : probe.check_at_point(probePos, raise_after, verbose_level);
 
           if (isnan(measured_z)) {
             bedlevel.restore_bed_leveling_state();
@@ -691,6 +781,12 @@ inline void gcode_G29() {
         } // inner
       } // outer
 
+      #if ENABLED(PROBE_FLYING)
+        // Clear the bed from the last trigger point
+        if (flying && !isnan(measured_z))
+          mechanics.do_blocking_move_to_z(mechanics.position.z + Z_PROBE_BETWEEN_HEIGHT, MMM_TO_MMS(probe.data.speed_fast));
+      #endif
+
     #elif ENABLED(AUTO_BED_LEVELING_3POINT)
 
       // Probe at 3 arbitrary points
@@ -749,7 +845,12 @@ inline void gcode_G29() {
   if (!isnan(measured_z)) {
     #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
 
-      if (!dryrun) abl.extrapolate_unprobed_bed_level();
+      if (!dryrun) {
+        #if ENABLED(ADAPTIVE_MESH)
+          if (adaptive) abl.extend_probed_area(area_lo, area_hi);
+        #endif
+        abl.extrapolate_unprobed_bed_level();
+      }
       abl.print_bilinear_leveling_grid();
 
       abl.refresh_bed_level();
@@ -66,6 +66,10 @@ inline void gcode_M420() {
 
       bedlevel.set_bed_leveling_enabled(false);
 
+      #if ENABLED(UBL_MESH_TEMP_BLEND)
+        meshBlend.enable(false);
+      #endif
+
       #if HAS_EEPROM
 
         const int8_t storage_slot = parser.has_value() ? parser.value_int() : ubl.storage_slot;
@@ -82,8 +86,7 @@ inline void gcode_M420() {
           return;
         }
 
-        eeprom.load_mesh(storage_slot);
-        ubl.storage_slot = storage_slot;
+        if (eeprom.load_mesh(storage_slot)) ubl.storage_slot = storage_slot;
 
       #else
 
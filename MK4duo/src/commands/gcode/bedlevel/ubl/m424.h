@@ -0,0 +1,50 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(UBL_MESH_TEMP_BLEND)
+
+#define CODE_M424
+
+/**
+ * M424: Bed temperature mesh blend
+ *
+ *  S<bool>   Enable / Disable. Enable takes all the meshes stored
+ *            with G29 S, each at the bed temperature of the time
+ *            it was stored, and blends them by bed temperature.
+ *
+ *  G29 and M420 L disable the blend.
+ */
+inline void gcode_M424() {
+
+  if (parser.seen('S')) meshBlend.enable(parser.value_bool());
+
+  meshBlend.print_M424();
+
+}
+
+#endif // ENABLED(UBL_MESH_TEMP_BLEND)
@@ -65,6 +65,8 @@ static xy_pos_t z_stepper_align_pos[] = Z_STEPPER_ALIGN_XY;
 
 #define G34_PROBE_COUNT COUNT(z_stepper_align_pos)
 
+#include "g34_model.h"
+
 inline void set_all_z_lock(const bool lock) {
   stepper.set_z_lock(lock);
   stepper.set_z2_lock(lock);
@@ -78,7 +80,11 @@ inline void set_all_z_lock(const bool lock) {
  *
  *   I<iterations>
  *   T<accuracy>
- *   A<amplification>
+ *   A<amplification>  Starting gain of the gantry model, refined by every iteration
+ *
+ * All the steppers are corrected at once from a model of the gantry. After each
+ * correction the model is updated from the heights the probe saw, so the next
+ * corrections account for lever arms and leadscrew pitch.
  */
 inline void gcode_G34() {
 
@@ -159,7 +165,15 @@ inline void gcode_G34() {
     float last_z_align_move[Z_STEPPER_COUNT] = ARRAY_N(Z_STEPPER_COUNT, 10000.0f, 10000.0f, 10000.0f),
           z_measured[G34_PROBE_COUNT] = { 0 },
           z_maxdiff = 0.0f,
-          amplification = z_auto_align_amplification;
+          last_z_maxdiff = 0.0f,
+          last_z_stepper[Z_STEPPER_COUNT] = { 0 },
+          z_align_move[Z_STEPPER_COUNT] = { 0 };
+
+    g34_model_t model;
+    g34_init_model(model, z_auto_align_amplification);
+
+    // Shorter moves are left out of the model, the probe noise would be most of what it learns
+    const float model_min_move = (G34_MODEL_MIN_MOVE) * MAX(z_auto_align_accuracy, probe.min_sigma());
 
     uint8_t iteration;
     bool err_break = false;
@@ -198,6 +212,13 @@ inline void gcode_G34() {
           DEBUG_EMV(" measured position is ", z_measured[iprobe]);
         }
 
+        // Confidence of the point when probed more than once
+        if (probe.point_stats.count() > 1) {
+          SERIAL_MV("Z", int(iprobe + 1));
+          SERIAL_MV(" +/-", probe.point_stats.std_error(), 4);
+          SERIAL_EMV(" samples:", probe.point_stats.count());
+        }
+
         // Remember the minimum measurement to calculate the correction later on
         z_measured_min = MIN(z_measured_min, z_measured[iprobe]);
         z_measured_max = MAX(z_measured_max, z_measured[iprobe]);
@@ -249,6 +270,33 @@ inline void gcode_G34() {
       #endif
       SERIAL_EOL();
 
+      // Learn from what the last corrections did, then solve all the moves at once
+      if (iteration > 0) g34_update_model(model, last_z_stepper, z_measured, z_align_move, model_min_move, SIGN(z_auto_align_amplification));
+      for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) last_z_stepper[i] = z_measured[i];
+
+      if (!g34_solve(model, z_measured, z_align_move)) {
+        // Degenerate model, back to the plain correction
+        g34_init_model(model, z_auto_align_amplification);
+        for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i)
+          z_align_move[i] = z_auto_align_amplification * (z_measured[i] - z_measured_min);
+      }
+
+      // The error shrinks by about the same rate every iteration
+      if (iteration > 0 && last_z_maxdiff > 0.0f && z_maxdiff > z_auto_align_accuracy) {
+        const float rate = z_maxdiff / last_z_maxdiff;
+        if (rate < 1.0f)
+          SERIAL_EMV("Predicted iterations to target: ", int(CEIL(LOG(z_auto_align_accuracy / z_maxdiff) / LOG(rate))));
+      }
+      last_z_maxdiff = z_maxdiff;
+
+      if (printer.debugFeature()) {
+        for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) {
+          DEBUG_MV("> Z", int(i + 1));
+          DEBUG_MV(" gain ", g34_gain(model, i), 3);
+          DEBUG_EMV(" move ", z_align_move[i]);
+        }
+      }
+
       // The following correction actions are to be enabled for select Z-steppers only
       stepper.set_separate_multi_axis(true);
 
@@ -256,14 +304,8 @@ inline void gcode_G34() {
 
       // Correct stepper offsets and re-iterate
       for (uint8_t zstepper = 0; zstepper < Z_STEPPER_COUNT; ++zstepper) {
-        // Calculate current stepper move
-        const float z_align_move = z_measured[zstepper] - z_measured_min,
-                    z_align_abs = ABS(z_align_move);
-
-        #if DISABLED(Z_STEPPER_ALIGN_KNOWN_STEPPER_POSITIONS)
-          // Optimize one iterations correction based on the first measurements
-          if (z_align_abs > 0.0f) amplification = iteration == 1 ? MIN(last_z_align_move[zstepper] / z_align_abs, 2.0f) : z_auto_align_amplification;
-        #endif
+        // Current stepper move from the model
+        const float z_align_abs = ABS(z_align_move[zstepper]);
 
         // Check for lost accuracy compared to last move
         if (last_z_align_move[zstepper] < z_align_abs - 1.0) {
@@ -275,13 +317,8 @@ inline void gcode_G34() {
         // Remember the alignment for the next iteration
         last_z_align_move[zstepper] = z_align_abs;
 
-        // Stop early if all measured points achieve accuracy target// Only stop early if all measured points achieve accuracy target
-        if (z_align_abs > z_auto_align_accuracy) success_break = false;
-
-        if (printer.debugFeature()) {
-          DEBUG_MV("> Z", int(zstepper + 1));
-          DEBUG_EMV(" corrected by ", z_align_move);
-        }
+        // Only stop early if all measured points achieve accuracy target
+        if (z_measured[zstepper] - z_measured_min > z_auto_align_accuracy) success_break = false;
 
         // Lock all steppers except one
         set_all_z_lock(true);
@@ -294,7 +331,7 @@ inline void gcode_G34() {
         }
 
         // Do a move to correct part of the misalignment for the current stepper
-        mechanics.do_blocking_move_to_z(amplification * z_align_move + mechanics.position.z);
+        mechanics.do_blocking_move_to_z(z_align_move[zstepper] + mechanics.position.z);
       }
 
       // Back to normal stepper operations
@@ -0,0 +1,120 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * g34_model.h - Gantry model of G34
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * The change of the centered Z stepper heights for 1mm of each stepper.
+ * It starts from the amplification and is refined after every correction from what
+ * the probe saw, so lever arms and leadscrew pitch errors are learned on the way.
+ * Moving all the steppers together changes nothing, the model only sees the centered moves.
+ */
+
+#define G34_MODEL_MIN_MOVE  4.0f  // Moves under this many times the accuracy or the probe deviation are not learned
+#define G34_MODEL_MIN_GAIN  0.5f  // Height change of a stepper for 1mm of it, the learned gain stays in range
+#define G34_MODEL_MAX_GAIN  2.0f
+
+typedef FixedMatrix<float, Z_STEPPER_COUNT, Z_STEPPER_COUNT> g34_model_t;
+
+inline void g34_center(const float in[], float out[]) {
+  float mean = 0.0f;
+  for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) mean += in[i];
+  mean /= Z_STEPPER_COUNT;
+  for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) out[i] = in[i] - mean;
+}
+
+inline void g34_init_model(g34_model_t &model, const float amplification) {
+  for (uint8_t r = 0; r < Z_STEPPER_COUNT; ++r)
+    for (uint8_t c = 0; c < Z_STEPPER_COUNT; ++c)
+      model(r, c) = ((1.0f / Z_STEPPER_COUNT) - (r == c ? 1.0f : 0.0f)) / amplification;
+}
+
+// Height change of a stepper for 1mm of it, the inverse of the amplification
+inline float g34_gain(const g34_model_t &model, const uint8_t i) {
+  return -model(i, i) * Z_STEPPER_COUNT / (Z_STEPPER_COUNT - 1);
+}
+
+/**
+ * Broyden update, correct the model by what the last moves did against what it predicted.
+ * Moves shorter than min_move are mostly probe noise and are not learned. The update is
+ * cut short where it would take a gain out of range, sign is the one of the amplification.
+ * Return false if the model was not updated.
+ */
+inline bool g34_update_model(g34_model_t &model, const float z_old[], const float z_new[], const float moves[], const float min_move, const float sign) {
+  float dz[Z_STEPPER_COUNT], d[Z_STEPPER_COUNT], k[Z_STEPPER_COUNT];
+  for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) dz[i] = z_new[i] - z_old[i];
+  g34_center(dz, dz);
+  g34_center(moves, d);
+
+  float dd = 0.0f;
+  for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) dd += sq(d[i]);
+  if (dd < sq(min_move) || dd < 1e-6f) return false;
+
+  for (uint8_t r = 0; r < Z_STEPPER_COUNT; ++r) {
+    float predicted = 0.0f;
+    for (uint8_t c = 0; c < Z_STEPPER_COUNT; ++c) predicted += model(r, c) * d[c];
+    k[r] = (dz[r] - predicted) / dd;
+  }
+
+  // The part of the update that keeps all the gains in range
+  float step = 1.0f;
+  for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) {
+    const float gain  = sign * g34_gain(model, i),
+                delta = -sign * k[i] * d[i] * Z_STEPPER_COUNT / (Z_STEPPER_COUNT - 1);
+    if (delta > 0.0f && gain + delta > G34_MODEL_MAX_GAIN) NOMORE(step, MAX(G34_MODEL_MAX_GAIN - gain, 0.0f) / delta);
+    if (delta < 0.0f && gain + delta < G34_MODEL_MIN_GAIN) NOMORE(step, MIN(G34_MODEL_MIN_GAIN - gain, 0.0f) / delta);
+  }
+  if (step <= 0.0f) return false;
+
+  for (uint8_t r = 0; r < Z_STEPPER_COUNT; ++r)
+    for (uint8_t c = 0; c < Z_STEPPER_COUNT; ++c)
+      model(r, c) += step * k[r] * d[c];
+
+  return true;
+}
+
+// The moves of all the steppers that level the heights together, the lowest stepper does not move
+inline bool g34_solve(const g34_model_t &model, const float z[], float moves[]) {
+  FixedMatrix<float, Z_STEPPER_COUNT + 1, Z_STEPPER_COUNT> a;
+  FixedMatrix<float, Z_STEPPER_COUNT, Z_STEPPER_COUNT + 1> normal;
+  float zc[Z_STEPPER_COUNT], rhs[Z_STEPPER_COUNT + 1];
+
+  g34_center(z, zc);
+  for (uint8_t r = 0; r < Z_STEPPER_COUNT; ++r) {
+    for (uint8_t c = 0; c < Z_STEPPER_COUNT; ++c) a(r, c) = model(r, c);
+    rhs[r] = -zc[r];
+  }
+
+  // The moves are free up to a constant, fix their sum
+  for (uint8_t c = 0; c < Z_STEPPER_COUNT; ++c) a(Z_STEPPER_COUNT, c) = 1.0f;
+  rhs[Z_STEPPER_COUNT] = 0.0f;
+
+  if (!a.LeastSquares(Z_STEPPER_COUNT + 1, Z_STEPPER_COUNT, rhs, moves, normal)) return false;
+
+  float lowest = moves[0];
+  for (uint8_t i = 1; i < Z_STEPPER_COUNT; ++i) NOMORE(lowest, moves[i]);
+  for (uint8_t i = 0; i < Z_STEPPER_COUNT; ++i) moves[i] -= lowest;
+
+  return true;
+}
@@ -34,7 +34,7 @@
    * M48: Z-Probe repeatability measurement function.
    *
    * Usage:
-   *   M48 <P#> <X#> <Y#> <V#> <E> <L#> <S>
+   *   M48 <P#> <X#> <Y#> <V#> <E> <L#> <S> <O#> <T#>
    *     P = Number of sampled points (4-50, default 10)
    *     X = Sample X position
    *     Y = Sample Y position
@@ -42,6 +42,9 @@
    *     E = Engage probe for each reading
    *     L = Number of legs of movement before probe
    *     S = Schizoid (Or Star if you prefer)
+   *     O = Reject samples further than this many deviations from the mean (default 0, keep all).
+   *         The deviation is at least T, Z_PROBE_REPETITIONS_SIGMA and one Z step
+   *     T = Stop once the deviation is below this value in mm (checked from 4 samples on)
    *
    * This function assumes the bed has been homed.  Specifically, that a G28 command
    * as been issued prior to invoking the M48 Z-Probe repeatability measurement function.
@@ -92,6 +95,10 @@
     const bool schizoid_flag = parser.seen('S');
     if (schizoid_flag && !seen_L) n_legs = 7;
 
+    const float outlier_k   = parser.floatval('O'),
+                stop_sigma  = parser.floatval('T'),
+                min_sigma   = MAX(stop_sigma, probe.min_sigma());
+
     /**
      * Now get everything to the specified probe point So we can safely do a
      * probe to get us close to the bed.  If the Z-Axis is far from the bed,
@@ -107,7 +114,7 @@
 
     mechanics.setup_for_endstop_or_probe_move();
 
-    float mean = 0.0, sigma = 0.0, min = 99999.9, max = -99999.9, sample_set[n_samples];
+    running_stats stats;
 
     // Move to the first point, deploy, and probe
     const float t = probe.check_at_point(probe_pos, raise_after, verbose_level);
@@ -195,45 +202,35 @@
         } // n_legs
 
         // Probe a single point
-        sample_set[n] = probe.check_at_point(probe_pos, raise_after, 0);
+        const float sample = probe.check_at_point(probe_pos, raise_after, 0);
 
         // Break the loop if the probe fails
-        probing_good = !isnan(sample_set[n]);
+        probing_good = !isnan(sample);
         if (!probing_good) break;
 
-        /**
-         * Get the current mean for the data points we have so far
-         */
-        float sum = 0.0;
-        for (uint8_t j = 0; j <= n; j++) sum += sample_set[j];
-        mean = sum / (n + 1);
-
-        NOMORE(min, sample_set[n]);
-        NOLESS(max, sample_set[n]);
-
-        /**
-         * Now, use that mean to calculate the standard deviation for the
-         * data points we have so far
-         */
-        sum = 0.0;
-        for (uint8_t j = 0; j <= n; j++)
-          sum += sq(sample_set[j] - mean);
-
-        sigma = SQRT(sum / (n + 1));
-        if (verbose_level > 0) {
-          if (verbose_level > 1) {
-            SERIAL_VAL(n + 1);
-            SERIAL_MV(" of ", n_samples);
-            SERIAL_MV(": z: ", sample_set[n], 3);
-            if (verbose_level > 2) {
-              SERIAL_MV(" mean: ", mean, 4);
-              SERIAL_MV(" sigma: ", sigma, 6);
-              SERIAL_MV(" min: ", min, 3);
-              SERIAL_MV(" max: ", max, 3);
-              SERIAL_MV(" range: ", max - min, 3);
-            }
-            SERIAL_EOL();
+        // Mean and deviation are updated as each sample comes in
+        const bool accepted = stats.add_filtered(sample, outlier_k, min_sigma);
+
+        if (verbose_level > 1) {
+          SERIAL_VAL(n + 1);
+          SERIAL_MV(" of ", n_samples);
+          SERIAL_MV(": z: ", sample, 3);
+          if (!accepted)
+            SERIAL_MSG(" rejected");
+          else if (verbose_level > 2) {
+            SERIAL_MV(" mean: ", stats.mean(), 4);
+            SERIAL_MV(" sigma: ", stats.sigma(), 6);
+            SERIAL_MV(" min: ", stats.minimum(), 3);
+            SERIAL_MV(" max: ", stats.maximum(), 3);
+            SERIAL_MV(" range: ", stats.range(), 3);
           }
+          SERIAL_EOL();
+        }
+
+        // Stop once the samples agree well enough
+        if (stop_sigma > 0 && stats.settled(stop_sigma, 4)) {
+          if (verbose_level > 0) SERIAL_EMV("Target deviation reached after samples: ", stats.count());
+          break;
         }
 
       }  // End of probe loop
@@ -244,11 +241,16 @@
     if (probing_good) {
       SERIAL_EM("Finished!");
 
+      const float sigma = stats.sigma();
+
       if (verbose_level > 0) {
-        SERIAL_MV("Mean: ", mean, 6);
-        SERIAL_MV(" Min: ", min, 3);
-        SERIAL_MV(" Max: ", max, 3);
-        SERIAL_MV(" Range: ", max - min, 3);
+        SERIAL_MV("Mean: ", stats.mean(), 6);
+        SERIAL_MV(" Min: ", stats.minimum(), 3);
+        SERIAL_MV(" Max: ", stats.maximum(), 3);
+        SERIAL_MV(" Range: ", stats.range(), 3);
+        SERIAL_EOL();
+        SERIAL_MV("Confidence of the mean: +/-", stats.std_error(), 6);
+        if (stats.rejected()) SERIAL_MV(" Rejected: ", stats.rejected());
         SERIAL_EOL();
       }
 
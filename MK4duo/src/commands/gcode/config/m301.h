@@ -44,7 +44,7 @@
  * With PID_ADD_EXTRUSION_RATE:
  *
  *    C[float]    Kc term
- *    L[int]      LPQ length
+ *    L[int]      Feed-forward lookahead in PID samples (100ms)
  */
 inline void gcode_M301() {
 
@@ -0,0 +1,119 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(MPC_TEMP)
+
+#define CODE_M307
+
+/**
+ * M307: Set or autotune the hotend MPC model
+ *
+ *   H[hotend]    0-5 Hotend (default 0)
+ *
+ *    P[watts]    Heater power
+ *    C[J/K]      Heater block heat capacity
+ *    R[1/s]      Sensor responsiveness
+ *    A[W/K]      Ambient heat transfer coefficient with the part fan off
+ *    F[W/K]      Extra ambient heat transfer coefficient with the part fan at 255
+ *    E[J/K/mm]   Filament heat capacity per mm
+ *
+ *  P, C, R and A must be positive, R at most 1/(sample time), A + F positive
+ *  and E not negative, or nothing is changed. Until the whole model is valid,
+ *  see mpc_data_t::isValid(), the hotend runs with PID.
+ *
+ *    T           Autotune the model, P must be already set
+ *    S[temp]     Autotune target temperature (default 200C)
+ *    U[bool]     with a non-zero value will save the autotune result to EEPROM
+ *
+ */
+inline void gcode_M307() {
+
+  Heater * const act = commands.get_target_heater();
+
+  if (!act) return;
+
+  if (act->type != IS_HOTEND) {
+    SERIAL_LM(ER, "MPC is only for hotends");
+    return;
+  }
+
+  #if DISABLED(DISABLE_M503)
+    // No arguments? Show M307 report.
+    if (!parser.seen("PCRAFET")) {
+      act->print_M307();
+      return;
+    }
+  #endif
+
+  mpc_data_t mpc = act->data.mpc;
+
+  if (parser.seen('P')) mpc.heater_power                  = parser.value_float();
+  if (parser.seen('C')) mpc.block_heat_capacity           = parser.value_float();
+  if (parser.seen('R')) mpc.sensor_responsiveness         = parser.value_float();
+  if (parser.seen('A')) mpc.ambient_xfer_coeff_fan0       = parser.value_float();
+  if (parser.seen('F')) mpc.fan255_adjustment             = parser.value_float();
+  if (parser.seen('E')) mpc.filament_heat_capacity_permm  = parser.value_float();
+
+  if (parser.seen('T')) {
+    const int16_t target = parser.celsiusval('S', 200);
+    if (mpc.heater_power <= 0) {
+      SERIAL_LM(ER, STR_MPC_AUTOTUNE_FAILED " Set the heater power P first");
+      return;
+    }
+    if (target > act->data.temp.max - HEATER_OVERSHOOT) {
+      SERIAL_LM(ER, STR_PID_TEMP_TOO_HIGH);
+      return;
+    }
+    // Autotune finds C, R, A and F
+    act->data.mpc.heater_power = mpc.heater_power;
+    if (mpc.filament_heat_capacity_permm >= 0) act->data.mpc.filament_heat_capacity_permm = mpc.filament_heat_capacity_permm;
+    lcdui.reset_alert_level();
+    act->MPC_autotune(target, parser.boolval('U'));
+    return;
+  }
+
+  // Keep the current model if a new value is out of range
+  if (  (parser.seen('P') && !(mpc.heater_power > 0))
+     || (parser.seen('C') && !(mpc.block_heat_capacity > 0))
+     || (parser.seen('R') && !(mpc.sensor_responsiveness > 0 && mpc.sensor_responsiveness * (PID_dT) <= 1.0f))
+     || (parser.seen('A') && !(mpc.ambient_xfer_coeff_fan0 > 0))
+     || (parser.seen("AF") && !(mpc.ambient_xfer_coeff_fan0 + mpc.fan255_adjustment > 0))
+     || (parser.seen('E') && !(mpc.filament_heat_capacity_permm >= 0))
+  ) {
+    SERIAL_LM(ER, "MPC value out of range");
+    return;
+  }
+
+  act->data.mpc = mpc;
+  act->data.mpc.init();
+  if (mpc.isValid()) act->setPidTuned(true);
+  act->ResetFault();
+
+}
+
+#endif // MPC_TEMP
@@ -0,0 +1,79 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(HEATER_SIMULATION)
+
+#define CODE_M309
+
+/**
+ * M309: Set the simulated plant of a heater, inject faults or run a step response
+ *
+ *   H[heater]    0-5 Hotend, -1 Bed, -2 Chamber, -3 Cooler (default 0)
+ *   T[index]     Bed, Chamber or Cooler index
+ *
+ *    P[watts]    Heater power, negative for a Peltier cooler
+ *    C[J/K]      Heat capacity
+ *    K[W/K]      Heat loss to ambient
+ *    A[W/K]      Extra heat loss with the part fan at 255
+ *    R[1/s]      Sensor responsiveness
+ *    F[fault]    0 None, 1 Heater open, 2 Sensor detached, 3 Sensor open
+ *
+ *    S[temp]     Run a step response from ambient to this target in accelerated time
+ *    L[seconds]  Step response length (default 600)
+ *
+ */
+inline void gcode_M309() {
+
+  Heater * const act = commands.get_target_heater();
+
+  if (!act) return;
+
+  heater_plant_t &p = heaterSim.get_plant(act);
+
+  if (parser.seen('P')) p.power           = parser.value_float();
+  if (parser.seen('C')) p.heat_capacity   = MAX(parser.value_float(), 0.1f);
+  if (parser.seen('K')) p.loss_coeff      = parser.value_float();
+  if (parser.seen('A')) p.fan_loss_coeff  = parser.value_float();
+  if (parser.seen('R')) p.responsiveness  = constrain(parser.value_float(), 0.0f, 1.0f / (PID_dT));
+  if (parser.seen('F')) p.fault           = (SimFaultEnum)constrain(parser.value_byte(), SIM_FAULT_NONE, SIM_FAULT_SENSOR_OPEN);
+
+  if (parser.seenval('S')) {
+    const int16_t target = parser.value_celsius();
+    if (target > act->data.temp.max - HEATER_OVERSHOOT) {
+      SERIAL_LM(ER, STR_PID_TEMP_TOO_HIGH);
+      return;
+    }
+    heaterSim.step_response(act, target, parser.ushortval('L', 600));
+    return;
+  }
+
+  heaterSim.print_M309(act);
+
+}
+
+#endif // HEATER_SIMULATION
@@ -41,6 +41,7 @@
  *  L<int>    Min Speed
  *  X<int>    Max Speed
  *  I<bool>   Inverted pin output
+ *  R<int>    Hold this RPM with the tachometer, R0 back to PWM (TACHOMETRIC, fans with a tach pin only)
  */
 inline void gcode_M106() {
 
@@ -52,6 +53,14 @@ inline void gcode_M106() {
 
   Fan* fan = fans[f];
 
+  #if ENABLED(TACHOMETRIC)
+    // RPM control needs the tach reading
+    if (parser.seen('R') && fan->data.tacho.pin <= 0) {
+      SERIAL_LM(ER, STR_FAN_NO_TACHO);
+      return;
+    }
+  #endif
+
   if (parser.seen('U')) {
     // Put off the fan
     fan->speed = 0;
@@ -72,7 +81,14 @@ inline void gcode_M106() {
   fan->data.speed_limit.max     = parser.byteval('X', fan->data.speed_limit.max);
   fan->data.trigger_temperature = parser.ushortval('T', fan->data.trigger_temperature);
 
-  fan->set_speed(new_speed);
+  #if ENABLED(TACHOMETRIC)
+    if (parser.seen('R'))
+      fan->set_rpm(parser.value_ushort());
+    else if (parser.seen('S'))
+      fan->set_rpm(0);
+    if (!fan->rpm_target)
+  #endif
+      fan->set_speed(new_speed);
 
   #if ENABLED(DUAL_X_CARRIAGE) && MAX_FAN > 1
     // Check for Clone fan
@@ -82,7 +98,7 @@ inline void gcode_M106() {
 
   #if DISABLED(DISABLE_M503)
     // No arguments? Show M106 report.
-    if (!parser.seen("SUIHLXFT")) fanManager.print_M106(f);
+    if (!parser.seen("SUIHLXFTR")) fanManager.print_M106(f);
   #endif
 
 }
@@ -93,5 +109,8 @@ inline void gcode_M106() {
 inline void gcode_M107() {
   uint8_t f = 0;
   if (printer.debugSimulation() || !fanManager.get_target_fan(f)) return;
+  #if ENABLED(TACHOMETRIC)
+    fans[f]->set_rpm(0);
+  #endif
   fans[f]->speed = 0;
 }
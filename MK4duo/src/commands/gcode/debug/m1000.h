@@ -30,6 +30,24 @@
 
 #define CODE_M1000
 
-inline void gcode_M1000() { parser.debug(); }
+/**
+ * M1000: Debug GCODE Parser
+ *
+ *  M1000 [args]  - Report how the parser sees the command
+ *  M1000 B<int>  - Benchmark the parser over a corpus of slicer lines, B times.
+ *                  With FASTER_GCODE_EXECUTE also time the code lookups
+ *                  before (binary search) and after (direct index table).
+ */
+inline void gcode_M1000() {
+  if (parser.seenval('B')) {
+    const uint16_t loops = parser.value_ushort();
+    parser.benchmark(loops);
+    #if ENABLED(FASTER_GCODE_EXECUTE)
+      commands.benchmark_lookup(loops);
+    #endif
+  }
+  else
+    parser.debug();
+}
 
 #endif // DEBUG_GCODE_PARSER
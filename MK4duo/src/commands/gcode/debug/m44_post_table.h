@@ -39,6 +39,7 @@ inline void gcode_M44() {
   if (parser.seen('I')) {
     SERIAL_EMV("Number of G-codes available: ", (int)(COUNT(GCode_Table) + 2));
     SERIAL_MV("G-code table static memory consumption: ", (int)sizeof(GCode_Table));
+    SERIAL_MV(" bytes, index ", (int)sizeof(GCode_Index));
     SERIAL_EM(" bytes.");
 
     SERIAL_EM("Complete list of G-codes available for this machine:");
@@ -52,6 +53,7 @@ inline void gcode_M44() {
   if (parser.seen('J')) {
     SERIAL_EMV("Number of M-codes available: ", (int)COUNT(MCode_Table));
     SERIAL_MV("M-code table static memory consumption: ", (int)sizeof(MCode_Table));
+    SERIAL_MV(" bytes, index ", (int)sizeof(MCode_Index));
     SERIAL_EM(" bytes.");
 
     SERIAL_EM("Complete list of M-codes available for this machine:");
@@ -95,7 +95,7 @@ static void NormaliseEndstopAdjustments() {
 //  Delta radius
 //  X tower position adjustment
 //  Y tower position adjustment
-//  Diagonal rod length adjustment
+//  Diagonal rod length adjustment (7 factors)
 static void Adjust(const uint8_t numFactors, const float v[]) {
 
   const float oldHeightA = homed_height + mechanics.data.endstop_adj.a;
@@ -106,15 +106,12 @@ static void Adjust(const uint8_t numFactors, const float v[]) {
   mechanics.data.endstop_adj.c += v[2];
   NormaliseEndstopAdjustments();
 
-  if (numFactors >= 4) {
-    mechanics.data.radius += v[3];
-
-    if (numFactors >= 6) {
-      mechanics.data.tower_angle_adj.a += v[4];
-      mechanics.data.tower_angle_adj.b += v[5];
-
-      if (numFactors == 7) mechanics.data.diagonal_rod += v[6];
-
+  for (uint8_t col = 3; col < numFactors; col++) {
+    switch (col) {
+      case 3: mechanics.data.radius             += v[col]; break;
+      case 4: mechanics.data.tower_angle_adj.a  += v[col]; break;
+      case 5: mechanics.data.tower_angle_adj.b  += v[col]; break;
+      case 6: mechanics.data.diagonal_rod       += v[col]; break;
     }
   }
 
@@ -126,127 +123,75 @@ static void Adjust(const uint8_t numFactors, const float v[]) {
 
 }
 
-// Compute the derivative of height with respect to a parameter at the specified motor endpoints.
-// 'deriv' indicates the parameter as follows:
+// Return the geometry parameter that derivative 'deriv' perturbs
+static float& derivative_param(const uint8_t deriv) {
+  switch (deriv) {
+    case 3:   return mechanics.data.radius;
+    case 4:   return mechanics.data.tower_angle_adj.a;
+    case 5:   return mechanics.data.tower_angle_adj.b;
+    default:  return mechanics.data.diagonal_rod;
+  }
+}
+
+// Fill column 'deriv' of the derivative matrix with the derivative of height with respect to a parameter
+// at every probe point. The geometry is perturbed once per column rather than once per point,
+// so a parameter costs two delta recalculations whatever the number of points.
+// The column is the parameter as follows:
 // 0, 1, 2 = X, Y, Z tower endstop adjustments
 // 3 = delta radius
 // 4 = X tower correction
 // 5 = Y tower correction
 // 6 = data.diagonal_rod rod length
-// 7, 8 = X tilt, Y tilt. We scale these by the printable radius to get sensible values in the range -1..1
-static float compute_derivative(const uint16_t deriv, const abc_pos_t &hpos) {
+template<uint8_t ROWS, uint8_t COLS>
+static void compute_derivatives(FixedMatrix<float, ROWS, COLS> &matrix, const uint8_t deriv,
+                                const abc_pos_t hpos[], const uint8_t numPoints
+) {
   constexpr float perturb = 0.2;      // perturbation amount in mm or degrees
-  float zHi = 0.0f,
-        zLo = 0.0f;
   abc_float_t newPos  = { 0.0f, 0.0f, 0.0f };
 
   switch (deriv) {
     case 0:
     case 1:
     case 2:
-      // Endstop corrections
-      mechanics.InverseTransform((deriv == 0) ? hpos.a + perturb : hpos.a, (deriv == 1) ? hpos.b + perturb : hpos.b, (deriv == 2) ? hpos.c + perturb : hpos.c, newPos);
-      zHi = newPos.c;
-      mechanics.InverseTransform((deriv == 0) ? hpos.a - perturb : hpos.a, (deriv == 1) ? hpos.b - perturb : hpos.b, (deriv == 2) ? hpos.c - perturb : hpos.c, newPos);
-      zLo = newPos.c;
-      break;
-
-    case 3: {
-      const float old_delta_radius = mechanics.data.radius;
-
-      // Calc High parameters
-      mechanics.data.radius += perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta Radius
-      mechanics.data.radius = old_delta_radius;
-
-      // Calc Low parameters
-      mechanics.data.radius -= perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
-
-      // Reset Delta Radius
-      mechanics.data.radius = old_delta_radius;
-      break;
-    }
-
-    case 4: {
-      const float old_delta_tower_angle_adj = mechanics.data.tower_angle_adj.a;
-
-      // Calc High parameters
-      mechanics.data.tower_angle_adj.a += perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta tower Alpha angle adj 
-      mechanics.data.tower_angle_adj.a = old_delta_tower_angle_adj;
-
-      // Calc Low parameters
-      mechanics.data.tower_angle_adj.a -= perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
-
-      // Reset Delta tower Alpha angle adj 
-      mechanics.data.tower_angle_adj.a = old_delta_tower_angle_adj;
+      // Endstop corrections, geometry is unchanged
+      for (uint8_t i = 0; i < numPoints; i++) {
+        abc_pos_t pos = hpos[i];
+        pos[deriv] += perturb;
+        mechanics.InverseTransform(pos, newPos);
+        const float zHi = newPos.c;
+        pos[deriv] -= 2.0f * perturb;
+        mechanics.InverseTransform(pos, newPos);
+        matrix(i, deriv) = (zHi - newPos.c) / (2.0f * perturb);
+      }
       break;
-    }
 
-    case 5: {
-      const float old_delta_tower_angle_adj = mechanics.data.tower_angle_adj.b;
+    default: {
+      float &param = derivative_param(deriv);
+      const float old_param = param;
 
       // Calc High parameters
-      mechanics.data.tower_angle_adj.b += perturb;
+      param = old_param + perturb;
       mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta tower Beta angle adj 
-      mechanics.data.tower_angle_adj.b = old_delta_tower_angle_adj;
+      for (uint8_t i = 0; i < numPoints; i++) {
+        mechanics.InverseTransform(hpos[i], newPos);
+        matrix(i, deriv) = newPos.c;
+      }
 
       // Calc Low parameters
-      mechanics.data.tower_angle_adj.b -= perturb;
+      param = old_param - perturb;
       mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
-
-      // Reset Delta tower Beta angle adj 
-      mechanics.data.tower_angle_adj.b = old_delta_tower_angle_adj;
-      break;
-    }
-
-    case 6: {
-      const float old_delta_diagonal_rod = mechanics.data.diagonal_rod;
-
-      // Calc High parameters
-      mechanics.data.diagonal_rod += perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta Diagonal Rod
-      mechanics.data.diagonal_rod = old_delta_diagonal_rod;
+      for (uint8_t i = 0; i < numPoints; i++) {
+        mechanics.InverseTransform(hpos[i], newPos);
+        matrix(i, deriv) = (matrix(i, deriv) - newPos.c) / (2.0f * perturb);
+      }
 
-      // Calc Low parameters
-      mechanics.data.diagonal_rod -= perturb;
+      // Reset parameter
+      param = old_param;
       mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
-
-      // Reset Delta Diagonal Rod
-      mechanics.data.diagonal_rod = old_delta_diagonal_rod;
       break;
     }
   }
 
-  mechanics.recalc_delta_settings();
-
-  return (zHi - zLo) / (2.0f * perturb);
 }
 
 /**
@@ -258,8 +203,10 @@ static float compute_derivative(const uint16_t deriv, const abc_pos_t &hpos) {
  *          X, Y and Z endstop adjustments
  *          Delta radius
  *          X tower position adjustment and Y tower position adjustment
- *          Diagonal rod length adjustment
+ *          Diagonal rod length adjustment (7 factors)
  *      P = Num probe points 7 or 10
+ *
+ *  All the factors are solved together by least squares on a single probing pass.
  */
 inline void gcode_G33() {
 
@@ -346,15 +293,11 @@ inline void gcode_G33() {
   // Do 1 or more Newton-Raphson iterations
   do {
 
-    // Build a Nx9 matrix of derivatives
+    // Build a Nx7 matrix of derivatives, one column per factor
     FixedMatrix<float, MaxCalibrationPoints, MaxnumFactors> derivativeMatrix;
 
-    for (uint8_t i = 0; i < probe_points; i++) {
-      for (uint8_t j = 0; j < numFactors; j++) {
-        derivativeMatrix(i, j) =
-          compute_derivative(j, probeMotorPositions[i]);
-      }
-    }
+    for (uint8_t j = 0; j < numFactors; j++)
+      compute_derivatives(derivativeMatrix, j, probeMotorPositions, probe_points);
 
     // Debug Derivative matrix
     if (g33_debug) {
@@ -367,43 +310,18 @@ inline void gcode_G33() {
       }
     }
 
-    // Now build the normal equations for least squares fitting
-    FixedMatrix<float, MaxnumFactors, MaxnumFactors + 1> normalMatrix;
-    for (uint8_t i = 0; i < numFactors; i++) {
-      for (uint8_t j = 0; j < numFactors; j++) {
-        float temp = derivativeMatrix(0, i) * derivativeMatrix(0, j);
-        for (uint8_t k = 1; k < probe_points; k++) {
-          temp += derivativeMatrix(k, i) * derivativeMatrix(k, j);
-        }
-        normalMatrix(i, j) = temp;
-      }
-      float temp = -1 * derivativeMatrix(0, i) * (BedProbePoints[0].z + corrections[0]);
-      for (uint8_t k = 1; k < probe_points; k++) {
-        temp += -1 * derivativeMatrix(k, i) * (BedProbePoints[k].z + corrections[k]);
-      }
-      normalMatrix(i, numFactors) = temp;
-    }
-
-    // Debug Normal matrix
-    if (g33_debug) {
-      SERIAL_EM("Normal matrix");
-      for (uint8_t i = 0; i < numFactors; i++) {
-        for (uint8_t j = 0; j < numFactors + 1; j++) {
-          sprintf_P(rply, PSTR("%7.4f%c"), (double)normalMatrix(i, j), (j == numFactors) ? '\n' : ' ');
-          SERIAL_STR(rply);
-        }
-      }
-    }
+    // Solve the normal equations for least squares fitting
+    float residuals[MaxCalibrationPoints];
+    for (uint8_t k = 0; k < probe_points; k++)
+      residuals[k] = -(BedProbePoints[k].z + corrections[k]);
 
-    if (!normalMatrix.GaussJordan(numFactors, numFactors + 1)) {
+    FixedMatrix<float, MaxnumFactors, MaxnumFactors + 1> normalMatrix;
+    float solution[MaxnumFactors];
+    if (!derivativeMatrix.LeastSquares(probe_points, numFactors, residuals, solution, normalMatrix)) {
 			SERIAL_EM("Unable to calculate calibration parameters. Please reduce probe radius.");
 			return;
 		}
 
-    float solution[numFactors];
-    for (uint8_t i = 0; i < numFactors; ++i)
-			solution[i] = normalMatrix(i, numFactors);
-
     // Debug Solved matrix, solution and residuals
     if (g33_debug) {
       SERIAL_EM("Solved matrix");
@@ -444,7 +362,7 @@ inline void gcode_G33() {
       abc_pos_t newPosition;
       mechanics.InverseTransform(probeMotorPositions[i], newPosition);
       corrections[i] = newPosition.z;
-      expectedResiduals[i] = BedProbePoints[i].z + newPosition.z;
+      expectedResiduals[i] = BedProbePoints[i].z + corrections[i];
       sumOfSquares += sq(expectedResiduals[i]);
     }
 
@@ -0,0 +1,54 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(LAYER_TIME_SCHEDULER)
+
+#define CODE_M157
+
+/**
+ * M157: Layer time scheduler
+ *
+ *  S<bool>   Enable / Disable, disabling restores speed and fan
+ *  T<s>      Minimum layer time
+ *  P<%>      Minimum speed, part of the speed set by M220
+ *  F<s>      Raise the part fan for layers shorter than this
+ *  X<0-255>  Fan speed for layers of the minimum time or less
+ */
+inline void gcode_M157() {
+
+  if (parser.seen('S')) layerTime.enable(parser.value_bool());
+  if (parser.seen('T')) layerTime.min_time = parser.value_ushort();
+  if (parser.seen('P')) layerTime.min_speed = constrain(parser.value_int(), 1, 100);
+  if (parser.seen('F')) layerTime.fan_time = parser.value_ushort();
+  if (parser.seen('X')) layerTime.fan_max_speed = parser.value_byte();
+
+  layerTime.print_M157();
+
+}
+
+#endif // ENABLED(LAYER_TIME_SCHEDULER)
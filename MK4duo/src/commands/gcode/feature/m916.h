@@ -0,0 +1,82 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(TMC_SENSORLESS_CALIBRATION)
+
+  #define CODE_M916
+
+  /**
+   * M916: Sensorless homing calibration
+   *
+   *  X Y Z   Axes to calibrate, X and Y if none. Z only when given,
+   *          and only if it homes to max, a stall test toward the bed is not safe
+   *  D<mm>   Free travel of each trial (default SENSORLESS_CALIBRATION_TRAVEL)
+   *
+   *  M916 S X<mm/s> Y<mm/s> Z<mm/s>
+   *          Set the sensorless homing feedrates, 0 for the default
+   *
+   * The StallGuard thresholds (M914) and feedrates found are kept with M500.
+   */
+  inline void gcode_M916() {
+
+    if (parser.seen('S')) {
+      LOOP_XYZ(i) {
+        if (parser.seenval(axis_codes[i]))
+          tmcManager.sensorless_homing_fr[i] = MAX(parser.value_linear_units(), 0.0f);
+      }
+      return;
+    }
+
+    const float travel = parser.linearval('D', SENSORLESS_CALIBRATION_TRAVEL);
+    if (!WITHIN(travel, (SENSORLESS_CALIBRATION_CLEARANCE) * 2, 500)) {
+      SERIAL_LM(ER, "?(D)istance out of bounds.");
+      return;
+    }
+
+    const bool all = !parser.seen("XYZ");
+    UNUSED(all);
+
+    #if X_HAS_SENSORLESS
+      if (all || parser.seen('X')) tmcManager.calibrate_sensorless(X_AXIS, travel);
+    #endif
+    #if Y_HAS_SENSORLESS
+      if (all || parser.seen('Y')) tmcManager.calibrate_sensorless(Y_AXIS, travel);
+    #endif
+    #if Z_HAS_SENSORLESS
+      if (parser.seen('Z')) {
+        #if Z_HOME_DIR > 0
+          tmcManager.calibrate_sensorless(Z_AXIS, travel);
+        #else
+          SERIAL_LM(ER, "?Sensorless calibration of Z min is not supported.");
+        #endif
+      }
+    #endif
+
+  }
+
+#endif // ENABLED(TMC_SENSORLESS_CALIBRATION)
@@ -38,6 +38,7 @@
 #include "bedlevel/mbl/m421.h"            // Set MBL Manual
 #include "bedlevel/ubl/g29.h"             // UBL
 #include "bedlevel/ubl/m421.h"            // Set UBL Manual
+#include "bedlevel/ubl/m424.h"            // UBL bed temperature mesh blend
 
 // Calibrate Commands
 #include "calibrate/g28.h"                // Home
@@ -65,6 +66,8 @@
 #include "config/m302.h"                  // Allow cold extrudes
 #include "config/m305.h"                  // Set thermistor and ADC parameters
 #include "config/m306.h"                  // Set Heaters
+#include "config/m307.h"                  // Set or autotune the hotend MPC model
+#include "config/m309.h"                  // Heater simulation
 #include "config/m352.h"                  // Set Driver pins and logic
 #include "config/m353.h"                  // Set Number total driver extruder
 #include "config/m563.h"                  // Set Tools heater assignment
@@ -121,6 +124,7 @@
 #include "feature/m125.h"
 #include "feature/m126_m129.h"            // Solenoid feature
 #include "feature/m150.h"
+#include "feature/m157.h"                 // Layer time scheduler
 #include "feature/m240.h"                 // Photo Camera
 #include "feature/m600.h"                 // Advanced Pause change filament
 #include "feature/m603.h"                 // Configure filament change
@@ -128,6 +132,7 @@
 #include "feature/m413.h"                 // Restart Job
 #include "feature/m800.h"                 // Restart Job
 #include "feature/m911_m915.h"            // Set TRINAMIC driver
+#include "feature/m916.h"                 // Sensorless homing calibration
 #include "feature/m930_m939.h"            // Set TRINAMIC driver
 #include "feature/m940_m942.h"            // Set TRINAMIC driver
 #include "feature/m922.h"                 // TMC DEBUG
@@ -147,10 +152,12 @@
 #include "host/m115.h"
 #include "host/m118.h"
 #include "host/m119.h"                    // Endstop status print
+#include "host/m154.h"                    // Auto report position
 #include "host/m408.h"                    // Json output
 #include "host/m530.h"                    // Enables explicit printing mode
 #include "host/m531.h"                    // Define filename being printed
 #include "host/m532_m73.h"                // Update current print state progress
+#include "host/m576.h"                    // Serial output statistics
 #include "host/m876.h"                    // Host Prompt Response
 #include "host/m890.h"                    // Run User Gcode
 
@@ -253,6 +260,7 @@
 #include "temperature/m141.h"
 #include "temperature/m142.h"
 #include "temperature/m155.h"
+#include "temperature/m156.h"             // Temperature history
 #include "temperature/m190.h"
 #include "temperature/m191.h"
 #include "temperature/m192.h"
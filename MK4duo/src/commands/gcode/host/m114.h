@@ -50,6 +50,10 @@ inline void gcode_M114() {
   }
 
   planner.synchronize();
-  mechanics.report_logical_position(mechanics.position);
+  #if ENABLED(STATUS_SNAPSHOT)
+    statusSnapshot.report(SNAPSHOT_POSITION);
+  #else
+    mechanics.report_logical_position(mechanics.position);
+  #endif
 
 }
@@ -56,6 +56,9 @@ inline void gcode_M115() {
   // SERIAL_XON_XOFF
   SERIAL_CAP("SERIAL_XON_XOFF", HAS_XON_XOFF);
 
+  // SELECTIVE_RESEND (Resend only the missing line, CRC16 "^<crc>" checksum)
+  SERIAL_CAP("SELECTIVE_RESEND", HAS_SELECTIVE_RESEND);
+
   // EEPROM (M500, M501)
   SERIAL_CAP("EEPROM", HAS_EEPROM);
 
@@ -0,0 +1,43 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STATUS_SNAPSHOT)
+
+  #define CODE_M154
+
+  /**
+   * M154: Auto report position to host.
+   *  S<seconds> - Set the interval in seconds, 0 to disable.
+   *  P<ms>      - Set the interval in milliseconds.
+   */
+  inline void gcode_M154() {
+    const millis_l ms = parser.seenval('P') ? parser.value_millis() : parser.seenval('S') ? parser.value_millis_from_seconds() : 0;
+    statusSnapshot.set_auto_report(SNAPSHOT_POSITION, ms);
+  }
+
+#endif // ENABLED(STATUS_SNAPSHOT)
@@ -38,6 +38,8 @@
 
   /**
    * M408: JSON STATUS OUTPUT
+   *  S<type> - Type of response
+   *  A<ms>   - Auto report the S0 response every <ms>, 0 to disable (needs STATUS_SNAPSHOT)
    */
   inline void gcode_M408() {
     bool firstOccurrence;
@@ -45,77 +47,87 @@
 
     if (parser.seen('S')) type = parser.value_byte();
 
-    char ch = GetStatusCharacter();
-    SERIAL_MSG("{\"status\":\"");
-    SERIAL_CHR(ch);
+    #if ENABLED(STATUS_SNAPSHOT)
+      if (parser.seen('A')) {
+        statusSnapshot.set_auto_report(SNAPSHOT_JSON, parser.value_millis());
+        return;
+      }
+      statusSnapshot.report(SNAPSHOT_JSON);
+    #else
+      char ch = GetStatusCharacter();
+      SERIAL_MSG("{\"status\":\"");
+      SERIAL_CHR(ch);
 
-    SERIAL_MSG("\",\"coords\": {\"axesHomed\":[");
-    if (mechanics.isHomedAll())
-      SERIAL_MSG("1, 1, 1");
-    else
-      SERIAL_MSG("0, 0, 0");
+      SERIAL_MSG("\",\"coords\": {\"axesHomed\":[");
+      if (mechanics.isHomedAll())
+        SERIAL_MSG("1, 1, 1");
+      else
+        SERIAL_MSG("0, 0, 0");
 
-    SERIAL_MV("],\"extr\":[", mechanics.position.e);
-    SERIAL_MV("],\"xyz\":[", mechanics.position.x); // X AXIS
-    SERIAL_MV(",", mechanics.position.y);           // Y AXIS
-    SERIAL_MV(",", mechanics.position.z);           // Z AXIS
+      SERIAL_MV("],\"extr\":[", mechanics.position.e);
+      SERIAL_MV("],\"xyz\":[", mechanics.position.x); // X AXIS
+      SERIAL_MV(",", mechanics.position.y);           // Y AXIS
+      SERIAL_MV(",", mechanics.position.z);           // Z AXIS
 
-    SERIAL_MV("]},\"currentTool\":", toolManager.extruder.active);
+      SERIAL_MV("]},\"currentTool\":", toolManager.extruder.active);
 
-    #if HAS_POWER_SWITCH
-      SERIAL_MSG(",\"params\": {\"atxPower\":");
-      SERIAL_CHR(powerManager.is_on() ? '1' : '0');
-    #else
-      SERIAL_MSG(",\"params\": {\"NormPower\":");
-    #endif
+      #if HAS_POWER_SWITCH
+        SERIAL_MSG(",\"params\": {\"atxPower\":");
+        SERIAL_CHR(powerManager.is_on() ? '1' : '0');
+      #else
+        SERIAL_MSG(",\"params\": {\"NormPower\":");
+      #endif
 
-    #if HAS_FAN
-      SERIAL_MSG(",\"fanPercent\":[");
-      SERIAL_VAL(fans[0]->speed);
-    #endif
+      #if HAS_FAN
+        SERIAL_MSG(",\"fanPercent\":[");
+        SERIAL_VAL(fans[0]->speed);
+      #endif
 
-    SERIAL_MV("],\"speedFactor\":", mechanics.feedrate_percentage);
+      SERIAL_MV("],\"speedFactor\":", mechanics.feedrate_percentage);
 
-    SERIAL_MSG(",\"extrFactors\":[");
-    firstOccurrence = true;
-    LOOP_EXTRUDER() {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_VAL(extruders[e]->flow_percentage);
-      firstOccurrence = false;
-    }
-    SERIAL_EM("]},");
+      SERIAL_MSG(",\"extrFactors\":[");
+      firstOccurrence = true;
+      LOOP_EXTRUDER() {
+        if (!firstOccurrence) SERIAL_CHR(',');
+        SERIAL_VAL(extruders[e]->flow_percentage);
+        firstOccurrence = false;
+      }
+      SERIAL_EM("]},");
 
-    SERIAL_MSG("\"temps\": {");
-    #if HAS_BEDS
-      SERIAL_MV("\"bed\": {\"current\":", beds[0]->deg_current(), 1);
-      SERIAL_MV(",\"active\":", beds[0]->deg_target());
-      SERIAL_MSG(",\"state\":");
-      SERIAL_CHR(beds[0]->deg_target() > 0 ? '2' : '1');
-      SERIAL_MSG("},");
+      SERIAL_MSG("\"temps\": {");
+      #if HAS_BEDS
+        SERIAL_MV("\"bed\": {\"current\":", beds[0]->deg_current(), 1);
+        SERIAL_MV(",\"active\":", beds[0]->deg_target());
+        SERIAL_MSG(",\"state\":");
+        SERIAL_CHR(beds[0]->deg_target() > 0 ? '2' : '1');
+        SERIAL_MSG("},");
+      #endif
+      SERIAL_MSG("\"heads\": {\"current\":[");
+      firstOccurrence = true;
+      for (int8_t h = 0; h < HOTENDS; h++) {
+        if (!firstOccurrence) SERIAL_CHR(',');
+        SERIAL_VAL(hotends[h]->deg_current(), 1);
+        firstOccurrence = false;
+      }
+      SERIAL_MSG("],\"active\":[");
+      firstOccurrence = true;
+      LOOP_HOTEND() {
+        if (!firstOccurrence) SERIAL_CHR(',');
+        SERIAL_VAL(hotends[h]->deg_target());
+        firstOccurrence = false;
+      }
+      SERIAL_MSG("],\"state\":[");
+      firstOccurrence = true;
+      LOOP_HOTEND() {
+        if (!firstOccurrence) SERIAL_CHR(',');
+        SERIAL_CHR(hotends[h]->deg_target() > HOTEND_AUTO_FAN_TEMPERATURE ? '2' : '1');
+        firstOccurrence = false;
+      }
+
+      SERIAL_MSG("]}}");
     #endif
-    SERIAL_MSG("\"heads\": {\"current\":[");
-    firstOccurrence = true;
-    for (int8_t h = 0; h < HOTENDS; h++) {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_VAL(hotends[h]->deg_current(), 1);
-      firstOccurrence = false;
-    }
-    SERIAL_MSG("],\"active\":[");
-    firstOccurrence = true;
-    LOOP_HOTEND() {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_VAL(hotends[h]->deg_target());
-      firstOccurrence = false;
-    }
-    SERIAL_MSG("],\"state\":[");
-    firstOccurrence = true;
-    LOOP_HOTEND() {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_CHR(hotends[h]->deg_target() > HOTEND_AUTO_FAN_TEMPERATURE ? '2' : '1');
-      firstOccurrence = false;
-    }
 
-    SERIAL_MV("]}},\"time\":", HAL::timeInMilliseconds());
+    SERIAL_MV(",\"time\":", HAL::timeInMilliseconds());
 
     switch (type) {
       case 0:
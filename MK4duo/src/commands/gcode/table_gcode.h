@@ -334,3 +334,48 @@ constexpr GCode_command_t GCode_Table[] = {
   #endif
 
 };
+
+/**
+ * Compile time index sequence used to build the direct index tables
+ * of G and M codes. The template depth is logarithmic in N.
+ */
+template<size_t... I> struct code_seq_t {
+  typedef code_seq_t<I..., (sizeof...(I) + I)...> doubled;
+  typedef code_seq_t<I..., (sizeof...(I) + I)..., 2 * sizeof...(I)> doubled_plus_one;
+};
+
+template<bool odd, typename S> struct code_seq_grow { typedef typename S::doubled type; };
+template<typename S> struct code_seq_grow<true, S> { typedef typename S::doubled_plus_one type; };
+
+template<size_t N> struct make_code_seq {
+  typedef typename code_seq_grow<(N & 1), typename make_code_seq<N / 2>::type>::type type;
+};
+template<> struct make_code_seq<0> { typedef code_seq_t<> type; };
+
+template<size_t N> struct code_index_t { uint16_t index[N]; };
+
+#define CODE_NO_INDEX 0xFFFF
+
+/**
+ * Direct index table for G-codes
+ *
+ * Maps every code below GCODE_INDEX_SIZE to its position
+ * in GCode_Table, or CODE_NO_INDEX if it's not available.
+ */
+#define GCODE_INDEX_SIZE 100
+
+static_assert(COUNT(GCode_Table) < CODE_NO_INDEX, "GCode_Table is too big for the direct index table.");
+
+constexpr uint16_t gcode_find(const uint16_t code, const int16_t lo, const int16_t hi) {
+  return lo > hi                                    ? CODE_NO_INDEX
+       : GCode_Table[(lo + hi) >> 1].code == code   ? uint16_t((lo + hi) >> 1)
+       : GCode_Table[(lo + hi) >> 1].code < code    ? gcode_find(code, ((lo + hi) >> 1) + 1, hi)
+       :                                              gcode_find(code, lo, ((lo + hi) >> 1) - 1);
+}
+
+template<size_t... I>
+constexpr code_index_t<sizeof...(I)> gcode_make_index(code_seq_t<I...>) {
+  return {{ gcode_find(I, 0, COUNT(GCode_Table) - 1)... }};
+}
+
+constexpr code_index_t<GCODE_INDEX_SIZE> GCode_Index PROGMEM = gcode_make_index(make_code_seq<GCODE_INDEX_SIZE>::type());
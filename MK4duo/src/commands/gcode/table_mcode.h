@@ -3048,3 +3048,28 @@ constexpr MCode_command_t MCode_Table [] = {
 	#endif
 
 };
+
+/**
+ * Direct index table for M-codes
+ *
+ * Maps every code below MCODE_INDEX_SIZE to its position
+ * in MCode_Table, or CODE_NO_INDEX if it's not available.
+ * Higher codes are searched in MCode_Table.
+ */
+#define MCODE_INDEX_SIZE 1002
+
+static_assert(COUNT(MCode_Table) < CODE_NO_INDEX, "MCode_Table is too big for the direct index table.");
+
+constexpr uint16_t mcode_find(const uint16_t code, const int16_t lo, const int16_t hi) {
+  return lo > hi                                    ? CODE_NO_INDEX
+       : MCode_Table[(lo + hi) >> 1].code == code   ? uint16_t((lo + hi) >> 1)
+       : MCode_Table[(lo + hi) >> 1].code < code    ? mcode_find(code, ((lo + hi) >> 1) + 1, hi)
+       :                                              mcode_find(code, lo, ((lo + hi) >> 1) - 1);
+}
+
+template<size_t... I>
+constexpr code_index_t<sizeof...(I)> mcode_make_index(code_seq_t<I...>) {
+  return {{ mcode_find(I, 0, COUNT(MCode_Table) - 1)... }};
+}
+
+constexpr code_index_t<MCODE_INDEX_SIZE> MCode_Index PROGMEM = mcode_make_index(make_code_seq<MCODE_INDEX_SIZE>::type());
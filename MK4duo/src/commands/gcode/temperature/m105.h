@@ -35,15 +35,22 @@ inline void gcode_M105() {
 
   SERIAL_STR(OK);
 
-  #if HAS_HEATER
-    tempManager.report_temperatures(parser.boolval('X'));
-  #else
-    SERIAL_MSG(" T:0");
+  #if ENABLED(STATUS_SNAPSHOT)
+    if (!parser.boolval('X'))
+      statusSnapshot.report(SNAPSHOT_TEMP);
+    else
   #endif
+  {
+    #if HAS_HEATER
+      tempManager.report_temperatures(parser.boolval('X'));
+    #else
+      SERIAL_MSG(" T:0");
+    #endif
 
-  #if HAS_FAN
-    fanManager.report_speed();
-  #endif
+    #if HAS_FAN
+      fanManager.report_speed();
+    #endif
+  }
 
   #if ENABLED(FLOWMETER_SENSOR)
     flowmeter.print_flowrate();
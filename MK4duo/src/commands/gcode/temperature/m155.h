@@ -28,8 +28,24 @@
 
 #define CODE_M155
 
-/**
- * M155: S<1/0> Enable/disable auto report temperatures.
- *       When enabled firmware will report temperatures every second.
- */
-inline void gcode_M155() { printer.setAutoreportTemp(parser.boolval('S')); }
+#if ENABLED(STATUS_SNAPSHOT)
+
+  /**
+   * M155: S<seconds> Enable/disable auto report temperatures.
+   *       P<ms> Set the interval in milliseconds, 0 to disable.
+   */
+  inline void gcode_M155() {
+    const millis_l ms = parser.seenval('P') ? parser.value_millis() : parser.seenval('S') ? parser.value_millis_from_seconds() : 0;
+    if (statusSnapshot.set_auto_report(SNAPSHOT_TEMP, ms))
+      printer.setAutoreportTemp(ms > 0);
+  }
+
+#else
+
+  /**
+   * M155: S<1/0> Enable/disable auto report temperatures.
+   *       When enabled firmware will report temperatures every second.
+   */
+  inline void gcode_M155() { printer.setAutoreportTemp(parser.boolval('S')); }
+
+#endif
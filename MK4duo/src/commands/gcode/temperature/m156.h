@@ -0,0 +1,64 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(TEMP_HISTORY)
+
+#define CODE_M156
+
+/**
+ * M156: Temperature history
+ *
+ *  S<0|1>  Dump the history as CSV (S0, default) or as the delta-encoded bytes in hex (S1)
+ *  L<0|1>  Start (L1) or stop (L0) writing every new sample to temphist.csv on the SD
+ *  C       Clear the history
+ */
+inline void gcode_M156() {
+
+  if (parser.seen('C')) {
+    tempHistory.clear();
+    return;
+  }
+
+  #if HAS_SD_SUPPORT
+    if (parser.seen('L')) {
+      if (parser.value_bool())
+        tempHistory.start_log();
+      else
+        tempHistory.stop_log();
+      return;
+    }
+  #endif
+
+  if (parser.boolval('S'))
+    tempHistory.dump_encoded();
+  else
+    tempHistory.dump_csv();
+
+}
+
+#endif // ENABLED(TEMP_HISTORY)
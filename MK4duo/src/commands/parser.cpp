@@ -54,6 +54,12 @@ uint16_t GCodeParser::codenum;
   // Optimized Parameters
   uint32_t  GCodeParser::codebits;  // found bits
   uint8_t   GCodeParser::param[26]; // parameter offsets from command_ptr
+  #if ENABLED(FASTER_GCODE_VALUES)
+    uint32_t  GCodeParser::valbits;   // found values
+    uint8_t   GCodeParser::value_ind; // index of the last seen value
+    float     GCodeParser::fvalue[26];// pre-converted float values
+    int32_t   GCodeParser::lvalue[26];// pre-converted integer values
+  #endif
 #else
   char *GCodeParser::command_args; // start of parameters
 #endif
@@ -76,6 +82,9 @@ void GCodeParser::reset() {
   #endif
   #if ENABLED(FASTER_GCODE_PARSER)
     codebits = 0;                     // No codes yet
+    #if ENABLED(FASTER_GCODE_VALUES)
+      valbits = 0;                    // No values yet
+    #endif
     //ZERO(param);                    // No parameters (should be safe to comment out this line)
   #endif
 }
@@ -127,12 +136,20 @@ void GCodeParser::parse(char *p) {
   const char letter = uppercase(*p++);
 
   // Nullify asterisk and trailing whitespace
-  char *starpos = strchr(p, '*');
-  if (starpos) {
-    --starpos;
-    while (*starpos == ' ') --starpos;  // remove previous spaces...
-    starpos[1] = '\0';
-  }
+  auto nullify_checksum = [](char * const s) {
+    char *starpos = strchr(s, '*');
+    if (starpos) {
+      --starpos;
+      while (*starpos == ' ') --starpos;  // remove previous spaces...
+      starpos[1] = '\0';
+    }
+  };
+
+  // With FASTER_GCODE_VALUES the asterisk is found by the parameters loop,
+  // only lines taken as a whole string need a separate scan.
+  #if DISABLED(FASTER_GCODE_VALUES)
+    nullify_checksum(p);
+  #endif
 
   // Bail if the letter is not G, M, or T
   switch (letter) {
@@ -146,6 +163,9 @@ void GCodeParser::parse(char *p) {
         if (letter == 'T') {
           // check for special MMU2 T?/Tx/Tc commands
           if (*p == '?' || *p == 'x' || *p == 'c') {
+            #if ENABLED(FASTER_GCODE_VALUES)
+              nullify_checksum(p);
+            #endif
             command_letter = letter;
             string_arg = p;
             return;
@@ -192,6 +212,9 @@ void GCodeParser::parse(char *p) {
   // Only use string_arg for these M codes
   if (letter == 'M') switch (codenum) {
     case 23: case 28: case 30: case 117: case 118: case 928:
+      #if ENABLED(FASTER_GCODE_VALUES)
+        nullify_checksum(p);
+      #endif
       string_arg = unescape_string(p);
       return;
     default: break;
@@ -213,6 +236,16 @@ void GCodeParser::parse(char *p) {
   string_arg = nullptr;
   while (const char param = uppercase(*p++)) {  // Get the next parameter. A NUL ends the loop
 
+    #if ENABLED(FASTER_GCODE_VALUES)
+      // The checksum ends the command. Nullify it and the trailing whitespace
+      if (param == '*') {
+        char *e = p - 1;
+        while (e > command_ptr && e[-1] == ' ') --e;
+        *e = '\0';
+        break;
+      }
+    #endif
+
     // Special handling for M32 [P] !/path/to/file.g#
     // The path must be the last parameter
     if (param == '!' && letter == 'M' && codenum == 32) {
@@ -238,8 +271,21 @@ void GCodeParser::parse(char *p) {
 
       while (*p == ' ') ++p;                    // skip spaces between parameters & values
 
-      const bool is_str = (*p == '"'), has_val = is_str || valid_float(p);
-      char * const valptr = has_val ? is_str ? unescape_string(p) : p : nullptr;
+      #if ENABLED(FASTER_GCODE_VALUES)
+        // Convert the value while scanning it. Strings are converted like strtof/strtol would.
+        const bool is_str = (*p == '"');
+        char * const valptr = is_str ? unescape_string(p) : p;
+        char *endptr = valptr;
+        const uint8_t ind = LETTER_BIT(param);
+        const bool has_val = convert_value(endptr, fvalue[ind], lvalue[ind]) || is_str;
+        if (has_val) {
+          SBI32(valbits, ind);
+          if (!is_str) p = endptr;
+        }
+      #else
+        const bool is_str = (*p == '"'), has_val = is_str || valid_float(p);
+        char * const valptr = has_val ? is_str ? unescape_string(p) : p : nullptr;
+      #endif
 
       #if ENABLED(DEBUG_GCODE_PARSER)
         if (debug) {
@@ -261,7 +307,7 @@ void GCodeParser::parse(char *p) {
       #endif
 
       #if ENABLED(FASTER_GCODE_PARSER)
-        set(param, valptr);                     // Set parameter exists and pointer (nullptr for no value)
+        set(param, has_val ? valptr : nullptr); // Set parameter exists and pointer (nullptr for no value)
       #endif
     }
     else if (!string_arg) {                     // Not A-Z? First time, keep as the string_arg
@@ -278,6 +324,57 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if ENABLED(FASTER_GCODE_VALUES)
+
+  /**
+   * Convert a [-+]?[0-9]*.?[0-9]* value in a single pass.
+   * Returns false if no digit was found, like valid_float().
+   * 'p' is advanced past the converted characters.
+   * An 'E' is not taken as exponent, so E parameters can follow.
+   */
+  bool GCodeParser::convert_value(char* &p, float &fval, int32_t &lval) {
+
+    static constexpr uint32_t pow10[] = { 1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL };
+
+    char *s = p;
+    const bool neg = (*s == '-');
+    if (neg || *s == '+') s++;
+
+    bool      digits  = false;
+    uint32_t  ipart   = 0,
+              fpart   = 0;
+    uint8_t   fdigits = 0;
+
+    for (; NUMERIC(*s); s++) {
+      ipart = ipart * 10 + (*s - '0');
+      digits = true;
+    }
+
+    if (*s == '.') {
+      for (s++; NUMERIC(*s); s++) {
+        if (fdigits < COUNT(pow10) - 1) {
+          fpart = fpart * 10 + (*s - '0');
+          fdigits++;
+        }
+        digits = true;
+      }
+    }
+
+    if (!digits) {
+      fval = 0.0f;
+      lval = 0;
+      return false;
+    }
+
+    const float f = float(ipart) + (fdigits ? float(fpart) / float(pow10[fdigits]) : 0.0f);
+    fval = neg ? -f : f;
+    lval = neg ? -int32_t(ipart) : int32_t(ipart);
+    p = s;
+    return true;
+  }
+
+#endif // FASTER_GCODE_VALUES
+
 #if ENABLED(INCH_MODE_SUPPORT)
 
   float GCodeParser::axis_unit_factor(const AxisEnum axis) {
@@ -330,4 +427,52 @@ void GCodeParser::parse(char *p) {
     }
   }
 
+  /**
+   * Parse a corpus of typical slicer lines 'loops' times,
+   * fetching their values, and report the lines per second.
+   * Run it with and without FASTER_GCODE_PARSER / FASTER_GCODE_VALUES
+   * to compare the parser modes on the target board.
+   */
+  void GCodeParser::benchmark(const uint16_t loops) {
+
+    static const char corpus[][40] PROGMEM = {
+      "N1234 G1 X102.385 Y87.112 E1.23456*71",
+      "G1 X110.5 Y90.25 E0.04215",
+      "G1 F1800 X95.123 Y120.874 E2.51234",
+      "G1 X96.004 Y121.338 E0.02876",
+      "G0 F7200 X50 Y50 Z0.3",
+      "G1 Z0.6 F600",
+      "G1 E-0.8 F2100",
+      "G92 E0",
+      "M204 S1000",
+      "M106 S255",
+      "M104 S210 T0",
+      "M73 P42 R17"
+    };
+
+    char * const saved_cmd = command_ptr;
+    char line[40];
+    float sum = 0;
+    uint32_t lines = 0;
+
+    const uint32_t start = micros();
+    for (uint16_t l = 0; l < loops; l++) {
+      for (uint8_t i = 0; i < COUNT(corpus); i++) {
+        strcpy_P(line, corpus[i]);
+        parse(line);
+        sum += floatval('X') + floatval('Y') + floatval('Z') + floatval('E') + floatval('F') + longval('S');
+        lines++;
+      }
+    }
+    const uint32_t elapsed = micros() - start;
+
+    SERIAL_MV("Parsed ", lines);
+    SERIAL_MV(" lines in ", elapsed);
+    SERIAL_MV(" us, ", elapsed ? float(lines) * 1000000.0f / float(elapsed) : 0.0f, 0);
+    SERIAL_MV(" lines/s (checksum ", sum, 3);
+    SERIAL_EM(")");
+
+    parse(saved_cmd); // Restore the parser state
+  }
+
 #endif // DEBUG_GCODE_PARSER
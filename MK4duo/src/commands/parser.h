@@ -36,6 +36,10 @@
  *  - FASTER_GCODE_PARSER:
  *    - Flags existing params (1 bit each)
  *    - Stores value offsets (1 byte each)
+ *  - FASTER_GCODE_VALUES:
+ *    - Tokenizes the line in a single pass
+ *    - Flags params with a numeric value (1 bit each)
+ *    - Stores pre-converted values (8 bytes each)
  *  - Provide accessors for parameters:
  *    - Parameter exists
  *    - Parameter has value
@@ -73,6 +77,12 @@ class GCodeParser {
     #if ENABLED(FASTER_GCODE_PARSER)
       static uint32_t codebits;   // Parameters pre-scanned
       static uint8_t param[26];   // For A-Z, offsets into command args
+      #if ENABLED(FASTER_GCODE_VALUES)
+        static uint32_t valbits;    // Parameters having a numeric value
+        static uint8_t  value_ind;  // Set by seen, index of the value to fetch
+        static float    fvalue[26]; // For A-Z, pre-converted float values
+        static int32_t  lvalue[26]; // For A-Z, pre-converted integer values
+      #endif
     #else
       static char *command_args;  // Args start here, for slow scan
     #endif
@@ -81,6 +91,7 @@ class GCodeParser {
 
     #if ENABLED(DEBUG_GCODE_PARSER)
       static void debug();
+      static void benchmark(const uint16_t loops);
     #endif
 
     // Reset is done before parsing
@@ -126,7 +137,12 @@ class GCodeParser {
         const bool b = TEST32(codebits, ind);
         if (b) {
           char * const ptr = command_ptr + param[ind];
-          value_ptr = param[ind] && valid_float(ptr) ? ptr : nullptr;
+          #if ENABLED(FASTER_GCODE_VALUES)
+            value_ind = ind;
+            value_ptr = TEST32(valbits, ind) ? ptr : nullptr;
+          #else
+            value_ptr = param[ind] && valid_float(ptr) ? ptr : nullptr;
+          #endif
         }
         return b;
       }
@@ -215,29 +231,40 @@ class GCodeParser {
     // The value as a string
     static inline char* value_string() { return value_ptr; }
 
-    // Float removes 'E' to prevent scientific notation interpretation
-    static inline float value_float() {
-      if (value_ptr) {
-        char *e = value_ptr;
-        for (;;) {
-          const char c = *e;
-          if (c == '\0' || c == ' ') break;
-          if (c == 'E' || c == 'e') {
-            *e = '\0';
-            const float ret = strtof(value_ptr, nullptr);
-            *e = c;
-            return ret;
+    #if ENABLED(FASTER_GCODE_VALUES)
+
+      // Values are converted once by parse()
+      static inline float     value_float() { return value_ptr ? fvalue[value_ind] : 0; }
+      static inline int32_t   value_long()  { return value_ptr ? lvalue[value_ind] : 0L; }
+      static inline uint32_t  value_ulong() { return value_ptr ? (uint32_t)lvalue[value_ind] : 0UL; }
+
+    #else
+
+      // Float removes 'E' to prevent scientific notation interpretation
+      static inline float value_float() {
+        if (value_ptr) {
+          char *e = value_ptr;
+          for (;;) {
+            const char c = *e;
+            if (c == '\0' || c == ' ') break;
+            if (c == 'E' || c == 'e') {
+              *e = '\0';
+              const float ret = strtof(value_ptr, nullptr);
+              *e = c;
+              return ret;
+            }
+            ++e;
           }
-          ++e;
+          return strtof(value_ptr, nullptr);
         }
-        return strtof(value_ptr, nullptr);
+        return 0;
       }
-      return 0;
-    }
 
-    // Code value as a long or ulong
-    static inline int32_t   value_long()  { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-    static inline uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+      // Code value as a long or ulong
+      static inline int32_t   value_long()  { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
+      static inline uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+
+    #endif
 
     // Code value for use as time
     static inline millis_l  value_millis()              { return value_ulong(); }
@@ -352,6 +379,10 @@ class GCodeParser {
 
   private: /** Private Function */
 
+    #if ENABLED(FASTER_GCODE_VALUES)
+      static bool convert_value(char* &p, float &fval, int32_t &lval);
+    #endif
+
 };
 
 extern GCodeParser parser;
@@ -71,6 +71,16 @@
 #else
   #define HAS_STATS_MAX_RX_QUEUED       false
 #endif
+#if ENABLED(SELECTIVE_RESEND)
+  #define HAS_SELECTIVE_RESEND          true
+#else
+  #define HAS_SELECTIVE_RESEND          false
+#endif
+#if ENABLED(SERIAL_STATS_TX_BLOCKED)
+  #define HAS_STATS_TX_BLOCKED          true
+#else
+  #define HAS_STATS_TX_BLOCKED          false
+#endif
 
 /**
  * Stored Position
@@ -1006,6 +1016,12 @@
 #if DISABLED(Z_PROBE_REPETITIONS)
   #define Z_PROBE_REPETITIONS 1
 #endif
+#if DISABLED(Z_PROBE_REPETITIONS_SIGMA)
+  #define Z_PROBE_REPETITIONS_SIGMA 0
+#endif
+#if DISABLED(Z_PROBE_OUTLIER_SIGMA)
+  #define Z_PROBE_OUTLIER_SIGMA 0
+#endif
 
 /**
  * Heaters Beds
@@ -39,6 +39,10 @@
 #include "../../../MK4duo.h"
 #include "sanitycheck.h"
 
+#if HAS_UBL
+  #include "mesh_slot.h"
+#endif
+
 // Check the integrity of data offsets.
 // Can be disabled for production build.
 //#define DEBUG_EEPROM_READWRITE
@@ -55,7 +59,7 @@
  * Keep this data structure up to date so
  * EEPROM size is known at compile time!
  */
-#define EEPROM_VERSION "MKV80"
+#define EEPROM_VERSION "MKV81"
 #define EEPROM_OFFSET 100
 
 typedef struct EepromDataStruct {
@@ -279,6 +283,7 @@ typedef struct EepromDataStruct {
     bool      tmc_stealth_enabled[MAX_DRIVER_XYZ],
               tmc_stealth_enabled_e[MAX_DRIVER_E];
     int16_t   tmc_sgt[XYZ];
+    xyz_float_t tmc_sensorless_fr;
   #endif
 
 } eepromDataStruct;
@@ -727,6 +732,17 @@ void EEPROM::post_process() {
       #endif
       EEPROM_WRITE(tmc_sgt);
 
+      //
+      // Sensorless homing feedrate
+      //
+      #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+        EEPROM_WRITE(tmcManager.sensorless_homing_fr);
+      #else
+        xyz_float_t tmc_sensorless_fr;
+        tmc_sensorless_fr.reset();
+        EEPROM_WRITE(tmc_sensorless_fr);
+      #endif
+
     #endif // HAS_TRINAMIC
 
     //
@@ -1161,6 +1177,15 @@ void EEPROM::post_process() {
           }
         #endif
 
+        //
+        // Sensorless homing feedrate
+        //
+        xyz_float_t tmc_sensorless_fr;
+        EEPROM_READ(tmc_sensorless_fr);
+        #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+          if (!flag.validating) tmcManager.sensorless_homing_fr = tmc_sensorless_fr;
+        #endif
+
       #endif // HAS_TRINAMIC
 
       flag.error = size_error(eeprom_index - (EEPROM_OFFSET));
@@ -1213,8 +1238,7 @@ void EEPROM::post_process() {
             ubl.reset();
           }
 
-          if (ubl.storage_slot >= 0) {
-            load_mesh(ubl.storage_slot);
+          if (ubl.storage_slot >= 0 && load_mesh(ubl.storage_slot)) {
             #if ENABLED(EEPROM_CHITCHAT)
               SERIAL_MV("Mesh ", ubl.storage_slot);
               SERIAL_EM(" loaded from storage.");
@@ -1277,11 +1301,11 @@ void EEPROM::post_process() {
     }
 
     uint16_t EEPROM::calc_num_meshes() {
-      return (meshes_end - meshes_start_index()) / sizeof(ubl.z_values);
+      return (meshes_end - meshes_start_index()) / sizeof(mesh_slot_t);
     }
 
     int EEPROM::mesh_slot_offset(const int8_t slot) {
-      return meshes_end - (slot + 1) * sizeof(ubl.z_values);
+      return meshes_end - (slot + 1) * sizeof(mesh_slot_t);
     }
 
     void EEPROM::store_mesh(const int8_t slot) {
@@ -1295,40 +1319,85 @@ void EEPROM::post_process() {
         return;
       }
 
-      uint16_t crc = 0;
+      mesh_slot_t packed;
+      pack_mesh(packed, ubl.z_values);
+      packed.bed_temp =
+        #if HAS_BEDS
+          LROUND(beds[0]->deg_current() * 10.0f)
+        #else
+          MESH_NO_TEMP
+        #endif
+      ;
+
+      // Write the data and then the CRC of the data
       int pos = mesh_slot_offset(slot);
+      const int crc_pos = pos;
+      pos += sizeof(packed.crc);
+      packed.crc = 0;
 
       memorystore.access_start();
-      const bool status = memorystore.write_data(pos, (uint8_t *)&ubl.z_values, sizeof(ubl.z_values), &crc);
-      memorystore.access_write();
+      bool status = memorystore.write_data(pos, MESH_SLOT_DATA(packed), &packed.crc);
+      uint16_t dummy_crc = 0;
+      pos = crc_pos;
+      status |= memorystore.write_data(pos, (uint8_t *)&packed.crc, sizeof(packed.crc), &dummy_crc);
+      status |= memorystore.access_write();
 
       if (status) SERIAL_EM("?Unable to save mesh data.");
       else        DEBUG_EMV("Mesh saved in slot ", slot);
 
     }
 
-    void EEPROM::load_mesh(const int8_t slot, void * const into/*=NULL*/) {
+    bool EEPROM::load_mesh(const int8_t slot, void * const into/*=NULL*/) {
 
       const int16_t a = calc_num_meshes();
 
       if (!WITHIN(slot, 0, a - 1)) {
         ubl_invalid_slot(a);
-        return;
+        return false;
       }
 
+      mesh_slot_t packed;
       int pos = mesh_slot_offset(slot);
-      uint16_t crc = 0;
-      uint8_t * const dest = into ? (uint8_t*)into : (uint8_t*)&ubl.z_values;
+      uint16_t crc = 0, stored_crc = 0;
 
       memorystore.access_start();
-      const bool status = memorystore.read_data(pos, dest, sizeof(ubl.z_values), &crc);
+      bool status = memorystore.read_data(pos, (uint8_t *)&stored_crc, sizeof(stored_crc), &crc);
+      crc = 0;
+      status |= memorystore.read_data(pos, MESH_SLOT_DATA(packed), &crc);
       memorystore.access_write();
 
-      if (status) SERIAL_MSG("?Unable to load mesh data.\n");
-      else        DEBUG_EMV("Mesh loaded from slot ", slot);
+      if (status) {
+        SERIAL_EM("?Unable to load mesh data.");
+        return false;
+      }
+
+      // Keep the current mesh if the slot is not valid
+      if (crc != stored_crc) {
+        SERIAL_EMV("?Invalid mesh data in slot ", slot);
+        return false;
+      }
+
+      unpack_mesh(packed, *(into ? (float (*)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y])into : &ubl.z_values));
+      DEBUG_EMV("Mesh loaded from slot ", slot);
+      return true;
 
     }
 
+    float EEPROM::mesh_bed_temp(const int8_t slot) {
+
+      if (!WITHIN(slot, 0, calc_num_meshes() - 1)) return NAN;
+
+      int pos = mesh_slot_offset(slot) + sizeof(mesh_slot_t::crc);
+      uint16_t crc = 0;
+      int16_t bed_temp = MESH_NO_TEMP;
+
+      memorystore.access_start();
+      const bool status = memorystore.read_data(pos, (uint8_t *)&bed_temp, sizeof(bed_temp), &crc);
+      memorystore.access_write();
+
+      return (status || bed_temp == MESH_NO_TEMP) ? NAN : bed_temp * 0.1f;
+    }
+
   #endif // AUTO_BED_LEVELING_UBL
 
 #else // !HAS_EEPROM
@@ -1501,6 +1570,9 @@ void EEPROM::reset() {
         hotends[h]->print_M305();
         hotends[h]->print_M306();
         hotends[h]->print_M301();
+        #if ENABLED(MPC_TEMP)
+          hotends[h]->print_M307();
+        #endif
       }
     #endif
     #if HAS_BEDS
@@ -91,7 +91,8 @@ class EEPROM {
         static uint16_t calc_num_meshes();
         static int mesh_slot_offset(const int8_t slot);
         static void store_mesh(const int8_t slot);
-        static void load_mesh(const int8_t slot, void * const into=NULL);
+        static bool load_mesh(const int8_t slot, void * const into=NULL); // Return 'true' if the mesh was loaded ok
+        static float mesh_bed_temp(const int8_t slot);                    // Bed temperature of the stored mesh or NAN
       #endif
 
     #else
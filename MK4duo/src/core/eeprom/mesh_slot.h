@@ -0,0 +1,71 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * mesh_slot.h - Packed UBL mesh of an EEPROM mesh slot
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * A mesh slot keeps Z in micrometres from the mean of the mesh,
+ * half the size of the float mesh, with a CRC of the slot data
+ * and the bed temperature when the mesh was stored.
+ */
+
+#define MESH_UNPROBED INT16_MIN
+#define MESH_NO_TEMP  INT16_MIN
+
+typedef struct {
+  uint16_t  crc;
+  int16_t   bed_temp;   // (C x10)
+  float     mean;
+  int16_t   z_um[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+} mesh_slot_t;
+
+// The data covered by the CRC, all the slot after it
+#define MESH_SLOT_DATA(S) (uint8_t *)&S.bed_temp, sizeof(S) - sizeof(S.crc)
+
+inline void pack_mesh(mesh_slot_t &packed, const float (&z_values)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y]) {
+  float sum = 0;
+  uint16_t count = 0;
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      if (!isnan(z_values[x][y])) { sum += z_values[x][y]; count++; }
+
+  packed.mean = count ? sum / count : 0.0f;
+
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+      if (isnan(z_values[x][y]))
+        packed.z_um[x][y] = MESH_UNPROBED;
+      else {
+        const int32_t um = LROUND((z_values[x][y] - packed.mean) * 1000.0f);
+        packed.z_um[x][y] = constrain(um, INT16_MIN + 1, INT16_MAX);
+      }
+    }
+  }
+}
+
+inline void unpack_mesh(const mesh_slot_t &packed, float (&z_values)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y]) {
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      z_values[x][y] = packed.z_um[x][y] == MESH_UNPROBED ? NAN : packed.mean + packed.z_um[x][y] * 0.001f;
+}
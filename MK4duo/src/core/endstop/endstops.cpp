@@ -46,7 +46,8 @@ endstop_flag_t  Endstops::flag;
 uint16_t Endstops::live_state = 0;
 
 #if ENABLED(SPI_ENDSTOPS)
-  tmc_spi_flag_t Endstops::tmc_spi_homing;
+  tmc_spi_flag_t Endstops::tmc_spi_homing,
+                 Endstops::tmc_spi_queued;
 #endif
 
 /** Private Parameters */
@@ -957,32 +958,63 @@ void Endstops::update_software_endstops(const AxisEnum axis) {
   #define Y_STOP (Y_HOME_DIR < 0 ? Y_MIN : Y_MAX)
   #define Z_STOP (Z_HOME_DIR < 0 ? Z_MIN : Z_MAX)
 
-  bool Endstops::tmc_spi_homing_check() {
+  /**
+   * Queue a stallGuard read for each homing axis that has none in the TMC queue.
+   * The reads run in TMC_Manager::spin() and each result queues the next read
+   * of its axis, so the reads are chained as long as the axis is homing.
+   */
+  void Endstops::tmc_spi_homing_check() {
+
+    #if X_SPI_SENSORLESS
+      if (tmc_spi_homing.x && !tmc_spi_queued.x)
+        tmc_spi_queued.x = tmcManager.queue_read(driver.x, TMC_READ_DRV_STATUS, tmc_spi_stall_status);
+    #endif
 
-    bool hit = false;
+    #if Y_SPI_SENSORLESS
+      if (tmc_spi_homing.y && !tmc_spi_queued.y)
+        tmc_spi_queued.y = tmcManager.queue_read(driver.y, TMC_READ_DRV_STATUS, tmc_spi_stall_status);
+    #endif
+
+    #if Z_SPI_SENSORLESS
+      if (tmc_spi_homing.z && !tmc_spi_queued.z)
+        tmc_spi_queued.z = tmcManager.queue_read(driver.z, TMC_READ_DRV_STATUS, tmc_spi_stall_status);
+    #endif
+
+  }
+
+  void Endstops::tmc_spi_stall_status(Driver* drv, const uint32_t drv_status) {
+
+    TMC2130_n::DRV_STATUS_t status{0};
+    status.sr = drv_status;
+
+    // A read queued before the guard period of a new homing is not trusted
+    #if ENABLED(IMPROVE_HOMING_RELIABILITY)
+      const bool stall = status.stallGuard && ELAPSED(millis(), tmcManager.sg_guard_period);
+    #else
+      const bool stall = status.stallGuard;
+    #endif
 
     #if X_SPI_SENSORLESS
-      if (tmc_spi_homing.x && driver.x->tmc->test_stall_status()) {
-        SBI(live_state, X_STOP);
-        hit = true;
+      if (drv == driver.x) {
+        tmc_spi_queued.x = false;
+        if (tmc_spi_homing.x && stall) SBI(live_state, X_STOP);
       }
     #endif
-
     #if Y_SPI_SENSORLESS
-      if (tmc_spi_homing.y && driver.y->tmc->test_stall_status()) {
-        SBI(live_state, Y_STOP);
-        hit = true;
+      if (drv == driver.y) {
+        tmc_spi_queued.y = false;
+        if (tmc_spi_homing.y && stall) SBI(live_state, Y_STOP);
       }
     #endif
-
     #if Z_SPI_SENSORLESS
-      if (tmc_spi_homing.z && driver.z->tmc->test_stall_status()) {
-        SBI(live_state, Z_STOP);
-        hit = true;
+      if (drv == driver.z) {
+        tmc_spi_queued.z = false;
+        if (tmc_spi_homing.z && stall) SBI(live_state, Z_STOP);
       }
     #endif
 
-    return hit;
+    // Chain the next read
+    tmc_spi_homing_check();
 
   }
 
@@ -37,6 +37,7 @@ struct endstop_flag_t {
 };
 
 #if ENABLED(SPI_ENDSTOPS)
+  class Driver;
   union tmc_spi_flag_t {
     bool any;
     struct {
@@ -95,6 +96,10 @@ class Endstops {
 
     static volatile uint8_t hit_state; // use X_MIN, Y_MIN, Z_MIN and Z_PROBE as BIT value
 
+    #if ENABLED(SPI_ENDSTOPS)
+      static tmc_spi_flag_t tmc_spi_queued; // Axes with a stallGuard read in the TMC queue
+    #endif
+
   public: /** Public Function */
 
     /**
@@ -221,7 +226,7 @@ class Endstops {
     }
 
     #if ENABLED(SPI_ENDSTOPS)
-      static bool tmc_spi_homing_check();
+      static void tmc_spi_homing_check();
       static void clear_state();
     #endif
 
@@ -240,6 +245,10 @@ class Endstops {
       static void monitor();
     #endif
 
+    #if ENABLED(SPI_ENDSTOPS)
+      static void tmc_spi_stall_status(Driver* drv, const uint32_t drv_status);
+    #endif
+
 };
 
 extern Endstops endstops;
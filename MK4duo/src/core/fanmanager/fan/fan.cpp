@@ -44,6 +44,12 @@ void Fan::init() {
   setIdle(false);
 
   #if ENABLED(TACHOMETRIC)
+    rpm_target      = 0;
+    rpm_integral    = 0.0f;
+    rpm_reading_ms  = millis();
+    rpm_readings    = 0;
+    stall_count     = 0;
+    stalled         = false;
     data.tacho.init(data.ID);
   #endif
 
@@ -148,6 +154,54 @@ void Fan::spin() {
 }
 
 #if ENABLED(TACHOMETRIC)
+
+  void Fan::set_rpm(const uint16_t rpm) {
+    // Start the integral from the present PWM for a bumpless transfer
+    if (rpm && !rpm_target) rpm_integral = speed;
+    rpm_target = rpm;
+  }
+
+  /**
+   * Every FAN_RPM_PERIOD ms: drive the PWM to hold rpm_target with a PI controller
+   * and flag the fan as stalled when driven without tach pulses for FAN_STALL_TIME.
+   * The tach reading only changes every MaxInterruptCount pulses, the PI acts on
+   * a new reading, or every period on a stopped fan, over the time since the last one.
+   */
+  void Fan::rpm_spin() {
+
+    if (data.tacho.pin <= 0) return;
+
+    const uint16_t rpm = data.tacho.GetRPM();
+    const uint8_t readings = data.tacho.GetReadings();
+
+    if (readings != rpm_readings || rpm == 0) {
+      const millis_l now = millis();
+      const float dt = (now - rpm_reading_ms) * 0.001f;
+      rpm_reading_ms = now;
+      rpm_readings = readings;
+      if (rpm_target && data.auto_monitor == 0 && !isIdle()) {
+        const float error = float(rpm_target) - float(rpm);
+        rpm_integral = constrain(rpm_integral + (FAN_RPM_KI) * dt * error, data.speed_limit.min, data.speed_limit.max);
+        speed = constrain(rpm_integral + (FAN_RPM_KP) * error, data.speed_limit.min, data.speed_limit.max);
+      }
+    }
+
+    if (!kickstart && rpm == 0 && actual_speed() >= FAN_STALL_MIN_PWM) {
+      if (stall_count < (FAN_STALL_TIME) * 1000UL / (FAN_RPM_PERIOD) && ++stall_count == (FAN_STALL_TIME) * 1000UL / (FAN_RPM_PERIOD)) {
+        stalled = true;
+        SERIAL_LMV(ER, STR_FAN_STALLED, int(data.ID));
+        LCD_ALERTMESSAGEPGM_P(PSTR("Err: FAN STALLED"));
+        // A stalled hotend fan lets the heat creep up the heatbreak
+        if (data.auto_monitor & (_BV(HOTENDS) - 1)) tempManager.disable_all_heaters();
+      }
+    }
+    else {
+      stall_count = 0;
+      if (rpm) stalled = false;
+    }
+
+  }
+
   void tacho_interrupt0() { fans[0]->data.tacho.interrupt(); }
   #if FAN_COUNT > 1
     void tacho_interrupt1() { fans[1]->data.tacho.interrupt(); }
@@ -75,10 +75,24 @@ class Fan {
                 scaled_speed,
                 kickstart;
 
+    #if ENABLED(TACHOMETRIC)
+      uint16_t  rpm_target;   // Closed loop RPM, 0 for open loop PWM
+    #endif
+
   public: /** Private Parameters */
 
     uint8_t     pwm_soft_pos;
 
+  private: /** Private Parameters */
+
+    #if ENABLED(TACHOMETRIC)
+      float     rpm_integral;
+      millis_l  rpm_reading_ms;
+      uint8_t   rpm_readings,
+                stall_count;
+      bool      stalled;      // Runtime state, not in data.flag that is stored in EEPROM
+    #endif
+
   public: /** Public Function */
 
     void init();
@@ -90,6 +104,13 @@ class Fan {
     inline uint8_t actual_speed() { return ((kickstart ? data.speed_limit.max : speed) * scaled_speed) >> 7; }
     inline uint8_t percent()      { return ui8topercent(actual_speed()); }
 
+    #if ENABLED(TACHOMETRIC)
+      void set_rpm(const uint16_t rpm);
+      void rpm_spin();
+      inline uint16_t actual_rpm()  { return data.tacho.pin > 0 ? data.tacho.GetRPM() : 0; }
+      FORCE_INLINE bool isStalled() { return stalled; }
+    #endif
+
     // Fan flag bit 0 Hardware inverted
     FORCE_INLINE void setHWinvert(const bool onoff) { data.flag.HWInvert = onoff; }
     FORCE_INLINE bool isHWinvert()                  { return data.flag.HWInvert; }
@@ -80,12 +80,14 @@ struct tacho_data_t {
     static constexpr uint32_t MaxInterruptCount = 32;  // number of tacho interrupts that we average over
 
     uint32_t InterruptCount;          // accessed only in ISR, so no need to declare it volatile
+    volatile uint8_t Readings;        // incremented by the ISR at each new Interval
     volatile millis_l LastResetTime,  // time (microseconds) at which we last reset the interrupt count, accessed inside and outside ISR
                       Interval;       // written by ISR, read outside the ISR
 
   public: /** Public Function */
 
     void init(const uint8_t index) {
+      Readings = 0;
       if (pin > 0) {
         HAL::pinMode(pin, INPUT_PULLUP);
         attachInterrupt(digitalPinToInterrupt(pin), tacho_table[index].function, FALLING);
@@ -99,9 +101,13 @@ struct tacho_data_t {
         Interval = now - LastResetTime;
         LastResetTime = now;
         InterruptCount = 0;
+        ++Readings;
       }
     }
 
+    // Changes each time GetRPM has a new reading, that is every MaxInterruptCount pulses
+    uint8_t GetReadings() { return Readings; }
+
     uint32_t GetRPM() {
       return (Interval != 0 && HAL_timer_get_current_count(STEPPER_TIMER_NUM) - LastResetTime < 3 * STEPPER_CLOCK_RATE)
         ? (STEPPER_CLOCK_RATE * MaxInterruptCount) / (2 * Interval)
@@ -43,6 +43,13 @@ void FanManager::init() { LOOP_FAN() if (fans[f]) fans[f]->init(); }
 
 void FanManager::spin() { LOOP_FAN() if (fans[f]) fans[f]->spin(); }
 
+#if ENABLED(TACHOMETRIC)
+  void FanManager::rpm_spin() {
+    static short_timer_t rpm_timer(millis());
+    if (rpm_timer.expired(FAN_RPM_PERIOD)) LOOP_FAN() if (fans[f]) fans[f]->rpm_spin();
+  }
+#endif
+
 void FanManager::create_object() {
   LOOP_FAN() {
     if (!fans[f]) {
@@ -95,8 +102,10 @@ void FanManager::print_parameters() { LOOP_FAN() if (fans[f]) print_M106(f); }
 void FanManager::report_speed() {
   #if HAS_FAN
     LOOP_FAN() {
-      SERIAL_MV(" F", int(f));
-      SERIAL_MV(":", fans[f]->speed);
+      SERIAL_PRINTF(" F%u:%u", f, fans[f]->speed);
+      #if ENABLED(TACHOMETRIC)
+        if (fans[f]->data.tacho.pin > 0) SERIAL_PRINTF(" RPM%u:%u", f, fans[f]->actual_rpm());
+      #endif
     }
   #endif
 }
@@ -109,6 +118,9 @@ void FanManager::print_M106(const uint8_t f) {
 
   SERIAL_SM(CFG, "Fans: P<Fan> U<Pin> L<Min Speed> X<Max Speed> I<Hardware Inverted 0-1> H<Auto mode> T<Trig Temp>");
   if (act->data.ID == 0) SERIAL_MSG(" F<Freq>");
+  #if ENABLED(TACHOMETRIC)
+    if (act->data.tacho.pin > 0) SERIAL_MSG(" R<RPM>");
+  #endif
   SERIAL_EOL();
   SERIAL_SMV(CFG, "  M106 P", (int)act->data.ID);
   SERIAL_MV(" U", act->data.pin);
@@ -131,6 +143,13 @@ void FanManager::print_M106(const uint8_t f) {
     else
       SERIAL_MSG("-1");
   }
+  #if ENABLED(TACHOMETRIC)
+    if (act->data.tacho.pin > 0) {
+      SERIAL_MV(" R", act->rpm_target);
+      SERIAL_MV(" ; RPM:", act->actual_rpm());
+      if (act->isStalled()) SERIAL_MSG(" stalled");
+    }
+  #endif
   SERIAL_EOL();
 }
 
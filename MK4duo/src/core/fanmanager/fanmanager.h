@@ -61,6 +61,13 @@ class FanManager {
      */
     static void spin();
 
+    /**
+     * Fans RPM control and stall detection, called by idle()
+     */
+    #if ENABLED(TACHOMETRIC)
+      static void rpm_spin();
+    #endif
+
     /**
      * Create Object fan
      */
@@ -47,3 +47,15 @@
 #if DISABLED(HOTEND_AUTO_FAN_MIN_SPEED)
   #error "DEPENDENCY ERROR: Missing setting HOTEND_AUTO_FAN_MIN_SPEED."
 #endif
+
+// Tachometric
+#if ENABLED(TACHOMETRIC)
+  #if DISABLED(FAN_RPM_PERIOD) || !defined(FAN_RPM_KP) || !defined(FAN_RPM_KI)
+    #error "DEPENDENCY ERROR: Missing setting FAN_RPM_PERIOD, FAN_RPM_KP or FAN_RPM_KI."
+  #endif
+  #if DISABLED(FAN_STALL_TIME) || !defined(FAN_STALL_MIN_PWM)
+    #error "DEPENDENCY ERROR: Missing setting FAN_STALL_TIME or FAN_STALL_MIN_PWM."
+  #elif (FAN_STALL_TIME) * 1000UL / (FAN_RPM_PERIOD) > 255
+    #error "DEPENDENCY ERROR: FAN_STALL_TIME is too long for FAN_RPM_PERIOD."
+  #endif
+#endif
@@ -337,7 +337,7 @@ void Core_Mechanics::home(uint8_t axis_bits/*=0*/) {
  */
 void Core_Mechanics::do_homing_move(const AxisEnum axis, const float distance, const feedrate_t fr_mm_s/*=0.0f*/) {
 
-  const feedrate_t real_fr_mm_s = fr_mm_s ? fr_mm_s : homing_feedrate_mm_s[axis];
+  const feedrate_t real_fr_mm_s = fr_mm_s ? fr_mm_s : get_homing_feedrate(axis);
 
   if (printer.debugFeature()) {
     DEBUG_MC(">>> do_homing_move(", axis_codes[axis]);
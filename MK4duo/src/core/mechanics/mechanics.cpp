@@ -224,14 +224,8 @@ void Mechanics::unscaled_e_move(const float &length, const feedrate_t &fr_mm_s)
  * Report position to host
  */
 void Mechanics::report_xyze(const xyze_pos_t &pos, const uint8_t n/*=XYZE*/) {
-  char str[12];
-  for (uint8_t a = 0; a < n; a++) {
-    SERIAL_CHR(' ');
-    SERIAL_CHR(axis_codes[a]);
-    SERIAL_CHR(':');
-    if (pos[a] >= 0) SERIAL_CHR(' ');
-    SERIAL_TXT(dtostrf(pos[a], 1, 3, str));
-  }
+  for (uint8_t a = 0; a < n; a++)
+    Com::printf_P(pos[a] >= 0 ? PSTR(" %c: %.3f") : PSTR(" %c:%.3f"), axis_codes[a], pos[a]);
   SERIAL_EOL();
 }
 
@@ -246,6 +240,54 @@ void Mechanics::report_xyz(const xyz_pos_t &pos) {
   SERIAL_EOL();
 }
 
+/**
+ * Homing feedrate (mm/s)
+ */
+feedrate_t Mechanics::get_homing_feedrate(const AxisEnum axis) {
+  #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+    if (tmcManager.sensorless_homing_fr[axis] > 0) return tmcManager.sensorless_homing_fr[axis];
+  #endif
+  return homing_feedrate_mm_s[axis];
+}
+
+#if ENABLED(TMC_SENSORLESS_CALIBRATION)
+
+  float Mechanics::sensorless_test_move(const AxisEnum axis, const float distance, const feedrate_t fr_mm_s, void (*sample)()/*=nullptr*/) {
+
+    const bool is_home_dir = (get_homedir(axis) > 0) == (distance > 0);
+
+    sensorless_flag_t stealth_states;
+    if (is_home_dir) stealth_states = start_sensorless_homing_per_axis(axis);
+
+    endstops.setEnabled(true);
+
+    abce_pos_t target = planner.get_axis_positions_mm();
+    target[axis] = 0;
+    planner.set_machine_position_mm(target);
+    target[axis] = distance;
+
+    planner.buffer_segment(target, fr_mm_s, toolManager.extruder.active);
+
+    while (planner.has_blocks_queued() || planner.flag.clean_buffer) {
+      if (sample) sample();
+      printer.idle();
+    }
+
+    // The steppers stop at the stall, the distance done is in the step counts
+    const float travelled = planner.get_axis_position_mm(axis);
+
+    if (is_home_dir) {
+      endstops.hit_on_purpose();
+      stop_sensorless_homing_per_axis(axis, stealth_states);
+    }
+
+    endstops.setNotHoming();
+
+    return travelled;
+  }
+
+#endif
+
 /**
  * Homing bump feedrate (mm/s)
  */
@@ -220,6 +220,21 @@ class Mechanics {
      */
     static int8_t get_homedir(const AxisEnum axis);
 
+    /**
+     * Homing feedrate (mm/s), the calibrated sensorless one when there is
+     */
+    static feedrate_t get_homing_feedrate(const AxisEnum axis);
+
+    #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+      /**
+       * Move an axis by distance with StallGuard armed when going toward home.
+       * Unlike a homing move a missing stall is not an error.
+       * 'sample' is called while the move runs.
+       * Return the distance travelled, short of distance if the driver stalled.
+       */
+      static float sensorless_test_move(const AxisEnum axis, const float distance, const feedrate_t fr_mm_s, void (*sample)()=nullptr);
+    #endif
+
     FORCE_INLINE static void setAxisHomed(const AxisEnum axis, const bool onoff) {
       switch (axis) {
         case X_AXIS: home_flag.XHomed = onoff; break;
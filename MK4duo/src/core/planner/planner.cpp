@@ -680,6 +680,26 @@ void Planner::init() {
 
 #endif // HAS_TEMP_HOTEND && ENABLED(AUTOTEMP)
 
+#if ENABLED(PID_ADD_EXTRUSION_RATE) || ENABLED(MPC_TEMP)
+
+  float Planner::get_extrusion_rate(const uint8_t extruder, const millis_l window_ms) {
+
+    float e_mm = 0.0, time_ms = 0.0;
+
+    for (uint8_t b = block_buffer_tail; b != block_buffer_head && time_ms < window_ms; b = next_block_index(b)) {
+      const block_t * const block = &block_buffer[b];
+      if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION) || !block->nominal_rate) continue;
+      time_ms += block->step_event_count * 1000.0f / block->nominal_rate;
+      // Retracts take time but don't melt anything
+      if (block->active_extruder == extruder && block->steps.e && !TEST(block->direction_bits, E_AXIS))
+        e_mm += block->steps.e * extruders[extruder]->steps_to_mm;
+    }
+
+    return time_ms > 0.0 ? e_mm * 1000.0f / time_ms : 0.0;
+  }
+
+#endif // PID_ADD_EXTRUSION_RATE || MPC_TEMP
+
 /**
  * Manage Axis, paste pressure, etc.
  */
@@ -941,6 +961,10 @@ bool Planner::buffer_steps(const xyze_long_t &target
     delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
   }
 
+  #if ENABLED(LAYER_TIME_SCHEDULER)
+    layerTime.add_block(block);
+  #endif
+
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
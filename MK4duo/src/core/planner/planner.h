@@ -586,6 +586,14 @@ class Planner {
       static void autotemp_M104_M109();
     #endif
 
+    #if ENABLED(PID_ADD_EXTRUSION_RATE) || ENABLED(MPC_TEMP)
+      /**
+       * Average forward E speed (mm/s) of the extruder over the
+       * next window_ms of queued moves, for the hotend PID or MPC feed-forward
+       */
+      static float get_extrusion_rate(const uint8_t extruder, const millis_l window_ms);
+    #endif
+
   private: /** Private Function */
 
     /**
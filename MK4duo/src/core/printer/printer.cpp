@@ -184,15 +184,17 @@ void Printer::check_periodical_actions() {
 
   planner.check_axes_activity();
 
-  if (!isSuspendAutoreport() && isAutoreportTemp()) {
-    #if HAS_HEATER
-      tempManager.report_temperatures();
-    #endif
-    #if HAS_FAN
-      fanManager.report_speed();
-    #endif
-    SERIAL_EOL();
-  }
+  #if DISABLED(STATUS_SNAPSHOT)
+    if (!isSuspendAutoreport() && isAutoreportTemp()) {
+      #if HAS_HEATER
+        tempManager.report_temperatures();
+      #endif
+      #if HAS_FAN
+        fanManager.report_speed();
+      #endif
+      SERIAL_EOL();
+    }
+  #endif
 
   #if HAS_SD_SUPPORT
     if (card.isAutoreport()) card.print_status();
@@ -377,10 +379,11 @@ void Printer::idle(const bool no_stepper_sleep/*=false*/) {
       #if ENABLED(IMPROVE_HOMING_RELIABILITY)
         && ELAPSED(millis(), tmcManager.sg_guard_period)
       #endif
-    ) {
-      for (uint8_t i = 4; i--;) // Read SGT 4 times per idle loop
-        if (endstops.tmc_spi_homing_check()) break;
-    }
+    ) endstops.tmc_spi_homing_check(); // Chain the SGT reads of the homing axes
+  #endif
+
+  #if HAS_TMC_QUEUE
+    tmcManager.spin();
   #endif
 
   #if HAS_SD_SUPPORT
@@ -402,6 +405,22 @@ void Printer::idle(const bool no_stepper_sleep/*=false*/) {
 
   commands.get_available();
 
+  #if ENABLED(STATUS_SNAPSHOT)
+    statusSnapshot.spin();
+  #endif
+
+  #if ENABLED(TEMP_HISTORY)
+    tempHistory.idle();
+  #endif
+
+  #if ENABLED(LAYER_TIME_SCHEDULER)
+    layerTime.idle();
+  #endif
+
+  #if ENABLED(TACHOMETRIC)
+    fanManager.rpm_spin();
+  #endif
+
   handle_safety_watch();
 
   if (max_inactivity_timer.expired(SECOND_TO_MILLIS(max_inactive_time))) {
@@ -978,5 +997,10 @@ void loop() {
     commands.advance_queue();
     endstops.report_state();
 
+    // Between commands, the active mesh must not change during a segmented move
+    #if ENABLED(UBL_MESH_TEMP_BLEND)
+      meshBlend.spin();
+    #endif
+
   } while (MK_MAIN_LOOP);
 }
@@ -118,6 +118,11 @@
 #if DISABLED(BUFSIZE)
   #error "DEPENDENCY ERROR: Missing setting BUFSIZE."
 #endif
+
+// GCode parser
+#if ENABLED(FASTER_GCODE_VALUES) && DISABLED(FASTER_GCODE_PARSER)
+  #error "DEPENDENCY ERROR: FASTER_GCODE_VALUES requires FASTER_GCODE_PARSER."
+#endif
 #if ENABLED(SERIAL_XON_XOFF) && RX_BUFFER_SIZE < 1024
   #error "DEPENDENCY ERROR: For SERIAL_XON_XOFF set RX_BUFFER_SIZE to 1024 or more."
 #endif
@@ -50,9 +50,18 @@ char  SDCard::fileName[LONG_FILENAME_LENGTH*SD_MAX_FOLDER_DEPTH+SD_MAX_FOLDER_DE
       SDCard::tempLongFilename[LONG_FILENAME_LENGTH+1],
       SDCard::generatedBy[GENBY_SIZE];
 
+#if ENABLED(ADAPTIVE_MESH)
+  xy_pos_t  SDCard::printMin,
+            SDCard::printMax;
+#endif
+
 /** Private Parameters */
 uint16_t SDCard::nrFile_index = 0;
 
+#if ENABLED(ADAPTIVE_MESH)
+  bool SDCard::printAreaFound = false;
+#endif
+
 #if HAS_EEPROM_SD
   SdFile SDCard::eeprom_file;
 #endif
@@ -499,6 +508,10 @@ bool SDCard::selectFile(const char * const path, const bool silent/*=false*/) {
       parsejson(gcode_file);
     #endif
 
+    #if ENABLED(ADAPTIVE_MESH)
+      printAreaFound = false;
+    #endif
+
     return true;
   }
   else {
@@ -1224,6 +1237,179 @@ bool SDCard::findTotalHeight(char* buf, float &height) {
   return false;
 }
 
+#if ENABLED(ADAPTIVE_MESH)
+
+  /**
+   * The print area of the selected file is searched the first time
+   * it is asked for, a scan of the moves of a big file takes a while.
+   */
+  bool SDCard::hasPrintArea() {
+    if (!isFileOpen()) return false;
+    if (!printAreaFound) {
+      findPrintArea(gcode_file);
+      printAreaFound = true;
+    }
+    return printMin.x <= printMax.x && printMin.y <= printMax.y;
+  }
+
+  /**
+   * Get the XY area of the extrusion moves of the file.
+   * Take the bounds written by the slicer in the header,
+   * or else scan all the moves of the file.
+   * The file is left at the position it was, it may be printing.
+   */
+  void SDCard::findPrintArea(SdFile &parser_file) {
+    printMin.set(99999, 99999);
+    printMax.set(-99999, -99999);
+
+    if (!parser_file.isOpen()) return;
+
+    const uint32_t old_position = parser_file.curPosition();
+
+    // READ 4KB FROM THE BEGINNING
+    char buf[GCI_BUF_SIZE];
+    uint8_t found = 0;
+    for (int i = 0; i < 4096; i += GCI_BUF_SIZE - 50) {
+      if (!parser_file.seekSet(i)) break;
+      const int n = parser_file.read(buf, GCI_BUF_SIZE - 1);
+      if (n <= 0) break;
+      buf[n] = '\0';
+      found |= findPrintBounds(buf, printMin, printMax);
+      if (found == 0x0F) break;
+    }
+
+    if (found != 0x0F) {
+      SERIAL_EM("Scanning the moves of the file for the print area...");
+      scanPrintMoves(parser_file);
+    }
+
+    parser_file.seekSet(old_position);
+  }
+
+  /**
+   * Slicer bounds, Cura: ;MINX:10.5 ;MINY:20.1 ;MAXX:100.2 ;MAXY:95
+   * Return a bit for each bound found
+   */
+  uint8_t SDCard::findPrintBounds(char* buf, xy_pos_t &bmin, xy_pos_t &bmax) {
+    uint8_t found = 0;
+    auto bound = [&](PGM_P const str, float &value, const uint8_t bit) {
+      const char * const pos = strstr_P(buf, str);
+      if (pos) {
+        value = strtod(pos + strlen_P(str), NULL);
+        SBI(found, bit);
+      }
+    };
+    bound(PSTR(";MINX:"), bmin.x, 0);
+    bound(PSTR(";MINY:"), bmin.y, 1);
+    bound(PSTR(";MAXX:"), bmax.x, 2);
+    bound(PSTR(";MAXY:"), bmax.y, 3);
+    return found;
+  }
+
+  /**
+   * Scan the G0-G3 moves of the whole file and take the XY area
+   * of the ones that extrude. Arcs count with their end points.
+   */
+  void SDCard::scanPrintMoves(SdFile &parser_file) {
+
+    struct {
+      bool      relative_xy = false,
+                relative_e  = false;
+      xy_pos_t  pos = { 0, 0 };
+      float     e   = 0;
+    } state;
+
+    // The value of an axis word of the line
+    auto word = [](const char * line, const char c, float &value) -> bool {
+      for (const char *p = line; *p; p++)
+        if (*p == c && (p == line || !isalpha(p[-1]))) {
+          value = strtod(p + 1, NULL);
+          return true;
+        }
+      return false;
+    };
+
+    auto parse_line = [&](char * line) {
+      while (*line == ' ') line++;
+      if (*line == 'N') while (*line && *line != ' ') line++;  // Skip line number
+      while (*line == ' ') line++;
+
+      const char code = *line;
+      if (code != 'G' && code != 'M') return;
+      const int num = atoi(line + 1);
+
+      if (code == 'M') {
+        if (num == 82) state.relative_e = false;
+        else if (num == 83) state.relative_e = true;
+        return;
+      }
+
+      float v;
+      switch (num) {
+        case 90: state.relative_xy = state.relative_e = false; break;
+        case 91: state.relative_xy = state.relative_e = true; break;
+        case 92: {
+          bool any = false;
+          if (word(line + 1, 'X', v)) { state.pos.x = v; any = true; }
+          if (word(line + 1, 'Y', v)) { state.pos.y = v; any = true; }
+          if (word(line + 1, 'Z', v)) any = true;
+          if (word(line + 1, 'E', v)) { state.e = v; any = true; }
+          // A bare G92 sets all the axes to zero
+          if (!any) {
+            state.pos.set(0, 0);
+            state.e = 0;
+          }
+        } break;
+        case 0: case 1: case 2: case 3: {
+          xy_pos_t npos = state.pos;
+          if (word(line + 1, 'X', v)) npos.x = state.relative_xy ? npos.x + v : v;
+          if (word(line + 1, 'Y', v)) npos.y = state.relative_xy ? npos.y + v : v;
+          float de = 0;
+          if (word(line + 1, 'E', v)) {
+            de = state.relative_e ? v : v - state.e;
+            if (!state.relative_e) state.e = v;
+          }
+          if (de > 0 && npos != state.pos) {
+            printMin.x = MIN(printMin.x, state.pos.x, npos.x);
+            printMin.y = MIN(printMin.y, state.pos.y, npos.y);
+            printMax.x = MAX(printMax.x, state.pos.x, npos.x);
+            printMax.y = MAX(printMax.y, state.pos.y, npos.y);
+          }
+          state.pos = npos;
+        } break;
+        default: break;
+      }
+    };
+
+    char buf[GCI_BUF_SIZE], line[MAX_CMD_SIZE];
+    uint8_t len = 0;
+    bool comment = false;
+
+    parser_file.rewind();
+    int n;
+    while ((n = parser_file.read(buf, GCI_BUF_SIZE)) > 0) {
+      for (int i = 0; i < n; i++) {
+        const char c = buf[i];
+        if (c == '\n' || c == '\r') {
+          line[len] = '\0';
+          if (len) parse_line(line);
+          len = 0;
+          comment = false;
+        }
+        else if (c == ';')
+          comment = true;
+        else if (!comment && len < MAX_CMD_SIZE - 1)
+          line[len++] = c;
+      }
+      // The scan of a big file takes a while
+      printer.idle();
+    }
+    line[len] = '\0';
+    if (len) parse_line(line);
+  }
+
+#endif // ADAPTIVE_MESH
+
 #if ENABLED(ADVANCED_SD_COMMAND)
 
   uint8_t SDCard::cidDmp() {
@@ -74,6 +74,11 @@ class SDCard {
                 tempLongFilename[LONG_FILENAME_LENGTH+1],
                 generatedBy[GENBY_SIZE];
 
+    #if ENABLED(ADAPTIVE_MESH)
+      static xy_pos_t printMin,   // XY area of the extrusion moves of the selected file
+                      printMax;
+    #endif
+
   private: /** Private Parameters */
 
     static uint16_t nrFile_index;
@@ -87,6 +92,10 @@ class SDCard {
                         nrFiles;          // counter for the files in the current directory and recycled as position counter for getting the nrFiles'th name in the directory.
     static LsActionEnum lsAction;         // stored for recursion.
 
+    #if ENABLED(ADAPTIVE_MESH)
+      static bool printAreaFound;         // printMin and printMax are those of the selected file
+    #endif
+
     // Sort files and folders alphabetically.
     #if ENABLED(SDCARD_SORT_ALPHA)
       static uint16_t sort_count;         // Count of sorted items in the current directory
@@ -202,6 +211,10 @@ class SDCard {
 
     static bool selectFile(const char * const path, const bool silent=false);
 
+    #if ENABLED(ADAPTIVE_MESH)
+      static bool hasPrintArea();
+    #endif
+
     static int8_t updir();
     static uint16_t getnrfilenames();
     static uint16_t get_num_Files();
@@ -288,6 +301,12 @@ class SDCard {
     static bool findFilamentNeed(char* buf, float &filament);
     static bool findTotalHeight(char* buf, float &objectHeight);
 
+    #if ENABLED(ADAPTIVE_MESH)
+      static void findPrintArea(SdFile &parser_file);
+      static uint8_t findPrintBounds(char* buf, xy_pos_t &bmin, xy_pos_t &bmax);
+      static void scanPrintMoves(SdFile &parser_file);
+    #endif
+
     #if ENABLED(SDCARD_SORT_ALPHA)
       static void flush_presort();
     #endif
@@ -106,6 +106,16 @@
 #endif
 
 // Sensorless homing is required for both combined steppers in an H-bot
+#if ENABLED(TMC_SENSORLESS_CALIBRATION)
+  #if DISABLED(SENSORLESS_HOMING)
+    #error "DEPENDENCY ERROR: TMC_SENSORLESS_CALIBRATION requires SENSORLESS_HOMING."
+  #elif IS_KINEMATIC
+    #error "DEPENDENCY ERROR: TMC_SENSORLESS_CALIBRATION requires a Cartesian or Core machine."
+  #elif DISABLED(SENSORLESS_CALIBRATION_TRAVEL) || DISABLED(SENSORLESS_CALIBRATION_CLEARANCE) || DISABLED(SENSORLESS_CALIBRATION_MARGIN) || DISABLED(SENSORLESS_CALIBRATION_MAX_FEEDRATE)
+    #error "DEPENDENCY ERROR: Missing setting SENSORLESS_CALIBRATION_TRAVEL, _CLEARANCE, _MARGIN or _MAX_FEEDRATE."
+  #endif
+#endif
+
 #if CORE_IS_XY && X_HAS_SENSORLESS != Y_HAS_SENSORLESS
   #error "DEPENDENCY ERROR: CoreXY requires both X and Y to use sensorless homing if either does."
 #elif CORE_IS_XZ && X_HAS_SENSORLESS != Z_HAS_SENSORLESS
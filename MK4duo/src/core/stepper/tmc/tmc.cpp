@@ -42,9 +42,25 @@ TMC_Manager tmcManager;
   millis_l TMC_Manager::sg_guard_period = 0;
 #endif
 
+#if ENABLED(TMC_SENSORLESS_CALIBRATION)
+  xyz_float_t TMC_Manager::sensorless_homing_fr;
+#endif
+
 /** Private Parameters */
 uint16_t TMC_Manager::report_status_interval = 0;
 
+#if HAS_TMC_QUEUE
+  Circular_Queue<tmc_transaction_t, TMC_QUEUE_SIZE> TMC_Manager::transactions;
+#endif
+
+#if ENABLED(MONITOR_DRIVER_STATUS)
+  bool TMC_Manager::need_update_error_counters  = false,
+       TMC_Manager::need_debug_reporting        = false;
+  #if ENABLED(TMC_DEBUG)
+    uint32_t TMC_Manager::last_pwm_scale = 0;
+  #endif
+#endif
+
 /** Public Function */
 void TMC_Manager::init_cs_pins() {
   #if PIN_EXISTS(X_CS)
@@ -434,6 +450,10 @@ void TMC_Manager::factory_parameters() {
     }
   }
 
+  #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+    sensorless_homing_fr.reset();
+  #endif
+
 }
 
 void TMC_Manager::restore() {
@@ -532,30 +552,97 @@ void TMC_Manager::go_to_homing_phase(const AxisEnum axis, const feedrate_t fr_mm
 
 }
 
+#if HAS_TMC_QUEUE
+
+  bool TMC_Manager::queue_read(Driver* drv, const TMCReadEnum reg, tmc_callback_t callback) {
+    tmc_transaction_t transaction;
+    transaction.drv       = drv;
+    transaction.reg       = reg;
+    transaction.callback  = callback;
+    return transactions.enqueue(transaction);
+  }
+
+  void TMC_Manager::spin() {
+
+    if (transactions.isEmpty()) return;
+
+    // Each read is a whole SPI or UART transfer, stop at the time budget
+    const uint32_t start_us = micros();
+    do {
+      const tmc_transaction_t transaction = transactions.dequeue();
+      uint32_t value = 0;
+      if (transaction.drv) {
+        switch (transaction.reg) {
+          case TMC_READ_DRV_STATUS:
+            value = read_drv_status(transaction.drv);
+            break;
+          case TMC_READ_PWM_SCALE:
+            #if ENABLED(MONITOR_DRIVER_STATUS) && ENABLED(TMC_DEBUG)
+              value = get_pwm_scale(transaction.drv);
+            #endif
+            break;
+        }
+      }
+      transaction.callback(transaction.drv, value);
+    } while (!transactions.isEmpty() && (micros() - start_us) < (TMC_QUEUE_TIME_US));
+
+  }
+
+  /** Private Function */
+  uint32_t TMC_Manager::read_drv_status(Driver* drv) {
+    #if HAVE_DRV(TMC2660)
+      return drv->tmc->DRVSTATUS();
+    #else
+      return drv->tmc->DRV_STATUS();
+    #endif
+  }
+
+#endif // HAS_TMC_QUEUE
+
 #if ENABLED(MONITOR_DRIVER_STATUS)
 
+  /**
+   * Queue a status read of every driver at the configured interval.
+   * The results are handled by monitor_driver() as they come from spin().
+   */
   void TMC_Manager::monitor_drivers() {
 
     static short_timer_t next_poll_timer(millis());
 
+    // The stallGuard reads of SPI homing go first
+    #if ENABLED(SPI_ENDSTOPS)
+      if (endstops.tmc_spi_homing.any) return;
+    #endif
+
+    // Wait for the last round of reads
+    if (!transactions.isEmpty()) return;
+
     // Poll TMC drivers at the configured interval
-    bool need_update_error_counters = next_poll_timer.expired(MONITOR_DRIVER_STATUS_INTERVAL_MS);
+    need_update_error_counters = next_poll_timer.expired(MONITOR_DRIVER_STATUS_INTERVAL_MS);
 
     #if ENABLED(TMC_DEBUG)
       static short_timer_t next_debug_reporting_timer(millis());
-      bool need_debug_reporting = next_debug_reporting_timer.expired(report_status_interval);
-    #else
-      constexpr bool need_debug_reporting = false;
+      need_debug_reporting = next_debug_reporting_timer.expired(report_status_interval);
     #endif
 
     if (need_update_error_counters || need_debug_reporting) {
-      LOOP_DRV_ALL_XYZ()
-        if (driver[d] && driver[d]->tmc) monitor_driver(driver[d], need_update_error_counters, need_debug_reporting);
-      LOOP_DRV_EXT()
-        if (driver.e[d] && driver.e[d]->tmc) monitor_driver(driver.e[d], need_update_error_counters, need_debug_reporting);
-      #if ENABLED(TMC_DEBUG)
-        if (need_debug_reporting) SERIAL_EOL();
-      #endif
+      LOOP_DRV_ALL_XYZ() {
+        if (driver[d] && driver[d]->tmc) {
+          #if ENABLED(TMC_DEBUG)
+            if (need_debug_reporting) queue_read(driver[d], TMC_READ_PWM_SCALE, monitor_pwm_scale);
+          #endif
+          queue_read(driver[d], TMC_READ_DRV_STATUS, monitor_driver);
+        }
+      }
+      LOOP_DRV_EXT() {
+        if (driver.e[d] && driver.e[d]->tmc) {
+          #if ENABLED(TMC_DEBUG)
+            if (need_debug_reporting) queue_read(driver.e[d], TMC_READ_PWM_SCALE, monitor_pwm_scale);
+          #endif
+          queue_read(driver.e[d], TMC_READ_DRV_STATUS, monitor_driver);
+        }
+      }
+      if (need_debug_reporting) queue_read(nullptr, TMC_READ_DRV_STATUS, monitor_eol);
     }
 
   }
@@ -580,6 +667,153 @@ void TMC_Manager::go_to_homing_phase(const AxisEnum axis, const feedrate_t fr_mm
 
 #endif
 
+#if ENABLED(TMC_SENSORLESS_CALIBRATION)
+
+  static Driver* sg_sample_drv = nullptr;
+  static running_stats sg_load;
+
+  // StallGuard load during a free run, it falls toward 0 as the motor gets near a stall
+  static void sg_sample() {
+    static short_timer_t next_sample_timer(millis());
+    if (sg_sample_drv && next_sample_timer.expired(5)) sg_load.add(sg_sample_drv->tmc->sg_result());
+  }
+
+  /**
+   * Search the most sensitive StallGuard threshold that runs the axis free
+   * and still stalls at its end. Sensitivity only goes one way with SGT,
+   * so the threshold is found by bisection. The homing feedrate is raised
+   * by steps and the fastest one that passes is kept with its threshold.
+   */
+  bool TMC_Manager::calibrate_sensorless(const AxisEnum axis, const float travel) {
+
+    Driver* drv = driver[axis];
+    if (!drv || !drv->tmc) return false;
+
+    int16_t     best_sgt  = drv->tmc->homing_threshold();
+    feedrate_t  best_fr   = 0.0f;
+
+    // Trials run from the end of the axis with the default feedrate
+    sensorless_homing_fr[axis] = 0.0f;
+    mechanics.home(_BV(axis));
+    float pos = 0.0f;
+
+    SERIAL_EMT("Sensorless calibration ", axis_codes[axis]);
+
+    // Never faster than the axis may move
+    const feedrate_t max_fr = MIN(float(SENSORLESS_CALIBRATION_MAX_FEEDRATE), mechanics.data.max_feedrate_mm_s[axis]);
+
+    for (feedrate_t fr = mechanics.homing_feedrate_mm_s[axis]; fr <= max_fr; fr *= 1.25f) {
+
+      int16_t lo = sgt_min, hi = sgt_max;
+      while (lo < hi) {
+        const int16_t sgt = lo + (hi - lo) / 2;
+        if (sensorless_trial(axis, sgt, fr, travel, pos) == SG_FALSE_TRIGGER)
+          lo = sgt + 1;
+        else
+          hi = sgt;
+      }
+
+      // Confirm with a margin, and read the load of the free run
+      const int16_t sgt = MIN(lo + (SENSORLESS_CALIBRATION_MARGIN), sgt_max);
+      sg_load.reset();
+      const SGTrialEnum result = sensorless_trial(axis, sgt, fr, travel, pos);
+
+      SERIAL_MV(" F", fr, 1);
+      SERIAL_MV(" SGT:", sgt);
+      if (sg_load.count()) {
+        SERIAL_MV(" load mean:", sg_load.mean(), 0);
+        SERIAL_MV(" min:", sg_load.minimum(), 0);
+      }
+      SERIAL_EM(result == SG_STALL_AT_END ? " ok" : result == SG_MISSED ? " missed the end" : " false trigger");
+
+      if (result != SG_STALL_AT_END) break;
+      best_sgt  = sgt;
+      best_fr   = fr;
+    }
+
+    set_axis_homing_threshold(axis, best_sgt);
+    sensorless_homing_fr[axis] = best_fr;
+
+    if (best_fr > 0.0f) {
+      SERIAL_MV("Homing feedrate ", best_fr, 1);
+      SERIAL_EMV(" StallGuard threshold ", best_sgt);
+    }
+    else
+      SERIAL_LM(ER, "Sensorless calibration failed");
+
+    // The trials leave the position unknown
+    mechanics.home(_BV(axis));
+
+    return best_fr > 0.0f;
+  }
+
+  /** Private Function */
+  void TMC_Manager::set_axis_homing_threshold(const AxisEnum axis, const int16_t sgt) {
+    switch (axis) {
+      #if X_HAS_SENSORLESS
+        case X_AXIS:
+          driver.x->tmc->homing_threshold(sgt);
+          #if AXIS_HAS_STALLGUARD(X2)
+            driver.x2->tmc->homing_threshold(sgt);
+          #endif
+          break;
+      #endif
+      #if Y_HAS_SENSORLESS
+        case Y_AXIS:
+          driver.y->tmc->homing_threshold(sgt);
+          #if AXIS_HAS_STALLGUARD(Y2)
+            driver.y2->tmc->homing_threshold(sgt);
+          #endif
+          break;
+      #endif
+      #if Z_HAS_SENSORLESS
+        case Z_AXIS:
+          driver.z->tmc->homing_threshold(sgt);
+          #if AXIS_HAS_STALLGUARD(Z2)
+            driver.z2->tmc->homing_threshold(sgt);
+          #endif
+          #if AXIS_HAS_STALLGUARD(Z3)
+            driver.z3->tmc->homing_threshold(sgt);
+          #endif
+          break;
+      #endif
+      default: break;
+    }
+  }
+
+  /**
+   * One trial of a threshold at a feedrate, the axis is pos mm from its end.
+   *  - Back to travel mm from the end, StallGuard is not armed moving away
+   *  - Run free toward the end up to the clearance, a stall there is false
+   *  - Go on past the end, where the driver has to stall
+   * A whole trial leaves the axis at its end, a false trigger where it stopped.
+   */
+  SGTrialEnum TMC_Manager::sensorless_trial(const AxisEnum axis, const int16_t sgt, const feedrate_t fr_mm_s, const float travel, float &pos) {
+
+    const int8_t home_dir = mechanics.get_homedir(axis);
+
+    set_axis_homing_threshold(axis, sgt);
+
+    mechanics.sensorless_test_move(axis, -home_dir * (travel - pos), mechanics.homing_feedrate_mm_s[axis]);
+    pos = travel;
+
+    const float free_run = travel - (SENSORLESS_CALIBRATION_CLEARANCE);
+    sg_sample_drv = driver[axis];
+    const float free_done = ABS(mechanics.sensorless_test_move(axis, home_dir * free_run, fr_mm_s, sg_sample));
+    sg_sample_drv = nullptr;
+    pos -= free_done;
+    if (free_done < free_run - 0.1f) return SG_FALSE_TRIGGER;
+
+    // Stalled or pushed against it, the axis ends at its end
+    const float to_end = pos + (SENSORLESS_CALIBRATION_CLEARANCE),
+                end_done = ABS(mechanics.sensorless_test_move(axis, home_dir * to_end, fr_mm_s));
+    pos = 0.0f;
+
+    return end_done < to_end - 0.1f ? SG_STALL_AT_END : SG_MISSED;
+  }
+
+#endif // TMC_SENSORLESS_CALIBRATION
+
 #if ENABLED(TMC_DEBUG)
 
   /**
@@ -783,6 +1017,20 @@ void TMC_Manager::go_to_homing_phase(const AxisEnum axis, const feedrate_t fr_mm
         #endif
         SERIAL_EOL();
       #endif
+      #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+        SERIAL_LM(CFG, "Sensorless homing feedrate (mm/s), 0 for the default:");
+        SERIAL_SM(CFG, "  M916 S");
+        #if X_HAS_SENSORLESS
+          SERIAL_MV(" X", sensorless_homing_fr.x, 1);
+        #endif
+        #if Y_HAS_SENSORLESS
+          SERIAL_MV(" Y", sensorless_homing_fr.y, 1);
+        #endif
+        #if Z_HAS_SENSORLESS
+          SERIAL_MV(" Z", sensorless_homing_fr.z, 1);
+        #endif
+        SERIAL_EOL();
+      #endif
     #endif // HAS_SENSORLESS
   }
 
@@ -1167,11 +1415,11 @@ bool TMC_Manager::test_connection(Driver* drv) {
 
   #if HAVE_DRV(TMC2208)
 
-    TMC_driver_data TMC_Manager::get_driver_data(Driver* drv) {
+    TMC_driver_data TMC_Manager::get_driver_data(const uint32_t ds) {
       constexpr uint8_t OTPW_bp = 0, OT_bp = 1;
       constexpr uint8_t S2G_bm = 0b11110;
       TMC_driver_data data;
-      const auto ds = data.drv_status = drv->tmc->DRV_STATUS();
+      data.drv_status = ds;
       data.is_otpw = TEST(ds, OTPW_bp);
       data.is_ot = TEST(ds, OT_bp);
       data.is_s2g = !!(ds & S2G_bm);
@@ -1198,11 +1446,11 @@ bool TMC_Manager::test_connection(Driver* drv) {
 
   #elif HAVE_DRV(TMC2660)
 
-    TMC_driver_data TMC_Manager::get_driver_data(Driver* drv) {
+    TMC_driver_data TMC_Manager::get_driver_data(const uint32_t ds) {
       constexpr uint8_t OT_bp = 1, OTPW_bp = 2;
       constexpr uint8_t S2G_bm = 0b11000;
       TMC_driver_data data;
-      const auto ds = data.drv_status = drv->tmc->DRVSTATUS();
+      data.drv_status = ds;
       uint8_t spart = ds & 0xFF;
       data.is_otpw = TEST(spart, OTPW_bp);
       data.is_ot = TEST(spart, OT_bp);
@@ -1221,7 +1469,7 @@ bool TMC_Manager::test_connection(Driver* drv) {
 
   #elif HAS_TMCX1XX
 
-    TMC_driver_data TMC_Manager::get_driver_data(Driver* drv) {
+    TMC_driver_data TMC_Manager::get_driver_data(const uint32_t ds) {
       constexpr uint8_t OT_bp = 25, OTPW_bp = 26;
       constexpr uint32_t S2G_bm = 0x18000000;
       #if ENABLED(TMC_DEBUG)
@@ -1232,7 +1480,7 @@ bool TMC_Manager::test_connection(Driver* drv) {
         constexpr uint8_t STST_bp = 31;
       #endif
       TMC_driver_data data;
-      const auto ds = data.drv_status = drv->tmc->DRV_STATUS();
+      data.drv_status = ds;
       #ifdef __AVR__
         // 8-bit optimization saves up to 70 bytes of PROGMEM per axis
         uint8_t spart;
@@ -1275,9 +1523,9 @@ bool TMC_Manager::test_connection(Driver* drv) {
 
   #endif
 
-  void TMC_Manager::monitor_driver(Driver* drv, const bool need_update_error_counters, const bool need_debug_reporting) {
+  void TMC_Manager::monitor_driver(Driver* drv, const uint32_t drv_status) {
 
-    TMC_driver_data data = get_driver_data(drv);
+    TMC_driver_data data = get_driver_data(drv_status);
     if ((data.drv_status == 0xFFFFFFFF) || (data.drv_status == 0x0)) return;
 
     if (need_update_error_counters) {
@@ -1336,9 +1584,8 @@ bool TMC_Manager::test_connection(Driver* drv) {
 
     #if ENABLED(TMC_DEBUG)
       if (need_debug_reporting) {
-        const uint32_t pwm_scale = get_pwm_scale(drv);
         drv->printLabel();
-        SERIAL_MV(":", pwm_scale);
+        SERIAL_MV(":", last_pwm_scale);
         #if ENABLED(TMC_DEBUG)
           #if HAS_TMCX1XX || HAVE_DRV(TMC2208)
             SERIAL_MV("/", data.cs_actual);
@@ -1368,6 +1615,21 @@ bool TMC_Manager::test_connection(Driver* drv) {
     #endif
   }
 
+  // Queued after the last driver, ends the debug report line
+  void TMC_Manager::monitor_eol(Driver* drv, const uint32_t value) {
+    UNUSED(drv);
+    UNUSED(value);
+    SERIAL_EOL();
+  }
+
+  #if ENABLED(TMC_DEBUG)
+    // Queued before the status read of the same driver
+    void TMC_Manager::monitor_pwm_scale(Driver* drv, const uint32_t pwm_scale) {
+      UNUSED(drv);
+      last_pwm_scale = pwm_scale;
+    }
+  #endif
+
 #endif // MONITOR_DRIVER_STATUS
 
 #if ENABLED(TMC_DEBUG)
@@ -51,8 +51,36 @@
   #define MONITOR_DRIVER_STATUS_INTERVAL_MS 500U
 #endif
 
+#define HAS_TMC_QUEUE (ENABLED(MONITOR_DRIVER_STATUS) || ENABLED(SPI_ENDSTOPS))
+
+#if HAS_TMC_QUEUE && DISABLED(TMC_QUEUE_TIME_US)
+  #define TMC_QUEUE_TIME_US 250U
+#endif
+
 class Driver;
 
+#if HAS_TMC_QUEUE
+
+  enum TMCReadEnum : uint8_t { TMC_READ_DRV_STATUS, TMC_READ_PWM_SCALE };
+
+  typedef void (*tmc_callback_t)(Driver* drv, const uint32_t value);
+
+  // Driver register read waiting in the TMC queue, a null driver only calls back
+  struct tmc_transaction_t {
+    Driver*         drv;
+    TMCReadEnum     reg;
+    tmc_callback_t  callback;
+  };
+
+  #define TMC_QUEUE_SIZE  ((MAX_DRIVER) * 2 + 2)
+
+#endif
+
+#if ENABLED(TMC_SENSORLESS_CALIBRATION)
+  // Outcome of a sensorless calibration trial
+  enum SGTrialEnum : uint8_t { SG_FALSE_TRIGGER, SG_STALL_AT_END, SG_MISSED };
+#endif
+
 struct TMC_driver_data {
   uint32_t  drv_status;
   bool      is_otpw:  1,
@@ -395,10 +423,26 @@ class TMC_Manager {
       static constexpr uint16_t default_sg_guard_duration = 400;
     #endif
 
+    #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+      static xyz_float_t sensorless_homing_fr;  // Calibrated homing feedrate (mm/s), 0 for the default
+    #endif
+
   private: /** Private Parameters */
 
     static uint16_t report_status_interval;
 
+    #if HAS_TMC_QUEUE
+      static Circular_Queue<tmc_transaction_t, TMC_QUEUE_SIZE> transactions;
+    #endif
+
+    #if ENABLED(MONITOR_DRIVER_STATUS)
+      static bool     need_update_error_counters,
+                      need_debug_reporting;
+      #if ENABLED(TMC_DEBUG)
+        static uint32_t last_pwm_scale;
+      #endif
+    #endif
+
   public: /** Public Function */
 
     static void init_cs_pins();
@@ -413,6 +457,19 @@ class TMC_Manager {
 
     static void go_to_homing_phase(const AxisEnum axis, const feedrate_t fr_mm_s);
 
+    #if HAS_TMC_QUEUE
+      /**
+       * Queue a register read, the callback gets the value from spin().
+       * Return false if the queue is full.
+       */
+      static bool queue_read(Driver* drv, const TMCReadEnum reg, tmc_callback_t callback);
+
+      /**
+       * Run the queued reads for up to TMC_QUEUE_TIME_US, called by idle()
+       */
+      static void spin();
+    #endif
+
     #if ENABLED(MONITOR_DRIVER_STATUS)
       static void monitor_drivers();
     #endif
@@ -422,6 +479,14 @@ class TMC_Manager {
       static void disable_stallguard(Driver* drv, const bool enable);
     #endif
 
+    #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+      /**
+       * Find the StallGuard threshold and the fastest reliable homing feedrate of an axis.
+       * Return false if no feedrate passed.
+       */
+      static bool calibrate_sensorless(const AxisEnum axis, const float travel);
+    #endif
+
     #if ENABLED(TMC_DEBUG)
       #if ENABLED(MONITOR_DRIVER_STATUS)
         static void set_report_interval(const uint16_t update_interval);
@@ -473,8 +538,17 @@ class TMC_Manager {
 
     static bool test_connection(Driver* drv);
 
+    #if HAS_TMC_QUEUE
+      static uint32_t read_drv_status(Driver* drv);
+    #endif
+
     static void config(Driver* drv, const bool stealth=false);
 
+    #if ENABLED(TMC_SENSORLESS_CALIBRATION)
+      static void set_axis_homing_threshold(const AxisEnum axis, const int16_t sgt);
+      static SGTrialEnum sensorless_trial(const AxisEnum axis, const int16_t sgt, const feedrate_t fr_mm_s, const float travel, float &pos);
+    #endif
+
     #if ENABLED(MONITOR_DRIVER_STATUS)
 
       #if ENABLED(TMC_DEBUG)
@@ -487,8 +561,12 @@ class TMC_Manager {
         #endif
       #endif
 
-      static TMC_driver_data get_driver_data(Driver* drv);
-      static void monitor_driver(Driver* drv, const bool need_update_error_counters, const bool need_debug_reporting);
+      static TMC_driver_data get_driver_data(const uint32_t ds);
+      static void monitor_driver(Driver* drv, const uint32_t drv_status);
+      static void monitor_eol(Driver* drv, const uint32_t value);
+      #if ENABLED(TMC_DEBUG)
+        static void monitor_pwm_scale(Driver* drv, const uint32_t pwm_scale);
+      #endif
 
     #endif
 
@@ -58,6 +58,9 @@ void Heater::init() {
   ResetFault();
   next_check_timer.start();
   data.pid.init();
+  #if ENABLED(MPC_TEMP)
+    data.mpc.init();
+  #endif
 
   watch_target_temp     = 0;
   idle_timeout_ms       = 0;
@@ -65,7 +68,7 @@ void Heater::init() {
 
   thermal_runaway_state = TRInactive;
 
-  data.sensor.CalcDerivedParameters();
+  update_sensor_parameters();
 
   if (printer.isRunning()) return; // All running not reinitialize
 
@@ -137,6 +140,10 @@ void Heater::wait_for_target(bool no_wait_for_cooling/*=true*/) {
 
   short_timer_t next_cool_check_timer;
 
+  #if ENABLED(HEATUP_POWER_BUDGET)
+    short_timer_t next_ready_report_timer(millis());
+  #endif
+
   const bool oldReport = printer.isAutoreportTemp();
 
   printer.setWaitForHeatUp(true);
@@ -163,6 +170,11 @@ void Heater::wait_for_target(bool no_wait_for_cooling/*=true*/) {
       if (!wants_to_cool) ledevents.onHeating(isHotend, start_temp, temp, target_temperature);
     #endif
 
+    #if ENABLED(HEATUP_POWER_BUDGET)
+      if (!wants_to_cool && next_ready_report_timer.expired(SECOND_TO_MILLIS(10)))
+        heatup.report_ready_time();
+    #endif
+
     #if TEMP_RESIDENCY_TIME > 0
 
       const float temp_diff = ABS(target_temperature - temp);
@@ -206,6 +218,15 @@ void Heater::wait_for_target(bool no_wait_for_cooling/*=true*/) {
   printer.setAutoreportTemp(oldReport);
 }
 
+void Heater::update_current_temperature() {
+  #if ENABLED(HEATER_SIMULATION)
+    heaterSim.read_sensor(this);
+  #else
+    if (!sensor_table.lookup(data.sensor.adc_raw, current_temperature))
+      current_temperature = data.sensor.getTemperature();
+  #endif
+}
+
 void Heater::get_output() {
 
   update_idle_timer();
@@ -218,16 +239,19 @@ void Heater::get_output() {
     #if HAS_COOLERS
       if (type == IS_COOLER) {
         if (isUsePid()) {
-          pwm_value = data.pid.compute(current_temperature, targetTemperature
-            #if ENABLED(PID_ADD_EXTRUSION_RATE)
-              , 0xFF
-            #endif
-          );
+          pwm_value = data.pid.compute(current_temperature, targetTemperature);
         }
         else if (next_check_timer.expired(temp_check_interval))
           pwm_value = current_temperature >= targetTemperature ? data.pid.drive.max : 0;
       }
       else
+    #endif
+    #if ENABLED(MPC_TEMP)
+      // The model plans the whole warm-up, no bang-bang outside the hysteresis band.
+      // A model that is not set or out of range falls back to PID.
+      if (type == IS_HOTEND && isUsePid() && data.mpc.isValid())
+        pwm_value = data.mpc.compute(targetTemperature, current_temperature, data.pid.Max, mpc_fan_speed(), mpc_e_rate());
+      else
     #endif
       {
         if (current_temperature >= targetTemperature + temp_hysteresis)
@@ -236,11 +260,13 @@ void Heater::get_output() {
           pwm_value = data.pid.Max;
         else if (isUsePid()) {
           #if ENABLED(PID_ADD_EXTRUSION_RATE)
-            const uint8_t id = (type == IS_HOTEND) ? data.ID : 0xFF;
+            const float e_rate = (type == IS_HOTEND && data.ID == toolManager.active_hotend())
+              ? planner.get_extrusion_rate(toolManager.extruder.active, tempManager.heater.lpq_len * PID_SAMPLE_TIME)
+              : 0.0f;
           #endif
           pwm_value = data.pid.compute(targetTemperature, current_temperature
             #if ENABLED(PID_ADD_EXTRUSION_RATE)
-              , id, tempManager.heater.lpq_len
+              , e_rate
             #endif
           );
         }
@@ -265,8 +291,25 @@ void Heater::get_output() {
 
 }
 
+// Cut the output computed by get_output and tell the controller that made it
+void Heater::limit_output(const uint8_t pwm) {
+  if (pwm >= pwm_value) return;
+  pwm_value = pwm;
+  #if ENABLED(MPC_TEMP)
+    if (type == IS_HOTEND && isUsePid() && data.mpc.isValid())
+      data.mpc.limit_output(pwm);
+    else
+  #endif
+      data.pid.limit_output(pwm);
+}
+
 void Heater::set_output_pwm() {
 
+  // The simulated plants take the PWM, the heater pins stay off
+  #if ENABLED(HEATER_SIMULATION)
+    return;
+  #endif
+
   const uint8_t new_pwm = isHWinvert() ? 255 - pwm_value : pwm_value;
 
   if (data.pin > NoPin) {
@@ -300,11 +343,15 @@ void Heater::check_and_power() {
   else
     consecutive_low_temp = 0;
 
-  // Check for thermal runaway
+  // Check for thermal runaway, against the thermal model if there is one
   if (isThermalProtection()) {
     thermal_runaway_protection();
-    if (thermal_runaway_state == TRRunaway)
-      temp_error(PSTR(STR_T_THERMAL_RUNAWAY), GET_TEXT(MSG_THERMAL_RUNAWAY));
+    #if ENABLED(THERMAL_PROTECTION_MODEL)
+      if (runaway_model_check())
+    #else
+      if (thermal_runaway_state == TRRunaway)
+    #endif
+        temp_error(PSTR(STR_T_THERMAL_RUNAWAY), GET_TEXT(MSG_THERMAL_RUNAWAY));
   }
 
   // Ignore heater we are currently testing
@@ -573,6 +620,200 @@ void Heater::PID_autotune(const float target_temp, const uint8_t ncycles, const
 
 }
 
+#if ENABLED(MPC_TEMP)
+
+  /**
+   * MPC Autotuning (M307 T)
+   *
+   * With the part fan on, cool down until the temperature settles, to get the ambient.
+   * Then, with the fan off, heat at full power up to the target and fit the
+   * exponential response to get the block heat capacity, the sensor lag and the
+   * heat loss. Finally hold the target with the model to measure the steady-state
+   * power with the fan off and at full speed.
+   */
+  void Heater::MPC_autotune(const int16_t target_temp, const bool storeValues/*=false*/) {
+
+    constexpr uint8_t MPC_TUNE_SAMPLES = 16;
+
+    const bool oldReport = printer.isAutoreportTemp();
+    #if HAS_FAN
+      const uint8_t old_fan_speed = fans[0]->speed;
+    #endif
+
+    tempManager.disable_all_heaters();
+
+    printer.setWaitForHeatUp(true);
+    printer.setAutoreportTemp(true);
+
+    Pidtuning = true;
+    ResetFault();
+
+    mpc_data_t tune_mpc = data.mpc;
+    const float max_power = tune_mpc.heater_power * data.pid.Max * (1.0f / 255.0f);
+
+    // One idle step of a tuning phase, false to abort on M108, overheat or timeout
+    auto tune_idle = [&](const millis_l start_ms, const millis_l timeout_ms) -> bool {
+      lcdui.update();
+      printer.idle();
+      update_current_temperature();
+      if (!printer.isWaitForHeatUp()) {
+        SERIAL_LM(ER, STR_MPC_AUTOTUNE_INTERRUPTED);
+        return false;
+      }
+      if (current_temperature > data.temp.max) {
+        SERIAL_LM(ER, STR_PID_TEMP_TOO_HIGH);
+        return false;
+      }
+      if (millis() - start_ms > timeout_ms) {
+        SERIAL_LM(ER, STR_PID_TIMEOUT);
+        return false;
+      }
+      return true;
+    };
+
+    // Hold the target with the model, then average power and temperature over MPC_TUNE_MEASURE seconds
+    float hold_power, hold_temp;
+    auto tune_hold = [&](const uint8_t fan_speed) -> bool {
+      const millis_l start_ms = millis();
+      short_timer_t sample_timer(start_ms);
+      uint16_t count = 0;
+      hold_power = hold_temp = 0.0;
+      while (millis() - start_ms < SECOND_TO_MILLIS(MPC_TUNE_SETTLE + MPC_TUNE_MEASURE)) {
+        if (!tune_idle(start_ms, SECOND_TO_MILLIS(MPC_TUNE_SETTLE + MPC_TUNE_MEASURE + 60))) return false;
+        if (sample_timer.expired(PID_SAMPLE_TIME)) {
+          pwm_value = tune_mpc.compute(target_temp, current_temperature, data.pid.Max, fan_speed, 0.0f);
+          if (millis() - start_ms > SECOND_TO_MILLIS(MPC_TUNE_SETTLE)) {
+            hold_power += pwm_value * tune_mpc.heater_power * (1.0f / 255.0f);
+            hold_temp += current_temperature;
+            count++;
+          }
+        }
+      }
+      if (!count) return false;
+      hold_power /= count;
+      hold_temp /= count;
+      return true;
+    };
+
+    bool done = false;
+
+    do {
+
+      // Ambient temperature, when it drops less than 0.25C in 30 seconds
+      SERIAL_EM(STR_MPC_AUTOTUNE_START STR_MPC_COOLING_TO_AMBIENT);
+      #if HAS_FAN
+        fans[0]->set_speed(255);
+      #endif
+      pwm_value = 0;
+
+      millis_l start_ms = millis(), next_check_ms = start_ms + SECOND_TO_MILLIS(30);
+      float last_temp = current_temperature;
+      bool  settled   = false;
+      while (!settled && tune_idle(start_ms, SECOND_TO_MILLIS(30 * 60))) {
+        if (PENDING(millis(), next_check_ms)) continue;
+        next_check_ms += SECOND_TO_MILLIS(30);
+        settled = last_temp - current_temperature < 0.25f;
+        last_temp = current_temperature;
+      }
+      if (!settled) break;
+
+      const float ambient_temp = current_temperature;
+      SERIAL_EMV(" Ambient:", ambient_temp);
+
+      // Full power step response, sampled with a doubling interval to fit any heating time
+      SERIAL_EM(STR_MPC_AUTOTUNE_PREFIX STR_MPC_HEATING_PAST_TARGET);
+      #if HAS_FAN
+        fans[0]->set_speed(0);
+      #endif
+      pwm_value = data.pid.Max;
+
+      float     samples[MPC_TUNE_SAMPLES];
+      uint8_t   sample_count    = 0;
+      millis_l  sample_interval = 1000UL;
+      bool      heated          = false;
+      start_ms = millis();
+      while (!heated && tune_idle(start_ms, SECOND_TO_MILLIS(20 * 60))) {
+        if (millis() - start_ms < sample_count * sample_interval) continue;
+        if (sample_count == MPC_TUNE_SAMPLES) {
+          LOOP_L_N(i, MPC_TUNE_SAMPLES / 2) samples[i] = samples[i << 1];
+          sample_count = MPC_TUNE_SAMPLES / 2;
+          sample_interval <<= 1;
+        }
+        samples[sample_count++] = current_temperature;
+        heated = current_temperature >= target_temp && sample_count >= 7;
+      }
+      pwm_value = 0;
+      if (!heated) break;
+
+      // Three equally spaced samples on the block response T = asymp + (T0 - asymp) * e^(-k*t)
+      const uint8_t i3 = sample_count - 1,
+                    d  = i3 / 3,
+                    i2 = i3 - d,
+                    i1 = i2 - d;
+      const float t1 = samples[i1], t2 = samples[i2], t3 = samples[i3],
+                  denominator = 2.0f * t2 - t1 - t3;
+      if (denominator <= 0.0f) {
+        SERIAL_LM(ER, STR_MPC_AUTOTUNE_FAILED);
+        break;
+      }
+      const float asymp_temp            = (t2 * t2 - t1 * t3) / denominator,
+                  block_responsiveness  = -LOG((t3 - asymp_temp) / (t2 - asymp_temp)) / (d * sample_interval * 0.001f),
+                  t1_time               = i1 * sample_interval * 0.001f;
+
+      tune_mpc.ambient_xfer_coeff_fan0  = max_power / (asymp_temp - ambient_temp);
+      tune_mpc.block_heat_capacity      = tune_mpc.ambient_xfer_coeff_fan0 / block_responsiveness;
+      tune_mpc.sensor_responsiveness    = block_responsiveness / (1.0f - (ambient_temp - asymp_temp) * EXP(-block_responsiveness * t1_time) / (t1 - asymp_temp));
+      tune_mpc.fan255_adjustment        = 0.0f;
+      tune_mpc.init();
+      tune_mpc.set_ambient(ambient_temp);
+      if (!tune_mpc.isValid()) {
+        SERIAL_LM(ER, STR_MPC_AUTOTUNE_FAILED);
+        break;
+      }
+
+      // Steady-state losses with the fan off and at full speed
+      SERIAL_EM(STR_MPC_AUTOTUNE_PREFIX STR_MPC_MEASURING_LOSSES);
+      if (!tune_hold(0)) break;
+      tune_mpc.ambient_xfer_coeff_fan0 = hold_power / (hold_temp - ambient_temp);
+
+      #if HAS_FAN
+        fans[0]->set_speed(255);
+        if (!tune_hold(255)) break;
+        tune_mpc.fan255_adjustment = hold_power / (hold_temp - ambient_temp) - tune_mpc.ambient_xfer_coeff_fan0;
+      #endif
+
+      done = tune_mpc.isValid();
+      if (!done) SERIAL_LM(ER, STR_MPC_AUTOTUNE_FAILED);
+
+    } while (false);
+
+    pwm_value = 0;
+    Pidtuning = false;
+
+    if (done) {
+      SERIAL_EM(STR_MPC_AUTOTUNE_FINISHED);
+      data.mpc = tune_mpc;
+      data.mpc.init();
+      setPidTuned(true);
+      print_M307();
+      if (storeValues) eeprom.store();
+    }
+
+    #if HAS_FAN
+      fans[0]->set_speed(old_fan_speed);
+    #endif
+
+    tempManager.disable_all_heaters();
+
+    printer.setWaitForHeatUp(false);
+    printer.setAutoreportTemp(oldReport);
+
+    LCD_MESSAGEPGM(MSG_WELCOME);
+
+  }
+
+#endif // MPC_TEMP
+
 void Heater::print_M301() {
   if (isUsePid()) {
     const int8_t heater_id = type == IS_HOTEND ? data.ID : -type;
@@ -580,7 +821,7 @@ void Heater::print_M301() {
     if (heater_id < 0) SERIAL_MSG(" T<tools>");
     SERIAL_MSG(" P<Proportional> I<Integral> D<Derivative>");
     #if ENABLED(PID_ADD_EXTRUSION_RATE)
-      if (type == IS_HOTEND) SERIAL_MSG(" C<Kc term> L<LPQ length>");
+      if (type == IS_HOTEND) SERIAL_MSG(" C<Kc term> L<Lookahead>");
     #endif
     SERIAL_CHR(':');
     SERIAL_EOL();
@@ -650,6 +891,24 @@ void Heater::print_M306() {
 
 }
 
+#if ENABLED(MPC_TEMP)
+
+  void Heater::print_M307() {
+    if (type != IS_HOTEND) return;
+    SERIAL_SM(CFG, "Hotend MPC parameters: H<Hotend> P<Heater power W> C<Block heat capacity J/K> R<Sensor responsiveness> A<Ambient xfer coeff W/K> F<Fan 255 adjustment W/K> E<Filament heat capacity J/K/mm>:");
+    SERIAL_EOL();
+    SERIAL_SMV(CFG, "  M307 H", int(data.ID));
+    SERIAL_MV(" P", data.mpc.heater_power, 2);
+    SERIAL_MV(" C", data.mpc.block_heat_capacity, 2);
+    SERIAL_MV(" R", data.mpc.sensor_responsiveness, 4);
+    SERIAL_MV(" A", data.mpc.ambient_xfer_coeff_fan0, 4);
+    SERIAL_MV(" F", data.mpc.fan255_adjustment, 4);
+    SERIAL_MV(" E", data.mpc.filament_heat_capacity_permm, 4);
+    SERIAL_EOL();
+  }
+
+#endif // MPC_TEMP
+
 #if HAS_AD8495 || HAS_AD595
   void Heater::print_M595() {
     const int8_t heater_id = type == IS_HOTEND ? data.ID : -type;
@@ -709,6 +968,14 @@ void Heater::thermal_runaway_protection() {
         }
       #endif
 
+      #if ENABLED(THERMAL_PROTECTION_MODEL)
+        // The thermal model takes over from the hysteresis, see runaway_model_check()
+        if (runaway_model_valid()) {
+          thermal_runaway_timer.start();
+          break;
+        }
+      #endif
+
       if (current_temperature >= target_temperature - THERMAL_PROTECTION_HYSTERESIS) {
         thermal_runaway_timer.start();
         break;
@@ -835,3 +1102,47 @@ void Heater::update_idle_timer() {
   if (!isIdle() && idle_timeout_ms && (ELAPSED(millis(), idle_timeout_ms)))
     setIdle(true);
 }
+
+#if ENABLED(MPC_TEMP)
+
+  // The part fan cools the hotend block too
+  uint8_t Heater::mpc_fan_speed() {
+    #if HAS_FAN
+      return fans[0]->actual_speed();
+    #else
+      return 0;
+    #endif
+  }
+
+  // Filament about to be extruded through this hotend, over the model horizon
+  float Heater::mpc_e_rate() {
+    if (data.ID != toolManager.active_hotend()) return 0.0f;
+    return planner.get_extrusion_rate(toolManager.extruder.active, millis_l(MPC_HORIZON * 1000));
+  }
+
+  #if ENABLED(THERMAL_PROTECTION_MODEL)
+
+    // Hotends with a valid thermal model are checked against it instead of the hysteresis
+    bool Heater::runaway_model_valid() {
+      return type == IS_HOTEND && isActive() && data.mpc.isValid();
+    }
+
+    /**
+     * Once the target is reached a hotend with a valid thermal model is checked
+     * against the model, that also follows the part fan and the flow, and the
+     * hysteresis check is off. A heat-up leaves too much room for an error of
+     * the model, until the target is reached the watch period applies.
+     * Without a valid model the thermal runaway state applies as before.
+     */
+    bool Heater::runaway_model_check() {
+      if (thermal_runaway_state == TRRunaway) return true;
+      if (!runaway_model_valid() || thermal_runaway_state != TRStable) {
+        runaway.init();
+        return false;
+      }
+      return runaway.check(data.mpc, current_temperature, pwm_value, mpc_fan_speed(), mpc_e_rate(), THERMAL_PROTECTION_MODEL_LIMIT);
+    }
+
+  #endif
+
+#endif // MPC_TEMP
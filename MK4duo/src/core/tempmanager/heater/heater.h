@@ -52,6 +52,9 @@ struct heater_data_t {
   limit_int_t     temp;
   pid_data_t      pid;
   sensor_data_t   sensor;
+  #if ENABLED(MPC_TEMP)
+    mpc_data_t    mpc;
+  #endif
 };
 
 class Heater {
@@ -77,6 +80,8 @@ class Heater {
 
     float           current_temperature;
 
+    sensor_table_t  sensor_table;
+
     const HeatertypeEnum type;
 
   private: /** Private Parameters */
@@ -94,6 +99,10 @@ class Heater {
 
     TRState         thermal_runaway_state;
 
+    #if ENABLED(THERMAL_PROTECTION_MODEL)
+      runaway_model_t runaway;
+    #endif
+
     millis_l        idle_timeout_ms;
 
     short_timer_t   next_check_timer;
@@ -110,6 +119,7 @@ class Heater {
     void wait_for_target(bool no_wait_for_cooling=true);
 
     void get_output();
+    void limit_output(const uint8_t pwm);
     void set_output_pwm();
 
     void check_and_power();
@@ -119,6 +129,10 @@ class Heater {
     void print_M301();
     void print_M305();
     void print_M306();
+    #if ENABLED(MPC_TEMP)
+      void MPC_autotune(const int16_t target_temp, const bool storeValues=false);
+      void print_M307();
+    #endif
     #if HAS_AD8495 || HAS_AD595
       void print_M595();
     #endif
@@ -129,7 +143,12 @@ class Heater {
     void thermal_runaway_protection();
     void start_watching();
 
-    FORCE_INLINE void update_current_temperature() { this->current_temperature = this->data.sensor.getTemperature(); }
+    void update_current_temperature();
+
+    FORCE_INLINE void update_sensor_parameters() {
+      this->data.sensor.CalcDerivedParameters();
+      this->sensor_table.build(this->data.sensor);
+    }
     FORCE_INLINE int16_t deg_current()  { return this->current_temperature + 0.5f; }
     FORCE_INLINE int16_t deg_target()   { return this->target_temperature;  }
     FORCE_INLINE int16_t deg_idle()     { return this->idle_temperature;    }
@@ -195,6 +214,12 @@ class Heater {
       target_temperature = 0;
       pwm_value = 0;
       data.pid.reset();
+      #if ENABLED(MPC_TEMP)
+        data.mpc.init();
+      #endif
+      #if ENABLED(THERMAL_PROTECTION_MODEL)
+        runaway.init();
+      #endif
       setActive(false);
     }
 
@@ -208,6 +233,16 @@ class Heater {
 
     void update_idle_timer();
 
+    #if ENABLED(MPC_TEMP)
+      uint8_t mpc_fan_speed();
+      float mpc_e_rate();
+    #endif
+
+    #if ENABLED(THERMAL_PROTECTION_MODEL)
+      bool runaway_model_valid();
+      bool runaway_model_check();
+    #endif
+
 };
 
 #if HAS_HOTENDS
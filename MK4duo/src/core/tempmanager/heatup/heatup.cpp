@@ -0,0 +1,158 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * heatup.cpp - Parallel heat-up scheduler
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(HEATUP_POWER_BUDGET)
+
+HeatupScheduler heatup;
+
+/** Private Parameters */
+float     HeatupScheduler::rate[HEATUP_HEATERS]       = { 0.0f },
+          HeatupScheduler::last_temp[HEATUP_HEATERS]  = { 0.0f };
+uint16_t  HeatupScheduler::duty_sum[HEATUP_HEATERS]   = { 0 };
+uint8_t   HeatupScheduler::rate_count                 = 0;
+
+/** Public Function */
+void HeatupScheduler::spin() {
+
+  Heater* list[HEATUP_HEATERS];
+  float   watts[HEATUP_HEATERS],
+          want[HEATUP_HEATERS],
+          key[HEATUP_HEATERS],
+          demand = 0.0f;
+
+  const uint8_t n = get_heaters(list, watts);
+
+  const bool update_rate = ++rate_count >= HEATUP_RATE_PERIOD;
+  if (update_rate) rate_count = 0;
+
+  for (uint8_t i = 0; i < n; i++) {
+    Heater* act = list[i];
+
+    // Heating rate at full power from the rise of the last period and the duty applied in it.
+    // Learned only while heating up, holding at target the rise is 0 whatever the duty.
+    if (update_rate) {
+      const float duty = duty_sum[i] * (1.0f / (255.0f * HEATUP_RATE_PERIOD));
+      if (time_to_target(act, i) != 0.0f && duty >= HEATUP_MIN_DUTY) {
+        const float r = MAX(0.0f, (act->current_temperature - last_temp[i]) * (10.0f / HEATUP_RATE_PERIOD) / duty);
+        rate[i] = rate[i] > 0.0f ? rate[i] + 0.3f * (r - rate[i]) : r;
+      }
+      last_temp[i] = act->current_temperature;
+      duty_sum[i] = 0;
+    }
+
+    want[i] = act->pwm_value * watts[i] * (1.0f / 255.0f);
+    demand += want[i];
+
+    // Holding heaters first, then unknown rates, then the longest time to target
+    const float eta = time_to_target(act, i);
+    key[i] = eta == 0.0f ? 1e9f : eta < 0.0f ? 1e8f : eta;
+  }
+
+  if (demand > HEATUP_POWER_BUDGET) {
+
+    uint8_t order[HEATUP_HEATERS];
+    for (uint8_t i = 0; i < n; i++) {
+      uint8_t j = i;
+      for (; j > 0 && key[order[j - 1]] < key[i]; j--) order[j] = order[j - 1];
+      order[j] = i;
+    }
+
+    float remaining = HEATUP_POWER_BUDGET;
+    for (uint8_t k = 0; k < n; k++) {
+      const uint8_t i = order[k];
+      if (want[i] <= remaining)
+        remaining -= want[i];
+      else {
+        list[i]->limit_output(remaining * 255.0f / watts[i]);
+        remaining = 0.0f;
+      }
+    }
+  }
+
+  for (uint8_t i = 0; i < n; i++) duty_sum[i] += list[i]->pwm_value;
+
+}
+
+int16_t HeatupScheduler::ready_time() {
+
+  Heater* list[HEATUP_HEATERS];
+  float   watts[HEATUP_HEATERS],
+          longest = 0.0f,
+          energy  = 0.0f;
+
+  const uint8_t n = get_heaters(list, watts);
+
+  for (uint8_t i = 0; i < n; i++) {
+    const float eta = time_to_target(list[i], i);
+    if (eta < 0.0f) return -1;
+    NOLESS(longest, eta);
+    energy += eta * watts[i];
+  }
+
+  // Heaters sharing the budget can't all run at full power
+  return MIN(32767.0f, MAX(longest, energy * (1.0f / (HEATUP_POWER_BUDGET))) + 0.5f);
+}
+
+void HeatupScheduler::report_ready_time() {
+  const int16_t seconds = ready_time();
+  if (seconds < 0)
+    SERIAL_LM(ECHO, STR_HEATUP_ESTIMATING);
+  else
+    SERIAL_LMV(ECHO, STR_HEATUP_READY_IN, seconds);
+}
+
+/** Private Function */
+uint8_t HeatupScheduler::get_heaters(Heater* list[], float watts[]) {
+
+  uint8_t n = 0;
+
+  #if HAS_HOTENDS
+    constexpr float hotend_watts[] = HEATUP_HOTEND_WATTS;
+    LOOP_HOTEND() { list[n] = hotends[h]; watts[n++] = hotend_watts[h]; }
+  #endif
+  #if HAS_BEDS
+    constexpr float bed_watts[] = HEATUP_BED_WATTS;
+    LOOP_BED() { list[n] = beds[h]; watts[n++] = bed_watts[h]; }
+  #endif
+  #if HAS_CHAMBERS
+    constexpr float chamber_watts[] = HEATUP_CHAMBER_WATTS;
+    LOOP_CHAMBER() { list[n] = chambers[h]; watts[n++] = chamber_watts[h]; }
+  #endif
+
+  return n;
+}
+
+// Seconds to target at full power, 0 if holding or off, -1 while heating if the rate is not known yet
+float HeatupScheduler::time_to_target(Heater* act, const uint8_t i) {
+  if (!act->isActive() || !act->isHeating() || !act->wait_for_heating()) return 0.0f;
+  if (rate[i] <= 0.0f) return -1.0f;
+  const float target = act->isIdle() ? act->idle_temperature : act->target_temperature;
+  return (target - act->current_temperature) / rate[i];
+}
+
+#endif // ENABLED(HEATUP_POWER_BUDGET)
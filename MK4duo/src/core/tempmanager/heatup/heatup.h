@@ -0,0 +1,79 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * heatup.h - Parallel heat-up scheduler
+ *
+ * Beds, chambers and hotends heat at the same time, with the sum of their
+ * power kept within HEATUP_POWER_BUDGET. Heaters holding their target are
+ * served first, then the heaters still heating, longest time to target
+ * first, so the slowest heater is never the one held back.
+ * The heating rate of each heater at full power is learned while it heats.
+ */
+
+#if ENABLED(HEATUP_POWER_BUDGET)
+
+#define HEATUP_HEATERS      ((MAX_HOTEND) + (MAX_BED) + (MAX_CHAMBER))
+#define HEATUP_RATE_PERIOD  10    // Spin cycles (100ms) between heating rate updates
+#define HEATUP_MIN_DUTY     0.2f  // Minimum mean duty to learn the heating rate
+
+class HeatupScheduler {
+
+  public: /** Constructor */
+
+    HeatupScheduler() {}
+
+  private: /** Private Parameters */
+
+    static float    rate[HEATUP_HEATERS],       // (K/s) Heating rate at full power
+                    last_temp[HEATUP_HEATERS];
+
+    static uint16_t duty_sum[HEATUP_HEATERS];
+
+    static uint8_t  rate_count;
+
+  public: /** Public Function */
+
+    /**
+     * Share the power budget between the heaters, called from TempManager::spin()
+     */
+    static void spin();
+
+    /**
+     * Estimated seconds until all heaters are at target, -1 while still learning
+     */
+    static int16_t ready_time();
+
+    static void report_ready_time();
+
+  private: /** Private Function */
+
+    static uint8_t get_heaters(Heater* list[], float watts[]);
+
+    static float time_to_target(Heater* act, const uint8_t i);
+
+};
+
+extern HeatupScheduler heatup;
+
+#endif // ENABLED(HEATUP_POWER_BUDGET)
@@ -0,0 +1,139 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * mpc.h - Model predictive control object
+ *
+ * The hotend is modelled as a heater block with heat capacity C, heated by
+ * the cartridge and losing heat to ambient (more with the part fan on, and to
+ * the filament being extruded), plus a sensor that follows the block with a
+ * first order lag. Every sample the model is advanced with the applied power,
+ * pulled towards the measured temperature, and the power needed to bring the
+ * block to target within MPC_HORIZON seconds is computed from it.
+ */
+
+#if ENABLED(MPC_TEMP)
+
+#define MPC_HORIZON       2.0f  // (s) Time to plan the block to reach the target
+#define MPC_AMBIENT_TEMP    25    // (C) Ambient guess before the model learns it
+#define MPC_TUNE_SETTLE     30    // (s) M307 T hold time before measuring the losses
+#define MPC_TUNE_MEASURE    30    // (s) M307 T time to average the losses
+
+struct mpc_data_t {
+
+  public: /** Public Parameters */
+
+    float heater_power,                 // (W)    Cartridge power
+          block_heat_capacity,          // (J/K)  Heater block heat capacity
+          sensor_responsiveness,        // (1/s)  Sensor lag behind the block
+          ambient_xfer_coeff_fan0,      // (W/K)  Heat loss to ambient with the part fan off
+          fan255_adjustment,            // (W/K)  Extra heat loss with the part fan at 255
+          filament_heat_capacity_permm; // (J/K/mm) Heat taken by each mm of filament
+
+  private: /** Private Parameters */
+
+    float block_temp    = 0.0,
+          sensor_temp   = 0.0,
+          ambient_temp  = 0.0,
+          last_power    = 0.0;
+
+    bool  initialized   = false;
+
+  public: /** Public Function */
+
+    void init() { initialized = false; }
+
+    /**
+     * The model is usable if all values are positive and one sample step
+     * of the block and of the sensor can't overshoot, i.e. stays stable.
+     */
+    bool isValid() {
+      return  heater_power > 0
+          &&  block_heat_capacity > 0
+          &&  sensor_responsiveness > 0 && sensor_responsiveness * (PID_dT) <= 1.0f
+          &&  ambient_xfer_coeff_fan0 > 0 && ambient_xfer_coeff_fan0 + fan255_adjustment > 0
+          &&  (ambient_xfer_coeff_fan0 + MAX(fan255_adjustment, 0.0f)) * (PID_dT) < block_heat_capacity
+          &&  filament_heat_capacity_permm >= 0;
+    }
+
+    float ambient() { return ambient_temp; }
+
+    void set_ambient(const float temp) { ambient_temp = temp; }
+
+    /**
+     * Return the PWM (0 - Max) for the next PID_SAMPLE_TIME
+     *  fan_speed: part fan speed 0 - 255
+     *  e_rate:    filament feed in mm/s
+     */
+    uint8_t compute(const float target_temp, const float current_temp, const uint8_t Max, const uint8_t fan_speed, const float e_rate) {
+
+      // Restart the model from the measurement, keeping the ambient learned so far
+      if (!initialized) {
+        block_temp = sensor_temp = current_temp;
+        if (ambient_temp <= 0.0f) ambient_temp = MIN(current_temp, float(MPC_AMBIENT_TEMP));
+        last_power = 0.0;
+        initialized = true;
+      }
+
+      const float max_power = heater_power * Max * (1.0f / 255.0f);
+
+      const float ambient_xfer_coeff  = ambient_xfer_coeff_fan0 + fan255_adjustment * fan_speed * (1.0f / 255.0f),
+                  flow_xfer_coeff     = filament_heat_capacity_permm * MAX(e_rate, 0.0f);
+
+      // Advance the model with the power applied during the last sample
+      const float blocktempdelta  = (last_power - (block_temp - ambient_temp) * (ambient_xfer_coeff + flow_xfer_coeff)) * (PID_dT) / block_heat_capacity;
+      block_temp += blocktempdelta;
+      sensor_temp += (block_temp - sensor_temp) * sensor_responsiveness * (PID_dT);
+
+      // Pull the model towards the measurement. A slow error is wrong ambient, so correct it near steady state
+      const float delta_to_apply = (current_temp - sensor_temp) * (MPC_SMOOTHING_FACTOR);
+      block_temp += delta_to_apply;
+      sensor_temp += delta_to_apply;
+      if ((last_power > 0 && last_power < max_power) || ABS(blocktempdelta + delta_to_apply) < (MPC_STEADYSTATE) * (PID_dT)) {
+        const float min_change = (MPC_MIN_AMBIENT_CHANGE) * (PID_dT);
+        ambient_temp += delta_to_apply > 0 ? MAX(delta_to_apply, min_change) : MIN(delta_to_apply, -min_change);
+      }
+
+      // Power to reach the target within the horizon, and to hold it against the losses
+      float power = 0.0;
+      if (target_temp > 0) {
+        power = (target_temp - block_temp) * block_heat_capacity * (1.0f / MPC_HORIZON)
+              + (target_temp - ambient_temp) * (ambient_xfer_coeff + flow_xfer_coeff);
+        LIMIT(power, 0.0f, max_power);
+      }
+      last_power = power;
+
+      return uint8_t(power * 255.0f / heater_power + 0.5f);
+    }
+
+    /**
+     * The output applied was cut below the computed one, i.e. by the power budget.
+     * The model is advanced with the power really applied.
+     */
+    void limit_output(const uint8_t output) {
+      NOMORE(last_power, heater_power * output * (1.0f / 255.0f));
+    }
+
+};
+
+#endif // ENABLED(MPC_TEMP)
@@ -25,11 +25,9 @@
  * pid.h - pid object
  */
 
-#if ENABLED(PID_ADD_EXTRUSION_RATE)
-  static long last_e_position   = 0,
-              lpq[LPQ_MAX_LEN]  = { 0 };
-  static int  lpq_ptr           = 0;
-#endif
+// compute() is called by TempManager::spin(), at a fixed 100ms rate
+#define PID_SAMPLE_TIME 100
+#define PID_dT          (PID_SAMPLE_TIME * 0.001f)
 
 struct pid_data_t {
 
@@ -43,55 +41,61 @@ struct pid_data_t {
 
     float iState_sum  = 0.0,
           pid_output  = 0.0,
-          last_temp   = 0.0;
+          last_temp   = 0.0,
+          dInput_sum  = 0.0;
 
-    short_timer_t next_sample_ms;
+    bool  limited     = false;
 
   public: /** Public Function */
 
-    void init() { next_sample_ms.start(); }
+    void init() { reset(); }
 
-    void reset() { iState_sum = pid_output = 0.0; }
+    void reset() { iState_sum = pid_output = dInput_sum = 0.0; limited = false; }
 
+    /**
+     * The output applied was cut below the computed one, i.e. by the power budget.
+     * Until the next compute the integrator is held as if the output was saturated.
+     */
+    void limit_output(const uint8_t output) {
+      if (output < pid_output) {
+        pid_output = output;
+        limited = true;
+      }
+    }
+
+    /**
+     * Kp, Ki and Kd keep their per second units, the sample time is folded in here.
+     * Proportional and derivative act on the measurement, so a target change does not kick the output.
+     */
     float compute(const float target_temp, const float current_temp
       #if ENABLED(PID_ADD_EXTRUSION_RATE)
-        , const uint8_t tid, const int16_t lpq_len=0
+        , const float e_rate=0.0f
       #endif
     ) {
 
-      // Check every second
-      if (next_sample_ms.expired(SECOND_TO_MILLIS(1))) {
-
-        const float pid_error = target_temp - current_temp,
-                    dInput    = current_temp - last_temp,
-                    dTerm     = Kd * dInput;
-
-        // Compute PID output
-        iState_sum += Ki * pid_error;
-        iState_sum -= Kp * dInput;
-        LIMIT(iState_sum, drive.min, drive.max);
-        pid_output = iState_sum - dTerm;
-
-        #if ENABLED(PID_ADD_EXTRUSION_RATE)
-          if (tid == toolManager.active_hotend()) {
-            const long e_position = stepper.position(E_AXIS);
-            if (e_position > last_e_position) {
-              lpq[lpq_ptr] = e_position - last_e_position;
-              last_e_position = e_position;
-            }
-            else {
-              lpq[lpq_ptr] = 0;
-            }
-            if (++lpq_ptr >= lpq_len) lpq_ptr = 0;
-            pid_output += (lpq[lpq_ptr] * extruders[toolManager.extruder.active]->steps_to_mm) * Kc;
-          }
-        #endif // PID_ADD_EXTRUSION_RATE
-
-        LIMIT(pid_output, 0, Max);
-
-        last_temp = current_temp;
+      const float pid_error = target_temp - current_temp,
+                  dInput    = current_temp - last_temp;
 
-      }
+      // Low pass filter of the temperature slope, the raw difference at 10Hz is mostly ADC noise
+      dInput_sum += (dInput * (1.0f / (PID_dT)) - dInput_sum) * (PID_DERIVATIVE_FILTER);
+
+      // Anti-windup: stop integrating the error while the output is saturated or cut in its direction
+      iState_sum -= Kp * dInput;
+      if (!((pid_error > 0 && (pid_output >= drive.max || limited)) || (pid_error < 0 && pid_output <= drive.min)))
+        iState_sum += Ki * (PID_dT) * pid_error;
+      LIMIT(iState_sum, drive.min, drive.max);
+      limited = false;
+
+      pid_output = iState_sum - Kd * dInput_sum;
+
+      // Feed-forward of the power needed to melt the filament about to be extruded
+      #if ENABLED(PID_ADD_EXTRUSION_RATE)
+        pid_output += e_rate * Kc;
+      #endif
+
+      LIMIT(pid_output, 0, Max);
+
+      last_temp = current_temp;
 
       return pid_output;
     }
@@ -0,0 +1,115 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * runaway.h - Model based thermal runaway detector
+ *
+ * The thermal model of the MPC predicts every sample the temperature the
+ * sensor should read from the PWM applied, the part fan and the flow.
+ * The model then follows the measurement halfway, so a wrong loss estimate
+ * fades out while a missing or stuck heater keeps pulling it away. Errors are
+ * scaled by their standard deviation, learned on the way, and summed on both
+ * sides (CUSUM): noise and a slightly wrong model cancel out, a heater that
+ * does not heat, a heater that cannot be switched off or a sensor out of the
+ * block add up in a few seconds.
+ *
+ * It only runs while the heater holds the target, and there it replaces the
+ * hysteresis check: a part fan or a flow that pulls the temperature down is in
+ * the model, a heater that cannot hold the target is not. During a heat-up a
+ * heater weaker than the model lags it by more than the drift allows, so that
+ * part is left to the watch period.
+ */
+
+#if ENABLED(THERMAL_PROTECTION_MODEL)
+
+#define RUNAWAY_START_SIGMA   1.0f  // (C) Deviation before any has been learned
+#define RUNAWAY_MIN_SIGMA     0.1f  // (C) Never trust the sensor more than this
+#define RUNAWAY_DRIFT         0.5f  // Error (in deviations) taken as model mismatch
+#define RUNAWAY_CLIP          4.0f  // Error (in deviations) counted at most for each sample
+#define RUNAWAY_SMOOTHING     0.5f  // How much of the error the model follows each sample
+#define RUNAWAY_LEARN_RATE  (1.0f / 128.0f)
+
+struct runaway_model_t {
+
+  private: /** Private Parameters */
+
+    float block_temp  = 0.0,
+          sensor_temp = 0.0,
+          variance    = 0.0,
+          sum_high    = 0.0,
+          sum_low     = 0.0;
+
+    bool  initialized = false;
+
+  public: /** Public Function */
+
+    void init() { initialized = false; }
+
+    float deviation() { return MAX(sum_high, sum_low); }
+
+    /**
+     * Advance the model with the PWM applied during the last sample.
+     * Return true when the measurement is out of the model by more than limit.
+     *  fan_speed: part fan speed 0 - 255
+     *  e_rate:    filament feed in mm/s
+     */
+    bool check(mpc_data_t &mpc, const float current_temp, const uint8_t pwm, const uint8_t fan_speed, const float e_rate, const float limit) {
+
+      if (!initialized) {
+        block_temp = sensor_temp = current_temp;
+        variance = sq(RUNAWAY_START_SIGMA);
+        sum_high = sum_low = 0.0;
+        initialized = true;
+        return false;
+      }
+
+      const float ambient_temp  = mpc.ambient() > 0.0f ? mpc.ambient() : float(MPC_AMBIENT_TEMP),
+                  power         = mpc.heater_power * pwm * (1.0f / 255.0f),
+                  xfer_coeff    = mpc.ambient_xfer_coeff_fan0 + mpc.fan255_adjustment * fan_speed * (1.0f / 255.0f)
+                                + mpc.filament_heat_capacity_permm * MAX(e_rate, 0.0f);
+
+      // Predict this sample
+      block_temp += (power - (block_temp - ambient_temp) * xfer_coeff) * (PID_dT) / mpc.block_heat_capacity;
+      sensor_temp += (block_temp - sensor_temp) * mpc.sensor_responsiveness * (PID_dT);
+
+      // Then follow the measurement
+      const float error = current_temp - sensor_temp;
+      block_temp  += error * (RUNAWAY_SMOOTHING);
+      sensor_temp += error * (RUNAWAY_SMOOTHING);
+
+      const float sigma = SQRT(variance);
+      const float z = constrain(error / sigma, -(RUNAWAY_CLIP), RUNAWAY_CLIP);
+
+      sum_high = MAX(sum_high + z - (RUNAWAY_DRIFT), 0.0f);
+      sum_low  = MAX(sum_low  - z - (RUNAWAY_DRIFT), 0.0f);
+
+      // Learn the noise, a clipped error can only grow it slowly
+      variance += (sq(z * sigma) - variance) * (RUNAWAY_LEARN_RATE);
+      NOLESS(variance, sq(RUNAWAY_MIN_SIGMA));
+
+      return deviation() > limit;
+    }
+
+};
+
+#endif // ENABLED(THERMAL_PROTECTION_MODEL)
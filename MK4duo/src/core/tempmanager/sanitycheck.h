@@ -311,3 +311,37 @@
     , "DEPENDENCY ERROR: only one DHT sensor is supported!"
   );
 #endif
+
+// Heat-up scheduler
+#if ENABLED(HEATUP_POWER_BUDGET)
+  #if !defined(HEATUP_HOTEND_WATTS) || !defined(HEATUP_BED_WATTS) || !defined(HEATUP_CHAMBER_WATTS)
+    #error "DEPENDENCY ERROR: Missing setting HEATUP_HOTEND_WATTS, HEATUP_BED_WATTS or HEATUP_CHAMBER_WATTS."
+  #endif
+#endif
+
+// MPC
+#if ENABLED(MPC_TEMP)
+  #if !defined(MPC_HEATER_POWER) || !defined(MPC_BLOCK_HEAT_CAPACITY) || !defined(MPC_SENSOR_RESPONSIVENESS)
+    #error "DEPENDENCY ERROR: Missing setting MPC_HEATER_POWER, MPC_BLOCK_HEAT_CAPACITY or MPC_SENSOR_RESPONSIVENESS."
+  #endif
+  #if !defined(MPC_AMBIENT_XFER_COEFF) || !defined(MPC_AMBIENT_XFER_COEFF_FAN255) || !defined(MPC_FILAMENT_HEAT_CAPACITY_PERMM)
+    #error "DEPENDENCY ERROR: Missing setting MPC_AMBIENT_XFER_COEFF, MPC_AMBIENT_XFER_COEFF_FAN255 or MPC_FILAMENT_HEAT_CAPACITY_PERMM."
+  #endif
+  #if !defined(MPC_SMOOTHING_FACTOR) || !defined(MPC_MIN_AMBIENT_CHANGE) || !defined(MPC_STEADYSTATE)
+    #error "DEPENDENCY ERROR: Missing setting MPC_SMOOTHING_FACTOR, MPC_MIN_AMBIENT_CHANGE or MPC_STEADYSTATE."
+  #endif
+  #if !PIDTEMP
+    #error "DEPENDENCY ERROR: MPC_TEMP replaces the hotend PID, PIDTEMP must be true."
+  #endif
+#endif
+
+// Thermal protection model
+#if ENABLED(THERMAL_PROTECTION_MODEL)
+  #if DISABLED(MPC_TEMP)
+    #error "DEPENDENCY ERROR: THERMAL_PROTECTION_MODEL requires MPC_TEMP."
+  #elif DISABLED(THERMAL_PROTECTION_MODEL_LIMIT)
+    #error "DEPENDENCY ERROR: Missing setting THERMAL_PROTECTION_MODEL_LIMIT."
+  #elif !THERMAL_PROTECTION_HOTENDS
+    #error "DEPENDENCY ERROR: THERMAL_PROTECTION_MODEL requires THERMAL_PROTECTION_HOTENDS."
+  #endif
+#endif
@@ -0,0 +1,121 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sensor_table.h - ADC to temperature lookup table
+ *
+ * The table holds the ADC value of a thermistor every SENSOR_TABLE_TEMP_STEP
+ * degrees, generated from the M305 parameters. It is rebuilt whenever those
+ * change, so reading a temperature is a short bisection plus one linear
+ * interpolation instead of a logarithm and the Steinhart-Hart polynomial.
+ * Values outside the table fall back to the exact formula.
+ */
+
+#define SENSOR_TABLE_TEMP_MIN   -20
+#define SENSOR_TABLE_TEMP_STEP   10
+#define SENSOR_TABLE_SIZE        46   // -20°C to 430°C
+
+// ADC values are stored in fixed point to keep the resolution of the hot end of the curve
+#define SENSOR_TABLE_SCALE      ((AD_RANGE) < 32768 ? 32768 / (AD_RANGE) : 1)
+
+struct sensor_table_t {
+
+  public: /** Public Parameters */
+
+    bool      valid;
+    uint16_t  adc[SENSOR_TABLE_SIZE];   // Decreasing with temperature
+
+  public: /** Public Function */
+
+    void build(const sensor_data_t &sensor) {
+
+      valid = false;
+
+      #if !HAS_VREF_MONITOR
+        if (!WITHIN(sensor.type, 1, 9) || sensor.shB <= 0.0f) return;
+
+        const float adc_low = 2 * sensor.adc_low_offset,
+                    adc_max = AD_RANGE + (2 * sensor.adc_high_offset);
+
+        LOOP_L_N(i, SENSOR_TABLE_SIZE) {
+
+          // Start from the Beta solution and refine the Steinhart-Hart cubic with Newton's method
+          const float recipT = 1.0f / (SENSOR_TABLE_TEMP_MIN + i * SENSOR_TABLE_TEMP_STEP - (ABS_ZERO));
+          float logR = (recipT - sensor.shA) / sensor.shB;
+          for (uint8_t n = 0; n < 4 && sensor.shC != 0.0f; n++) {
+            const float f  = sensor.shA + sensor.shB * logR + sensor.shC * logR * logR * logR - recipT,
+                        df = sensor.shB + 3.0f * sensor.shC * logR * logR;
+            if (df <= 0.0f) return;
+            logR -= f / df;
+          }
+
+          // Inverse of the resistance computed by sensor_data_t::getTemperature
+          const float resistance = EXP(logR),
+                      adc_value  = (resistance * (adc_max - 0.5f) + sensor.pullup_res * (adc_low - 0.5f)) / (resistance + sensor.pullup_res),
+                      scaled     = adc_value * (SENSOR_TABLE_SCALE);
+
+          if (!WITHIN(scaled, 0.0f, 65535.0f)) return;
+          adc[i] = uint16_t(scaled + 0.5f);
+          if (i && adc[i] > adc[i - 1]) return;
+        }
+
+        valid = true;
+      #else
+        UNUSED(sensor);
+      #endif
+    }
+
+    // Return false when the reading is outside the table
+    FORCE_INLINE bool lookup(const int16_t adc_raw, float &temp) const {
+
+      if (!valid) return false;
+
+      const int32_t raw = int32_t(adc_raw) * (SENSOR_TABLE_SCALE);
+      if (raw > adc[0] || raw < adc[SENSOR_TABLE_SIZE - 1]) return false;
+
+      // Bisect for adc[lo] >= raw >= adc[hi]
+      uint8_t lo = 0, hi = SENSOR_TABLE_SIZE - 1;
+      while (hi - lo > 1) {
+        const uint8_t mid = (lo + hi) >> 1;
+        if (raw > adc[mid]) hi = mid; else lo = mid;
+      }
+
+      const int32_t span = int32_t(adc[lo]) - adc[hi];
+      temp = SENSOR_TABLE_TEMP_MIN + SENSOR_TABLE_TEMP_STEP * (lo + (span ? float(int32_t(adc[lo]) - raw) / span : 0.0f));
+      return true;
+    }
+
+    // ADC reading of a temperature, false when it is outside the table
+    FORCE_INLINE bool reverse(const float temp, int16_t &adc_raw) const {
+
+      if (!valid) return false;
+
+      const float pos = (temp - (SENSOR_TABLE_TEMP_MIN)) * (1.0f / (SENSOR_TABLE_TEMP_STEP));
+      if (!WITHIN(pos, 0.0f, float(SENSOR_TABLE_SIZE - 1))) return false;
+
+      const uint8_t i = MIN(uint8_t(pos), SENSOR_TABLE_SIZE - 2);
+      adc_raw = LROUND((adc[i] + (pos - i) * (float(adc[i + 1]) - adc[i])) * (1.0f / (SENSOR_TABLE_SCALE)));
+      return true;
+    }
+
+};
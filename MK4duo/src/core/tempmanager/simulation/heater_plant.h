@@ -0,0 +1,139 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * heater_plant.h - Thermal plant of a simulated heater and step response metrics
+ *
+ * Only plain C++, so that the host tests in buildroot/test run the same
+ * plant and metrics as M309, with the PID and MPC controllers.
+ */
+
+#if ENABLED(HEATER_SIMULATION)
+
+#define SIM_AMBIENT_TEMP  25.0f // (C) Ambient temperature of the plants
+#define SIM_SETTLE_BAND    1.0f // (C) Step response is settled within this band
+
+//                          Power   Capacity  Loss    Fan loss  Sensor
+//                          (W)     (J/K)     (W/K)   (W/K)     (1/s)
+#define SIM_HOTEND_PLANT  {  40.0,    16.7,   0.068,  0.03,     0.22 }
+#define SIM_BED_PLANT     { 240.0,   600.0,   1.6,    0.0,      0.1  }
+#define SIM_CHAMBER_PLANT { 200.0,  8000.0,   4.0,    0.0,      0.05 }
+#define SIM_COOLER_PLANT  { -40.0,   200.0,   2.0,    0.0,      0.2  }
+
+enum SimFaultEnum : uint8_t { SIM_FAULT_NONE, SIM_FAULT_HEATER, SIM_FAULT_SENSOR_DETACHED, SIM_FAULT_SENSOR_OPEN };
+
+struct heater_plant_t {
+
+  public: /** Public Parameters */
+
+    float         power,            // (W)    Heater power at full PWM, negative to pump heat out
+                  heat_capacity,    // (J/K)  Heat capacity of the heated mass
+                  loss_coeff,       // (W/K)  Heat loss to ambient
+                  fan_loss_coeff,   // (W/K)  Extra heat loss with the part fan at 255
+                  responsiveness,   // (1/s)  Sensor lag behind the block
+                  block_temp,
+                  sensor_temp;
+
+    SimFaultEnum  fault;
+
+  public: /** Public Function */
+
+    void init(const float model[5]) {
+      power           = model[0];
+      heat_capacity   = model[1];
+      loss_coeff      = model[2];
+      fan_loss_coeff  = model[3];
+      responsiveness  = model[4];
+      fault           = SIM_FAULT_NONE;
+      reset();
+    }
+
+    FORCE_INLINE void reset() { block_temp = sensor_temp = SIM_AMBIENT_TEMP; }
+
+    void update(const float dt, const uint8_t pwm, const uint8_t fan_speed) {
+      const float heat = fault == SIM_FAULT_HEATER ? 0.0f : power * pwm * (1.0f / 255.0f),
+                  loss = (loss_coeff + fan_loss_coeff * fan_speed * (1.0f / 255.0f)) * (block_temp - SIM_AMBIENT_TEMP);
+      block_temp += (heat - loss) * dt / heat_capacity;
+      // A detached sensor drifts to ambient
+      sensor_temp += ((fault == SIM_FAULT_SENSOR_DETACHED ? SIM_AMBIENT_TEMP : block_temp) - sensor_temp) * responsiveness * dt;
+    }
+
+};
+
+/**
+ * Rise time (10% to 90%), overshoot, settling time and mean error over
+ * the last tenth of a step response, fed with one temperature per sample
+ */
+struct step_metrics_t {
+
+  public: /** Public Parameters */
+
+    float     start,
+              target,
+              dt,
+              rise_10,
+              rise_90,
+              settle_time,
+              max_progress,
+              error_sum;
+
+    uint32_t  steps,
+              samples;
+
+    uint16_t  error_count;
+
+  public: /** Public Function */
+
+    void init(const float start_temp, const float target_temp, const float sample_time, const uint32_t total_steps) {
+      start = start_temp;
+      target = target_temp;
+      dt = sample_time;
+      steps = total_steps;
+      rise_10 = rise_90 = -1.0f;
+      settle_time = max_progress = error_sum = 0.0f;
+      samples = 0;
+      error_count = 0;
+    }
+
+    void add(const float temp) {
+      const float time      = (++samples) * dt,
+                  progress  = (temp - start) / (target - start);
+      if (rise_10 < 0.0f && progress >= 0.1f) rise_10 = time;
+      if (rise_90 < 0.0f && progress >= 0.9f) rise_90 = time;
+      NOLESS(max_progress, progress);
+      if (ABS(temp - target) > SIM_SETTLE_BAND) settle_time = time;
+      if (samples > steps - steps / 10) {
+        error_sum += temp - target;
+        error_count++;
+      }
+    }
+
+    FORCE_INLINE bool   reached()     { return rise_90 >= 0.0f; }
+    FORCE_INLINE bool   settled()     { return settle_time < samples * dt; }
+    FORCE_INLINE float  rise_time()   { return rise_90 - MAX(rise_10, 0.0f); }
+    FORCE_INLINE float  overshoot()   { return MAX(max_progress - 1.0f, 0.0f) * ABS(target - start); }
+    FORCE_INLINE float  final_error() { return error_count ? error_sum / error_count : 0.0f; }
+
+};
+
+#endif // ENABLED(HEATER_SIMULATION)
@@ -0,0 +1,179 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * simulation.cpp - Simulated thermal plants for the heaters
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(HEATER_SIMULATION)
+
+HeaterSimulation heaterSim;
+
+/** Public Parameters */
+heater_plant_t HeaterSimulation::plant[SIM_HEATERS];
+
+Heater* volatile HeaterSimulation::running = nullptr;
+
+/** Public Function */
+void HeaterSimulation::init() {
+  const float hotend_plant[]  = SIM_HOTEND_PLANT,
+              bed_plant[]     = SIM_BED_PLANT,
+              chamber_plant[] = SIM_CHAMBER_PLANT,
+              cooler_plant[]  = SIM_COOLER_PLANT;
+  for (uint8_t i = 0; i < SIM_HEATERS; i++) {
+    plant[i].init(
+        i < (MAX_HOTEND)                                ? hotend_plant
+      : i < (MAX_HOTEND) + (MAX_BED)                    ? bed_plant
+      : i < (MAX_HOTEND) + (MAX_BED) + (MAX_CHAMBER)    ? chamber_plant
+      :                                                   cooler_plant
+    );
+  }
+  running = nullptr;
+}
+
+void HeaterSimulation::spin() {
+  #if HAS_HOTENDS
+    LOOP_HOTEND() if (hotends[h] != running) get_plant(hotends[h]).update(PID_dT, hotends[h]->pwm_value, fan_speed(hotends[h]));
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() if (beds[h] != running) get_plant(beds[h]).update(PID_dT, beds[h]->pwm_value, 0);
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() if (chambers[h] != running) get_plant(chambers[h]).update(PID_dT, chambers[h]->pwm_value, 0);
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() if (coolers[h] != running) get_plant(coolers[h]).update(PID_dT, coolers[h]->pwm_value, 0);
+  #endif
+}
+
+void HeaterSimulation::read_sensor(Heater* act) {
+
+  const heater_plant_t &p = get_plant(act);
+
+  if (act->sensor_table.valid) {
+    int16_t raw;
+    // An open thermistor reads the top of the ADC range
+    if (p.fault == SIM_FAULT_SENSOR_OPEN)
+      raw = AD_RANGE - 1;
+    else if (!act->sensor_table.reverse(p.sensor_temp, raw)) {
+      act->current_temperature = p.sensor_temp;
+      return;
+    }
+    // The ADC interrupt keeps writing adc_raw, so the lookup takes the simulated reading directly
+    act->data.sensor.adc_raw = raw;
+    if (!act->sensor_table.lookup(raw, act->current_temperature))
+      act->current_temperature = act->data.sensor.getTemperature();
+    return;
+  }
+
+  act->current_temperature = p.fault == SIM_FAULT_SENSOR_OPEN ? act->data.temp.min - 10 : p.sensor_temp;
+}
+
+void HeaterSimulation::step_response(Heater* act, const int16_t target, const uint16_t seconds) {
+
+  heater_plant_t &p = get_plant(act);
+
+  const int16_t   old_target  = act->target_temperature;
+  const uint32_t  steps       = uint32_t(seconds) * 1000UL / (PID_SAMPLE_TIME);
+
+  step_metrics_t metrics;
+  metrics.init(SIM_AMBIENT_TEMP, target, PID_dT, steps);
+
+  // From here TempManager::spin() leaves the heater alone
+  running = act;
+  p.reset();
+  act->data.pid.reset();
+  #if ENABLED(MPC_TEMP)
+    act->data.mpc.init();
+  #endif
+  act->target_temperature = target;
+  act->setActive(true);
+
+  for (uint32_t i = 0; i < steps; i++) {
+
+    p.update(PID_dT, act->pwm_value, fan_speed(act));
+    act->update_current_temperature();
+    act->get_output();
+    metrics.add(act->current_temperature);
+
+    if (!(i % 100)) printer.idle();
+  }
+
+  act->SwitchOff();
+  p.reset();
+  running = nullptr;
+  if (old_target) act->set_target_temp(old_target);
+
+  SERIAL_SMV(ECHO, "Simulation step ", metrics.start, 1);
+  SERIAL_MV(" -> ", target);
+  if (!metrics.reached()) {
+    SERIAL_EM(" target not reached");
+    return;
+  }
+  SERIAL_MV(" rise(s):", metrics.rise_time(), 1);
+  SERIAL_MV(" overshoot(C):", metrics.overshoot(), 2);
+  if (!metrics.settled())
+    SERIAL_MSG(" not settled");
+  else
+    SERIAL_MV(" settle(s):", metrics.settle_time, 1);
+  SERIAL_EMV(" error(C):", metrics.final_error(), 3);
+
+}
+
+heater_plant_t& HeaterSimulation::get_plant(const Heater* act) {
+  uint8_t i = act->data.ID;
+  switch (act->type) {
+    case IS_BED:      i += (MAX_HOTEND); break;
+    case IS_CHAMBER:  i += (MAX_HOTEND) + (MAX_BED); break;
+    case IS_COOLER:   i += (MAX_HOTEND) + (MAX_BED) + (MAX_CHAMBER); break;
+    default: break;
+  }
+  return plant[i];
+}
+
+void HeaterSimulation::print_M309(Heater* act) {
+  const heater_plant_t &p = get_plant(act);
+  const int8_t heater_id = act->type == IS_HOTEND ? act->data.ID : -act->type;
+  SERIAL_SMV(ECHO, "  M309 H", int(heater_id));
+  if (heater_id < 0) SERIAL_MV(" T", int(act->data.ID));
+  SERIAL_MV(" P", p.power, 2);
+  SERIAL_MV(" C", p.heat_capacity, 2);
+  SERIAL_MV(" K", p.loss_coeff, 4);
+  SERIAL_MV(" A", p.fan_loss_coeff, 4);
+  SERIAL_MV(" R", p.responsiveness, 4);
+  SERIAL_MV(" F", int(p.fault));
+  SERIAL_EMV(" ; Sensor temp:", p.sensor_temp, 2);
+}
+
+/** Private Function */
+uint8_t HeaterSimulation::fan_speed(const Heater* act) {
+  #if HAS_FAN
+    if (act->type == IS_HOTEND) return fans[0]->actual_speed();
+  #else
+    UNUSED(act);
+  #endif
+  return 0;
+}
+
+#endif // ENABLED(HEATER_SIMULATION)
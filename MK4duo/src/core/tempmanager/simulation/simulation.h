@@ -0,0 +1,87 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * simulation.h - Simulated thermal plants for the heaters
+ *
+ * Each heater drives a model in place of the real hardware: a block with
+ * heat capacity C heated by the heater power (negative for a Peltier cooler)
+ * and losing heat to ambient, plus a sensor following the block with a first
+ * order lag. The sensor temperature is turned into the ADC reading of the
+ * configured thermistor, so the whole sensor path, the controllers and the
+ * thermal protection run as on the printer while the heater pins stay off.
+ * Faults can be injected, and M309 runs a step response in accelerated time.
+ */
+
+#if ENABLED(HEATER_SIMULATION)
+
+#define SIM_HEATERS       ((MAX_HOTEND) + (MAX_BED) + (MAX_CHAMBER) + (MAX_COOLER))
+
+class HeaterSimulation {
+
+  public: /** Constructor */
+
+    HeaterSimulation() {}
+
+  public: /** Public Parameters */
+
+    static heater_plant_t plant[SIM_HEATERS];
+
+    static Heater* volatile running;  // Heater in an accelerated step response, left out of TempManager::spin()
+
+  public: /** Public Function */
+
+    /**
+     * Set the default plant of each heater
+     */
+    static void init();
+
+    /**
+     * Advance the plants by one temperature cycle, called from TempManager::spin()
+     */
+    static void spin();
+
+    /**
+     * Set the heater temperature from the plant sensor, through the ADC table if there is one
+     */
+    static void read_sensor(Heater* act);
+
+    /**
+     * Run the heater controller against a plant starting at ambient, as fast as
+     * possible, and report rise time, overshoot, settling time and final error
+     */
+    static void step_response(Heater* act, const int16_t target, const uint16_t seconds);
+
+    static heater_plant_t& get_plant(const Heater* act);
+
+    static void print_M309(Heater* act);
+
+  private: /** Private Function */
+
+    static uint8_t fan_speed(const Heater* act);
+
+};
+
+extern HeaterSimulation heaterSim;
+
+#endif // ENABLED(HEATER_SIMULATION)
@@ -27,6 +27,13 @@
 #include "../../../MK4duo.h"
 #include "sanitycheck.h"
 
+// A heater in an M309 step response is run by the step response alone
+#if ENABLED(HEATER_SIMULATION)
+  #define SKIP_SIM_RUNNING(H) if (heaterSim.running == H) continue
+#else
+  #define SKIP_SIM_RUNNING(H) NOOP
+#endif
+
 TempManager tempManager;
 
 /** Public Parameters */
@@ -69,6 +76,10 @@ void TempManager::init() {
     paused = false;
   #endif
 
+  #if ENABLED(HEATER_SIMULATION)
+    heaterSim.init();
+  #endif
+
   #if HAS_HOTENDS
     LOOP_HOTEND()   hotends[h]->init();
   #endif
@@ -262,8 +273,13 @@ void TempManager::spin() {
     if (emergency_parser.killed_by_M112) printer.kill(PSTR("M112"));
   #endif
 
+  #if ENABLED(HEATER_SIMULATION)
+    heaterSim.spin();
+  #endif
+
   #if HAS_HOTENDS
     LOOP_HOTEND() {
+      SKIP_SIM_RUNNING(hotends[h]);
       // Update Current TempManager
       hotends[h]->update_current_temperature();
       hotends[h]->check_and_power();
@@ -272,6 +288,7 @@ void TempManager::spin() {
 
   #if HAS_BEDS
     LOOP_BED() {
+      SKIP_SIM_RUNNING(beds[h]);
       // Update Current TempManager
       beds[h]->update_current_temperature();
       beds[h]->check_and_power();
@@ -280,6 +297,7 @@ void TempManager::spin() {
 
   #if HAS_CHAMBERS
     LOOP_CHAMBER() {
+      SKIP_SIM_RUNNING(chambers[h]);
       // Update Current TempManager
       chambers[h]->update_current_temperature();
       chambers[h]->check_and_power();
@@ -288,12 +306,24 @@ void TempManager::spin() {
 
   #if HAS_COOLERS
     LOOP_COOLER() {
+      SKIP_SIM_RUNNING(coolers[h]);
       // Update Current TempManager
       coolers[h]->update_current_temperature();
       coolers[h]->check_and_power();
     } // LOOP_COOLER
   #endif
 
+  #if ENABLED(HEATUP_POWER_BUDGET)
+    #if ENABLED(HEATER_SIMULATION)
+      if (!heaterSim.running)
+    #endif
+        heatup.spin();
+  #endif
+
+  #if ENABLED(TEMP_HISTORY)
+    tempHistory.spin();
+  #endif
+
   #if HAS_MCU_TEMPERATURE
     mcu_current_temperature = HAL::analog2tempMCU(mcu_current_temperature_raw);
     NOLESS(mcu_highest_temperature, mcu_current_temperature);
@@ -688,6 +718,23 @@ void TempManager::report_temperatures(const bool showRaw/*=false*/) {
     pid->drive.min        = POWER_DRIVE_MIN;
     pid->drive.max        = POWER_DRIVE_MAX;
     pid->Max              = POWER_MAX;
+    #if ENABLED(MPC_TEMP)
+      // Model
+      constexpr float MPC_P[]   = MPC_HEATER_POWER,
+                      MPC_C[]   = MPC_BLOCK_HEAT_CAPACITY,
+                      MPC_R[]   = MPC_SENSOR_RESPONSIVENESS,
+                      MPC_A[]   = MPC_AMBIENT_XFER_COEFF,
+                      MPC_F[]   = MPC_AMBIENT_XFER_COEFF_FAN255,
+                      MPC_E[]   = MPC_FILAMENT_HEAT_CAPACITY_PERMM;
+      mpc_data_t *mpc     = &heat->data.mpc;
+      mpc->heater_power                 = MPC_P[ALIM(h, MPC_P)];
+      mpc->block_heat_capacity          = MPC_C[ALIM(h, MPC_C)];
+      mpc->sensor_responsiveness        = MPC_R[ALIM(h, MPC_R)];
+      mpc->ambient_xfer_coeff_fan0      = MPC_A[ALIM(h, MPC_A)];
+      mpc->fan255_adjustment            = MPC_F[ALIM(h, MPC_F)] - mpc->ambient_xfer_coeff_fan0;
+      mpc->filament_heat_capacity_permm = MPC_E[ALIM(h, MPC_E)];
+      mpc->set_ambient(0);
+    #endif
     // Sensor
     sens->pin             = SE_pin[h];
     sens->type            = SE_type[h];
@@ -878,40 +925,28 @@ void TempManager::report_temperatures(const bool showRaw/*=false*/) {
 
 void TempManager::print_heater_state(Heater* act, const bool print_ID, const bool showRaw) {
 
-  SERIAL_CHR(' ');
-
-  #if HAS_HOTENDS
-    if (act->type == IS_HOTEND) {
-      SERIAL_CHR('T');
-      if (print_ID) SERIAL_VAL(act->data.ID);
-    }
-  #endif
+  char prefix = 'T';
 
   #if HAS_BEDS
-    if (act->type == IS_BED) {
-      SERIAL_CHR('B');
-      if (print_ID) SERIAL_VAL(act->data.ID);
-    }
+    if (act->type == IS_BED) prefix = 'B';
   #endif
 
   #if HAS_CHAMBERS
-    if (act->type == IS_CHAMBER) {
-      SERIAL_CHR('C');
-      if (print_ID) SERIAL_VAL(act->data.ID);
-    }
+    if (act->type == IS_CHAMBER) prefix = 'C';
   #endif
 
   #if HAS_COOLERS
-    if (act->type == IS_COOLER) SERIAL_CHR('W');
+    if (act->type == IS_COOLER) prefix = 'W';
   #endif
 
   const int16_t targetTemperature = act->isIdle() ? act->deg_idle() : act->deg_target();
-  SERIAL_CHR(':');
-  SERIAL_VAL(act->current_temperature);
-  SERIAL_MV(" /" , targetTemperature);
-  if (showRaw) {
-    SERIAL_MV(" (", act->data.sensor.adc_raw);
-    SERIAL_CHR(')');
-  }
+
+  // One write for the whole field
+  if (print_ID && prefix != 'W')
+    SERIAL_PRINTF(" %c%u:%.2f /%i", prefix, act->data.ID, act->current_temperature, targetTemperature);
+  else
+    SERIAL_PRINTF(" %c:%.2f /%i", prefix, act->current_temperature, targetTemperature);
+
+  if (showRaw) SERIAL_PRINTF(" (%i)", act->data.sensor.adc_raw);
 
 }
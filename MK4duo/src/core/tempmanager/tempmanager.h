@@ -23,8 +23,14 @@
 
 #include "dhtsensor/dhtsensor.h"
 #include "sensor/sensor.h"
+#include "sensor/sensor_table.h"
 #include "pid/pid.h"
+#include "mpc/mpc.h"
+#include "runaway/runaway.h"
 #include "heater/heater.h"
+#include "heatup/heatup.h"
+#include "simulation/heater_plant.h"
+#include "simulation/simulation.h"
 
 struct temp_data_t {
   uint8_t hotends   : 4;
@@ -124,6 +124,19 @@ void AutoBedLevel::extrapolate_unprobed_bed_level() {
   }
 }
 
+#if ENABLED(ADAPTIVE_MESH)
+
+  void AutoBedLevel::extend_probed_area(const xy_uint8_t &lo, const xy_uint8_t &hi) {
+    for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
+      for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+        if (WITHIN(x, lo.x, hi.x) && WITHIN(y, lo.y, hi.y)) continue;
+        data.z_values[x][y] = data.z_values[constrain(x, lo.x, hi.x)][constrain(y, lo.y, hi.y)];
+      }
+    }
+  }
+
+#endif
+
 void AutoBedLevel::print_bilinear_leveling_grid() {
   SERIAL_LM(ECHO, "Bilinear Leveling Grid:");
   bedlevel.print_2d_array(GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y, 3,
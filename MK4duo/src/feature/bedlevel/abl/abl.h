@@ -63,6 +63,15 @@ class AutoBedLevel {
      */
     static void extrapolate_unprobed_bed_level();
 
+    #if ENABLED(ADAPTIVE_MESH)
+      /**
+       * Fill in the points out of the probed area (adaptive mesh)
+       * with the nearest point of the area, so that the extrapolation
+       * only works inside the area that will be printed.
+       */
+      static void extend_probed_area(const xy_uint8_t &lo, const xy_uint8_t &hi);
+    #endif
+
     static void print_bilinear_leveling_grid();
 
     #if ENABLED(ABL_BILINEAR_SUBDIVISION)
@@ -93,6 +93,21 @@ static_assert(1 >= 0
   #error "DEPENDENCY ERROR: G26_MESH_VALIDATION requires MESH_BED_LEVELING, AUTO_BED_LEVELING_BILINEAR, or AUTO_BED_LEVELING_UBL."
 #endif
 
+/**
+ * Adaptive mesh requirements
+ */
+#if ENABLED(ADAPTIVE_MESH)
+  #if !ABL_GRID
+    #error "DEPENDENCY ERROR: ADAPTIVE_MESH requires AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR."
+  #elif !HAS_SD_SUPPORT
+    #error "DEPENDENCY ERROR: ADAPTIVE_MESH requires SDSUPPORT or USB_FLASH_DRIVE_SUPPORT."
+  #elif ENABLED(PROBE_MANUALLY)
+    #error "DEPENDENCY ERROR: ADAPTIVE_MESH does not support PROBE_MANUALLY."
+  #elif DISABLED(ADAPTIVE_MESH_MARGIN)
+    #error "DEPENDENCY ERROR: Missing setting ADAPTIVE_MESH_MARGIN."
+  #endif
+#endif
+
 #if ENABLED(MESH_EDIT_GFX_OVERLAY) && (DISABLED(AUTO_BED_LEVELING_UBL) || DISABLED(DOGLCD))
   #error "DEPENDENCY ERROR: MESH_EDIT_GFX_OVERLAY requires AUTO_BED_LEVELING_UBL and a Graphical LCD."
 #endif
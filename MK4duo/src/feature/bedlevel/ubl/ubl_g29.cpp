@@ -285,6 +285,11 @@
     bool probe_deployed = false;
     if (g29_parameter_parsing()) return; // Abort on parameter error
 
+    #if ENABLED(UBL_MESH_TEMP_BLEND)
+      // The active mesh is no longer a blend of the stored meshes
+      meshBlend.enable(false);
+    #endif
+
     const int8_t p_val = parser.intval('P', -1);
     const bool may_move = p_val == 1 || p_val == 2 || p_val == 4 || parser.seen('J');
 
@@ -591,7 +596,7 @@
         return;
       }
 
-      eeprom.load_mesh(g29_storage_slot);
+      if (!eeprom.load_mesh(g29_storage_slot)) return;
       storage_slot = g29_storage_slot;
 
       SERIAL_EM("Done.");
@@ -1744,7 +1749,7 @@
       g29_storage_slot = parser.value_int();
 
       float tmp_z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
-      eeprom.load_mesh(g29_storage_slot, &tmp_z_values);
+      if (!eeprom.load_mesh(g29_storage_slot, &tmp_z_values)) return;
 
       SERIAL_MV("Subtracting mesh in slot ", g29_storage_slot);
       SERIAL_EM(" from current mesh.");
@@ -40,6 +40,23 @@ uint8_t EmergencyParser::M876_response = 0;
 bool EmergencyParser::enabled = true;
 
 //Public Function
+void EmergencyParser::update(EmergencyStateEnum &state, const uint8_t *buf, size_t len) {
+
+  const uint8_t * const end = buf + len;
+
+  while (buf < end) {
+    if (state == EP_IGNORE) {
+      const uint8_t * const eol = (const uint8_t*)memchr(buf, '\n', end - buf);
+      if (!eol) return;
+      state = EP_RESET;
+      buf = eol + 1;
+    }
+    else
+      update(state, *buf++);
+  }
+
+}
+
 void EmergencyParser::update(EmergencyStateEnum &state, const uint8_t c) {
 
   switch (state) {
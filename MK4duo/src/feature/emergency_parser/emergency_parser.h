@@ -48,6 +48,13 @@ class EmergencyParser {
 
     static void update(EmergencyStateEnum &state, const uint8_t c);
 
+    /**
+     * Scan a chunk of received bytes, carrying the state across chunks.
+     * The rest of a line that can't be an emergency command is skipped
+     * with a single memchr, so most bytes are never looked at one by one.
+     */
+    static void update(EmergencyStateEnum &state, const uint8_t *buf, size_t len);
+
 };
 
 extern EmergencyParser emergency_parser;
@@ -0,0 +1,190 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * layer_time.cpp - Minimum layer time
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(LAYER_TIME_SCHEDULER)
+
+#define LAYER_TIME_MIN_HEIGHT   0.02  // (mm) Smaller Z changes are not a new layer
+#define LAYER_TIME_IDLE_TIME    10    // (s)  Planner empty time before restore
+
+LayerTime layerTime;
+
+/** Public Parameters */
+bool      LayerTime::enabled          = true;
+uint16_t  LayerTime::min_time         = MIN_LAYER_TIME,
+          LayerTime::fan_time         = LAYER_FAN_TIME;
+uint8_t   LayerTime::min_speed        = MIN_LAYER_SPEED,
+          LayerTime::fan_max_speed    = LAYER_FAN_MAX_SPEED;
+float     LayerTime::last_layer_time  = 0.0f;
+
+/** Private Parameters */
+float     LayerTime::layer_z          = 0.0f,
+          LayerTime::layer_time       = 0.0f,
+          LayerTime::speed_factor     = 1.0f;
+uint16_t  LayerTime::layer_count      = 0;
+int16_t   LayerTime::base_percentage  = 100,
+          LayerTime::applied_percentage = 100;
+
+#if HAS_FAN
+  uint8_t LayerTime::base_fan_speed     = 0,
+          LayerTime::applied_fan_speed  = 0;
+#endif
+
+/** Public Function */
+void LayerTime::add_block(const block_t * const block) {
+
+  if (!enabled) return;
+
+  sync_base();
+
+  // Time of the block at the speed asked by the G-code, without the slowdown
+  const float block_time = block->millimeters * speed_factor / SQRT(block->nominal_speed_sqr);
+
+  // A layer begins with the first extrusion at a different Z
+  const bool extruding = block->steps.e && !TEST(block->direction_bits, E_AXIS)
+                      && (block->steps.x || block->steps.y || block->steps.z);
+
+  if (extruding) {
+    const float z = mechanics.destination.z;
+    if (layer_count == 0 || z < layer_z - (LAYER_TIME_MIN_HEIGHT)) {
+      // First layer, or Z went down for a new print: only start to count
+      layer_z = z;
+      layer_time = 0.0f;
+      layer_count = 1;
+    }
+    else if (z > layer_z + (LAYER_TIME_MIN_HEIGHT)) {
+      layer_z = z;
+      last_layer_time = layer_time;
+      layer_time = 0.0f;
+      if (layer_count < 0xFFFF) layer_count++;
+      // The first layer includes the purge and the slowdown of the slicer, skip it
+      if (layer_count > 2) new_layer();
+    }
+  }
+
+  layer_time += block_time;
+
+}
+
+void LayerTime::idle() {
+  static short_timer_t idle_timer;
+
+  if (layer_count == 0 || planner.has_blocks_queued()) {
+    idle_timer.stop();
+    return;
+  }
+
+  if (!idle_timer.isRunning()) idle_timer.start();
+  else if (idle_timer.expired(SECOND_TO_MILLIS(LAYER_TIME_IDLE_TIME))) reset();
+}
+
+void LayerTime::reset() {
+  sync_base();
+  mechanics.feedrate_percentage = applied_percentage = base_percentage;
+  speed_factor = 1.0f;
+  #if HAS_FAN
+    if (LAYER_FAN < fanManager.data.fans && applied_fan_speed != base_fan_speed) {
+      fans[LAYER_FAN]->set_speed(base_fan_speed);
+      applied_fan_speed = fans[LAYER_FAN]->speed;
+    }
+  #endif
+  layer_count = 0;
+  layer_time = last_layer_time = 0.0f;
+}
+
+void LayerTime::enable(const bool onoff) {
+  if (enabled && !onoff) reset();
+  enabled = onoff;
+}
+
+void LayerTime::print_M157() {
+  SERIAL_SMV(ECHO, "  M157 S", int(enabled));
+  SERIAL_MV(" T", min_time);
+  SERIAL_MV(" P", int(min_speed));
+  SERIAL_MV(" F", fan_time);
+  SERIAL_MV(" X", int(fan_max_speed));
+  SERIAL_MV(" ; Layer:", layer_count);
+  SERIAL_MV(" Last time:", last_layer_time, 1);
+  SERIAL_EMV(" Speed:", mechanics.feedrate_percentage);
+}
+
+/** Private Function */
+
+/**
+ * A value different from the one set here was changed by M220 or M106,
+ * take it as the new base.
+ */
+void LayerTime::sync_base() {
+  if (mechanics.feedrate_percentage != applied_percentage) {
+    base_percentage = applied_percentage = mechanics.feedrate_percentage;
+    speed_factor = 1.0f;
+  }
+  #if HAS_FAN
+    if (LAYER_FAN < fanManager.data.fans && fans[LAYER_FAN]->speed != applied_fan_speed)
+      base_fan_speed = applied_fan_speed = fans[LAYER_FAN]->speed;
+  #endif
+}
+
+/**
+ * The next layer is expected to take as long as the last one.
+ * Stretch it to min_time lowering the feedrate percentage, and raise
+ * the fan from the speed of the slicer at fan_time to fan_max_speed
+ * at min_time.
+ */
+void LayerTime::new_layer() {
+
+  const float t = last_layer_time;
+  if (t <= 0.0f) return;
+
+  float factor = 1.0f;
+  if (t < min_time) factor = MAX(t / min_time, min_speed * 0.01f);
+
+  int16_t new_percentage = base_percentage * factor;
+  NOLESS(new_percentage, 1);
+  mechanics.feedrate_percentage = applied_percentage = new_percentage;
+  speed_factor = float(base_percentage) / new_percentage;
+
+  #if HAS_FAN
+    if (LAYER_FAN < fanManager.data.fans) {
+      uint8_t new_speed = base_fan_speed;
+      if (t < fan_time && fan_max_speed > base_fan_speed) {
+        const float ratio = fan_time > min_time ? (fan_time - t) / (fan_time - min_time) : 1.0f;
+        new_speed = base_fan_speed + (fan_max_speed - base_fan_speed) * MIN(ratio, 1.0f);
+      }
+      if (new_speed != applied_fan_speed) {
+        fans[LAYER_FAN]->set_speed(new_speed);
+        applied_fan_speed = fans[LAYER_FAN]->speed;
+      }
+    }
+  #endif
+
+}
+
+#endif // ENABLED(LAYER_TIME_SCHEDULER)
@@ -0,0 +1,100 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * layer_time.h - Minimum layer time
+ *
+ * The time of every layer is estimated from the blocks queued in the planner,
+ * as millimeters over nominal speed. A layer begins with the first extrusion
+ * at a higher Z. When the previous layer was shorter than the minimum layer
+ * time the feedrate percentage is lowered so the next layer takes as long,
+ * and the part fan is raised as the layer time falls.
+ */
+
+#if ENABLED(LAYER_TIME_SCHEDULER)
+
+class LayerTime {
+
+  public: /** Constructor */
+
+    LayerTime() {}
+
+  public: /** Public Parameters */
+
+    static bool     enabled;
+
+    static uint16_t min_time,       // (s) Layers shorter than this are slowed down
+                    fan_time;       // (s) Layers shorter than this get more fan
+
+    static uint8_t  min_speed,      // (%) Never slow down under this part of the speed
+                    fan_max_speed;  // Fan speed for layers of min_time or less
+
+    static float    last_layer_time;  // (s) Estimated time of the previous layer
+
+  private: /** Private Parameters */
+
+    static float    layer_z,        // (mm) Z of the extrusion of the current layer
+                    layer_time,     // (s) Estimated time queued for the current layer
+                    speed_factor;   // Feedrate slowdown applied to the current layer
+
+    static uint16_t layer_count;
+
+    static int16_t  base_percentage,
+                    applied_percentage;
+
+    #if HAS_FAN
+      static uint8_t  base_fan_speed,
+                      applied_fan_speed;
+    #endif
+
+  public: /** Public Function */
+
+    /**
+     * Add the time of a block just queued, called from Planner::buffer_steps()
+     */
+    static void add_block(const block_t * const block);
+
+    /**
+     * Restore speed and fan once the planner has been empty for a while
+     */
+    static void idle();
+
+    /**
+     * Restore speed and fan and start counting the layers again
+     */
+    static void reset();
+
+    static void enable(const bool onoff);
+
+    static void print_M157();
+
+  private: /** Private Function */
+
+    static void sync_base();
+    static void new_layer();
+
+};
+
+extern LayerTime layerTime;
+
+#endif // ENABLED(LAYER_TIME_SCHEDULER)
@@ -0,0 +1,40 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+// Layer time scheduler
+#if ENABLED(LAYER_TIME_SCHEDULER)
+  #if DISABLED(MIN_LAYER_TIME) || DISABLED(MIN_LAYER_SPEED) || DISABLED(LAYER_FAN_TIME) || DISABLED(LAYER_FAN_MAX_SPEED) || DISABLED(LAYER_FAN)
+    #error "DEPENDENCY ERROR: Missing setting MIN_LAYER_TIME, MIN_LAYER_SPEED, LAYER_FAN_TIME, LAYER_FAN_MAX_SPEED or LAYER_FAN."
+  #elif !WITHIN(MIN_LAYER_SPEED, 1, 100)
+    #error "DEPENDENCY ERROR: MIN_LAYER_SPEED must be between 1 and 100."
+  #endif
+  #if HAS_FAN && !WITHIN(LAYER_FAN, 0, MAX_FAN - 1)
+    #error "DEPENDENCY ERROR: LAYER_FAN must be a fan index."
+  #endif
+#endif
@@ -0,0 +1,166 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mesh_blend.cpp - Bed temperature mesh blending
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(UBL_MESH_TEMP_BLEND)
+
+#define MESH_BLEND_MIN_STEP   1.0   // (C) Meshes closer than this are the same temperature
+
+MeshBlend meshBlend;
+
+/** Public Parameters */
+bool          MeshBlend::enabled      = false;
+
+/** Private Parameters */
+mesh_temp_t   MeshBlend::meshes[MESH_BLEND_SLOTS];
+uint8_t       MeshBlend::mesh_count   = 0;
+int8_t        MeshBlend::loaded_index = -1;
+float         MeshBlend::blend_temp   = NAN,
+              MeshBlend::z_base[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y],
+              MeshBlend::z_diff[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+short_timer_t MeshBlend::spin_timer;
+
+/** Public Function */
+bool MeshBlend::enable(const bool onoff) {
+
+  if (!onoff) {
+    if (enabled) SERIAL_EM("Mesh blend off");
+    enabled = false;
+    return true;
+  }
+
+  // Take the stored meshes with a bed temperature, sorted by temperature
+  mesh_count = 0;
+  const int16_t a = eeprom.calc_num_meshes();
+  for (int8_t slot = 0; slot < a; slot++) {
+    const float temp = eeprom.mesh_bed_temp(slot);
+    if (isnan(temp)) continue;
+
+    uint8_t i = 0;
+    while (i < mesh_count && meshes[i].temp < temp) i++;
+    if (i < mesh_count && ABS(meshes[i].temp - temp) < MESH_BLEND_MIN_STEP) continue;
+    if (i > 0 && ABS(meshes[i - 1].temp - temp) < MESH_BLEND_MIN_STEP) continue;
+    if (mesh_count == MESH_BLEND_SLOTS) {
+      SERIAL_EMV("?Mesh blend is full, skip slot ", slot);
+      continue;
+    }
+
+    for (uint8_t j = mesh_count; j > i; j--) meshes[j] = meshes[j - 1];
+    meshes[i].temp = temp;
+    meshes[i].slot = slot;
+    mesh_count++;
+  }
+
+  if (mesh_count < 2) {
+    SERIAL_EM("?Mesh blend needs two meshes stored at different bed temperatures.");
+    enabled = false;
+    return false;
+  }
+
+  loaded_index = -1;
+  blend_temp = NAN;
+  enabled = true;
+  spin_timer.start();
+  blend(beds[0]->deg_current());
+  return true;
+}
+
+void MeshBlend::spin() {
+
+  if (!enabled || !spin_timer.expired(1000)) return;
+
+  const float temp = beds[0]->deg_current();
+  if (ABS(temp - blend_temp) >= MESH_BLEND_RESOLUTION) blend(temp);
+
+}
+
+void MeshBlend::print_M424() {
+  SERIAL_LM(CFG, "Bed temperature mesh blend");
+  SERIAL_LMV(CFG, "  M424 S", int(enabled));
+  if (!enabled) return;
+  for (uint8_t i = 0; i < mesh_count; i++) {
+    SERIAL_SMV(CFG, "  Slot ", int(meshes[i].slot));
+    SERIAL_EMV(" T", meshes[i].temp, 1);
+  }
+  SERIAL_LMV(CFG, "  Active mesh T", blend_temp, 1);
+}
+
+/** Private Function */
+bool MeshBlend::load_pair(const uint8_t index) {
+
+  loaded_index = -1;
+
+  if (!eeprom.load_mesh(meshes[index].slot, &z_base) || !eeprom.load_mesh(meshes[index + 1].slot, &z_diff))
+    return false;
+
+  // A point probed in only one of the meshes keeps that value at any temperature,
+  // a point probed in neither stays unprobed (NAN)
+  uint16_t single = 0;
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+      if (isnan(z_base[x][y]) != isnan(z_diff[x][y])) single++;
+      if (isnan(z_base[x][y])) z_base[x][y] = z_diff[x][y];
+      z_diff[x][y] = isnan(z_diff[x][y]) ? 0.0f : z_diff[x][y] - z_base[x][y];
+    }
+  }
+
+  if (single) {
+    SERIAL_MV("Mesh blend: ", int(single));
+    SERIAL_MV(" points probed only in slot ", int(meshes[index].slot));
+    SERIAL_EMV(" or ", int(meshes[index + 1].slot));
+  }
+
+  loaded_index = index;
+  return true;
+}
+
+void MeshBlend::blend(const float temp) {
+
+  // The pair of meshes around the temperature, the end pairs hold out of the range
+  uint8_t i = 0;
+  while (i < mesh_count - 2 && temp > meshes[i + 1].temp) i++;
+
+  if (i != loaded_index && !load_pair(i)) {
+    SERIAL_LM(ER, "Mesh blend off, unable to load the meshes");
+    enabled = false;
+    return;
+  }
+
+  const float t = constrain((temp - meshes[i].temp) / (meshes[i + 1].temp - meshes[i].temp), 0.0f, 1.0f);
+
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      ubl.z_values[x][y] = z_base[x][y] + z_diff[x][y] * t;
+
+  blend_temp = temp;
+
+}
+
+#endif // ENABLED(UBL_MESH_TEMP_BLEND)
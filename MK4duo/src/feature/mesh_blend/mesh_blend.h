@@ -0,0 +1,91 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * mesh_blend.h - Bed temperature mesh blending
+ *
+ * The UBL meshes stored with G29 S keep the bed temperature of the time they
+ * were saved. With the blend on, the two stored meshes around the current bed
+ * temperature are loaded once as a base mesh and a difference mesh, and the
+ * active mesh is set to base + difference * t each time the bed temperature
+ * moves by MESH_BLEND_RESOLUTION. The leveling keeps reading the one active
+ * mesh, so the cost per segment is the same as with a single mesh.
+ * A point probed in only one of the two meshes takes that value.
+ */
+
+#if ENABLED(UBL_MESH_TEMP_BLEND)
+
+// Stored mesh and its bed temperature
+typedef struct {
+  float   temp;
+  int8_t  slot;
+} mesh_temp_t;
+
+class MeshBlend {
+
+  public: /** Constructor */
+
+    MeshBlend() {}
+
+  public: /** Public Parameters */
+
+    static bool enabled;
+
+  private: /** Private Parameters */
+
+    static mesh_temp_t  meshes[MESH_BLEND_SLOTS];   // Sorted by temperature
+    static uint8_t      mesh_count;
+    static int8_t       loaded_index;               // Lower mesh of the pair in base and diff
+
+    static float        blend_temp,                 // Bed temperature of the active mesh
+                        z_base[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y],
+                        z_diff[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+
+    static short_timer_t spin_timer;
+
+  public: /** Public Function */
+
+    /**
+     * Turn on the blend of all the stored meshes with a bed temperature,
+     * return false if there are not at least two of them
+     */
+    static bool enable(const bool onoff);
+
+    /**
+     * Follow the bed temperature, called from the main loop between commands
+     * so the mesh never changes in the middle of a segmented move
+     */
+    static void spin();
+
+    static void print_M424();
+
+  private: /** Private Function */
+
+    static bool load_pair(const uint8_t index);
+    static void blend(const float temp);
+
+};
+
+extern MeshBlend meshBlend;
+
+#endif // ENABLED(UBL_MESH_TEMP_BLEND)
@@ -0,0 +1,43 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+// Bed temperature mesh blend
+#if ENABLED(UBL_MESH_TEMP_BLEND)
+  #if DISABLED(AUTO_BED_LEVELING_UBL)
+    #error "DEPENDENCY ERROR: UBL_MESH_TEMP_BLEND requires AUTO_BED_LEVELING_UBL."
+  #elif !HAS_EEPROM
+    #error "DEPENDENCY ERROR: UBL_MESH_TEMP_BLEND requires EEPROM_SETTINGS."
+  #elif !HAS_BEDS
+    #error "DEPENDENCY ERROR: UBL_MESH_TEMP_BLEND requires a heated bed."
+  #elif DISABLED(MESH_BLEND_SLOTS) || DISABLED(MESH_BLEND_RESOLUTION)
+    #error "DEPENDENCY ERROR: Missing setting MESH_BLEND_SLOTS or MESH_BLEND_RESOLUTION."
+  #elif MESH_BLEND_SLOTS < 2
+    #error "DEPENDENCY ERROR: MESH_BLEND_SLOTS must be 2 or more."
+  #endif
+#endif
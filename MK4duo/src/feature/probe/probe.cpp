@@ -33,6 +33,7 @@ Probe probe;
 
 /** Public Parameters */
 probe_data_t Probe::data;
+running_stats Probe::point_stats;
 
 /** Public Function */
 void Probe::factory_parameters() {
@@ -195,6 +196,11 @@ bool Probe::set_deployed(const bool deploy) {
           SERIAL_MV(STR_BED_LEVELING_Z, measured_z, 3);
           SERIAL_MV(STR_BED_LEVELING_X, LOGICAL_X_POSITION(rx), 3);
           SERIAL_MV(STR_BED_LEVELING_Y, LOGICAL_Y_POSITION(ry), 3);
+          if (point_stats.count() > 1) {
+            SERIAL_MV(" +/-", point_stats.std_error(), 4);
+            SERIAL_MV(" samples:", point_stats.count());
+            if (point_stats.rejected()) SERIAL_MV(" rejected:", point_stats.rejected());
+          }
           SERIAL_EOL();
         }
       }
@@ -242,6 +248,87 @@ bool Probe::set_deployed(const bool deploy) {
 
 #endif // HAS_BED_PROBE || HAS_PROBE_MANUALLY
 
+#if ENABLED(PROBE_FLYING)
+
+  /**
+   * fly_to_point
+   * The probe is deployed and sits at the last trigger point, or it is
+   * over the bed at the travel height for the first point of a grid.
+   * - Lift straight up to Z_PROBE_BETWEEN_HEIGHT, then travel to the given XY
+   * - Queue the probe move right after them, the planner runs the
+   *   moves without waiting for each to be done
+   * - Take Z at the probe edge from the steps recorded by the endstop interrupt
+   * - Leave the probe deployed at the trigger height
+   */
+  float Probe::fly_to_point(const xy_pos_t &pos, const uint8_t verbose_level/*=0*/) {
+
+    if (printer.debugFeature()) {
+      DEBUG_MV(">>> fly_to_point(", LOGICAL_X_POSITION(pos.x));
+      DEBUG_MV(", ", LOGICAL_Y_POSITION(pos.y));
+      DEBUG_MV(", ", int(verbose_level));
+      DEBUG_EM(")");
+      DEBUG_POS("", mechanics.position);
+    }
+
+    #if HAS_BLTOUCH
+      if (bltouch.triggered()) bltouch.cmd_reset();
+    #endif
+
+    if (!mechanics.position_is_reachable_by_probe(pos)) {
+      print_error();
+      return NAN;
+    }
+
+    float measured_z = NAN;
+    point_stats.reset();
+
+    if (!DEPLOY_PROBE()) {
+
+      // Stop the probe before it goes too low to prevent damage.
+      const float z_probe_low_point = Z_PROBE_LOW_POINT - data.offset.z;
+
+      // Lift to the travel height as do_raise() does, without waiting for the move,
+      // Z goes up so the still triggered probe is not checked
+      float z_travel = Z_PROBE_BETWEEN_HEIGHT;
+      if (data.offset.z < 0) z_travel -= data.offset.z;
+      NOMORE(z_travel, Z_MAX_BED);
+      if (z_travel > mechanics.position.z) {
+        mechanics.position.z = z_travel;
+        mechanics.line_to_position(mechanics.homing_feedrate_mm_s.z);
+      }
+
+      // Travel at the travel height
+      mechanics.position.set(pos.x - data.offset.x, pos.y - data.offset.y);
+      mechanics.line_to_position(XY_PROBE_FEEDRATE_MM_S);
+
+      // Probe down at the end of the travel
+      if (!down_to_z(z_probe_low_point, MMM_TO_MMS(data.speed_fast)))
+        measured_z = triggered_z() + data.offset.z;
+      else if (printer.debugFeature())
+        DEBUG_EM("FLYING Probe fail!");
+
+    }
+
+    if (isnan(measured_z)) {
+      STOW_PROBE();
+      SERIAL_LM(ER, STR_ERR_PROBING_FAILED);
+      LCD_MESSAGEPGM(MSG_LCD_PROBING_FAILED);
+      sound.feedback(false);
+    }
+    else if (verbose_level > 2) {
+      SERIAL_MV(STR_BED_LEVELING_Z, measured_z, 3);
+      SERIAL_MV(STR_BED_LEVELING_X, LOGICAL_X_POSITION(pos.x), 3);
+      SERIAL_MV(STR_BED_LEVELING_Y, LOGICAL_Y_POSITION(pos.y), 3);
+      SERIAL_EOL();
+    }
+
+    if (printer.debugFeature()) DEBUG_EM("<<< fly_to_point");
+
+    return measured_z;
+  }
+
+#endif // PROBE_FLYING
+
 #if QUIET_PROBING
 
   void Probe::set_paused(const bool onoff) {
@@ -520,8 +607,6 @@ void Probe::do_raise(const float z_raise) {
  */
 float Probe::run_probing() {
 
-  float probe_z = 0.0f;
-
   if (printer.debugFeature()) DEBUG_POS(">>> probe.run_probing", mechanics.position);
 
   // Stop the probe before it goes too low to prevent damage.
@@ -536,6 +621,8 @@ float Probe::run_probing() {
       mechanics.do_blocking_move_to_z(mechanics.position.z + Z_PROBE_BETWEEN_HEIGHT, MMM_TO_MMS(data.speed_fast));
   }
 
+  point_stats.reset();
+
   for (uint8_t r = data.repetitions + 1; --r;) {
 
     // move down slowly to find bed
@@ -547,12 +634,31 @@ float Probe::run_probing() {
       return NAN;
     }
 
-    probe_z += mechanics.position.z;
+    const float probe_z = triggered_z();
+    if (!point_stats.add_filtered(probe_z, Z_PROBE_OUTLIER_SIGMA, min_sigma()) && printer.debugFeature())
+      DEBUG_EMV("Outlier rejected: ", probe_z, 3);
+
+    // Stop early once the samples agree
+    if (Z_PROBE_REPETITIONS_SIGMA > 0 && point_stats.settled(Z_PROBE_REPETITIONS_SIGMA)) break;
+
     if (r > 1) mechanics.do_blocking_move_to_z(mechanics.position.z + Z_PROBE_BETWEEN_HEIGHT, MMM_TO_MMS(data.speed_fast));
 
   }
 
-  return probe_z / (float)data.repetitions;
+  return point_stats.mean();
+}
+
+/**
+ * The Z where the probe was triggered, after a probe move
+ */
+float Probe::triggered_z() {
+  return mechanics.position.z
+    #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE) && !IS_KINEMATIC
+      // The pin interrupt records the steps at the probe edge, back to that Z
+      // from the stop, the stepper ISR can still step before it sees the stop
+      + planner.triggered_position_mm(Z_AXIS) - planner.get_axis_position_mm(Z_AXIS)
+    #endif
+  ;
 }
 
 void Probe::print_error() {
@@ -58,6 +58,9 @@ class Probe {
 
     static probe_data_t data;
 
+    // Statistics of the samples of the last probed point
+    static running_stats point_stats;
+
   public: /** Public Function */
 
     /**
@@ -71,6 +74,9 @@ class Probe {
       static void move_z_after_probing();
     #endif
 
+    // Outliers are judged against at least this deviation, samples one Z step apart have none
+    static inline float min_sigma() { return MAX(float(Z_PROBE_REPETITIONS_SIGMA), mechanics.steps_to_mm.z); }
+
     #if HAS_BED_PROBE || HAS_LEVELING
 
       static inline float min_x() {
@@ -137,6 +143,20 @@ class Probe {
 
     #endif
 
+    #if ENABLED(PROBE_FLYING)
+
+      /**
+       * Fly to Pt
+       * - Deploy the probe, if not already deployed
+       * - Lift over the last trigger point, then travel to the given XY
+       * - Probe down at the fast speed right after it, without a stop at the point
+       * - Leave the probe deployed at the trigger height
+       * - Return the probed Z position
+       */
+      static float fly_to_point(const xy_pos_t &pos, const uint8_t verbose_level=0);
+
+    #endif
+
     #if QUIET_PROBING
       static void set_paused(const bool onoff);
     #endif
@@ -155,6 +175,8 @@ class Probe {
 
     static float run_probing();
 
+    static float triggered_z();
+
     static void print_error();
 
     #if HAS_ALLEN_KEY
@@ -111,6 +111,27 @@
   #endif
 #endif
 
+// Flying probing
+#if ENABLED(PROBE_FLYING)
+  #if !HAS_BED_PROBE || ENABLED(PROBE_MANUALLY)
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires a bed probe."
+  #elif IS_KINEMATIC
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires a Cartesian or Core machine."
+  #elif DISABLED(ENDSTOP_INTERRUPTS_FEATURE)
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires ENDSTOP_INTERRUPTS_FEATURE."
+  #elif !HAS_Z_PROBE_PIN && !HAS_Z_MIN
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires a probe pin. Use Z_MIN_PIN or Z_PROBE_PIN."
+  #elif HAS_BLTOUCH && DISABLED(BLTOUCH_HIGH_SPEED_MODE)
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires BLTOUCH_HIGH_SPEED_MODE with a BLTouch."
+  #elif ENABLED(PROBE_SENSORLESS) || HAS_ALLEN_KEY || HAS_SLED
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires a fixed, servo or BLTouch probe."
+  #elif !ABL_GRID
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR."
+  #elif Z_PROBE_BETWEEN_HEIGHT <= 0
+    #error "DEPENDENCY ERROR: PROBE_FLYING requires Z_PROBE_BETWEEN_HEIGHT greater than 0."
+  #endif
+#endif
+
 #if HOMING_Z_WITH_PROBE && DISABLED(Z_SAFE_HOMING)
   #error "Z_SAFE_HOMING is recommended when homing with a probe. Enable it or comment out this line to continue."
 #endif
@@ -0,0 +1,37 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+// Selective resend
+#if ENABLED(SELECTIVE_RESEND)
+  #if DISABLED(SELECTIVE_RESEND_WINDOW) || DISABLED(SELECTIVE_RESEND_HISTORY) || DISABLED(SELECTIVE_RESEND_TIMEOUT)
+    #error "DEPENDENCY ERROR: Missing setting SELECTIVE_RESEND_WINDOW, SELECTIVE_RESEND_HISTORY or SELECTIVE_RESEND_TIMEOUT."
+  #elif SELECTIVE_RESEND_WINDOW < 1
+    #error "DEPENDENCY ERROR: SELECTIVE_RESEND_WINDOW must be 1 or more."
+  #endif
+#endif
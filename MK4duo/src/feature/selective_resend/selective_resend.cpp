@@ -0,0 +1,127 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * selective_resend.cpp - Selective retransmit of G-code lines
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(SELECTIVE_RESEND)
+
+SelectiveResend resend;
+
+/** Private Parameters */
+long          SelectiveResend::history[SELECTIVE_RESEND_HISTORY];
+uint8_t       SelectiveResend::history_index                      = 0;
+held_line_t   SelectiveResend::window[SELECTIVE_RESEND_WINDOW];
+long          SelectiveResend::requested_N                        = -1;
+short_timer_t SelectiveResend::request_timer;
+
+/** Public Function */
+void SelectiveResend::reset() {
+  LOOP_L_N(h, SELECTIVE_RESEND_HISTORY) history[h] = -1;
+  LOOP_L_N(w, SELECTIVE_RESEND_WINDOW) window[w].used = false;
+  requested_N = -1;
+}
+
+bool SelectiveResend::check_crc16(char * const command, char * const cpos) {
+  uint16_t crc = 0xFFFF;
+  for (const char *p = command; p < cpos; p++) {
+    crc ^= uint16_t(uint8_t(*p)) << 8;
+    for (uint8_t b = 0; b < 8; b++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  const bool valid = strtol(cpos + 1, nullptr, 10) == crc;
+  *cpos = '\0';
+  return valid;
+}
+
+bool SelectiveResend::out_of_order(const long N, const long expected, const char * const command, const int8_t port) {
+
+  // Already accepted or held: a host that rewinds after a resend sends it again
+  if (is_duplicate(N, expected)) {
+    commands.line_stats.duplicate++;
+    SERIAL_PORT(port);
+    SERIAL_L(OK);
+    SERIAL_PORT(-1);
+    return true;
+  }
+
+  // Hold a line that is ahead, and ask only for the missing one
+  if (N > expected && N <= expected + SELECTIVE_RESEND_WINDOW) {
+    LOOP_L_N(w, SELECTIVE_RESEND_WINDOW) {
+      if (!window[w].used) {
+        window[w].used    = true;
+        window[w].N       = N;
+        window[w].s_port  = port;
+        strcpy(window[w].gcode, command);
+        commands.line_stats.held++;
+        if (request(expected)) send_resend(expected, port);
+        return true;
+      }
+    }
+  }
+
+  return false;
+
+}
+
+void SelectiveResend::accepted(const long N) {
+  history[history_index] = N;
+  if (++history_index >= SELECTIVE_RESEND_HISTORY) history_index = 0;
+  if (N == requested_N) requested_N = -1;
+  // Held lines up to N are stale: the host sent them again in order
+  LOOP_L_N(w, SELECTIVE_RESEND_WINDOW)
+    if (window[w].used && window[w].N <= N) window[w].used = false;
+}
+
+held_line_t* SelectiveResend::held(const long N) {
+  LOOP_L_N(w, SELECTIVE_RESEND_WINDOW)
+    if (window[w].used && window[w].N == N) return &window[w];
+  return nullptr;
+}
+
+bool SelectiveResend::request(const long N) {
+  if (N == requested_N && request_timer.isRunning() && !request_timer.expired(SELECTIVE_RESEND_TIMEOUT))
+    return false;
+  requested_N = N;
+  request_timer.start();
+  return true;
+}
+
+/** Private Function */
+bool SelectiveResend::is_duplicate(const long N, const long expected) {
+  if (N < expected) LOOP_L_N(h, SELECTIVE_RESEND_HISTORY) if (history[h] == N) return true;
+  return held(N) != nullptr;
+}
+
+void SelectiveResend::send_resend(const long N, const int8_t port) {
+  commands.line_stats.resend++;
+  SERIAL_PORT(port);
+  SERIAL_LV(RESEND, N);
+  SERIAL_L(OK);
+  SERIAL_PORT(-1);
+}
+
+#endif // ENABLED(SELECTIVE_RESEND)
@@ -0,0 +1,107 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * selective_resend.h - Selective retransmit of G-code lines
+ *
+ * Lines that arrive after a missing one are held in a small window,
+ * so the host has to resend only the missing line. Lines already accepted
+ * are answered with "ok" and skipped, instead of starting a new resend.
+ * Lines may carry a CRC16 (CCITT) as "^<crc>" in place of the "*<xor>" checksum.
+ */
+
+#if ENABLED(SELECTIVE_RESEND)
+
+struct held_line_t {
+  long    N;
+  int8_t  s_port;
+  bool    used;
+  char    gcode[MAX_CMD_SIZE];
+};
+
+class SelectiveResend {
+
+  public: /** Constructor */
+
+    SelectiveResend() { reset(); }
+
+  private: /** Private Parameters */
+
+    static long         history[SELECTIVE_RESEND_HISTORY];
+    static uint8_t      history_index;
+
+    static held_line_t  window[SELECTIVE_RESEND_WINDOW];
+
+    static long           requested_N;
+    static short_timer_t  request_timer;
+
+  public: /** Public Function */
+
+    /**
+     * Clear history and window, i.e. after M110
+     */
+    static void reset();
+
+    /**
+     * Check the CRC16 of the command, written as "^<crc>" at cpos.
+     * Cut the CRC from the command and return true if it matches.
+     */
+    static bool check_crc16(char * const command, char * const cpos);
+
+    /**
+     * A valid line with N != expected:
+     * answer a duplicate or hold a line that is ahead.
+     * Return false if the line must be handled as a line number error.
+     */
+    static bool out_of_order(const long N, const long expected, const char * const command, const int8_t port);
+
+    /**
+     * Record an accepted line number and
+     * free the held lines up to it
+     */
+    static void accepted(const long N);
+
+    /**
+     * Held line with number N, or nullptr
+     */
+    static held_line_t* held(const long N);
+
+    FORCE_INLINE static void release(held_line_t * const line) { line->used = false; }
+
+    /**
+     * True if a resend of N should be sent now. Repeated requests
+     * for the same line are sent only after SELECTIVE_RESEND_TIMEOUT ms.
+     */
+    static bool request(const long N);
+
+  private: /** Private Function */
+
+    static bool is_duplicate(const long N, const long expected);
+
+    static void send_resend(const long N, const int8_t port);
+
+};
+
+extern SelectiveResend resend;
+
+#endif // ENABLED(SELECTIVE_RESEND)
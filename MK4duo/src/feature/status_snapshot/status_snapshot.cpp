@@ -0,0 +1,554 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * status_snapshot.cpp - Pre-serialized status reports for the host
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(STATUS_SNAPSHOT)
+
+// Longest text of a value as written by StatusText::add
+#define STATUS_BYTE_LEN       3                   // uint8_t "255"
+#define STATUS_INT_LEN        6                   // int16_t "-32768"
+#define STATUS_FLOAT_LEN(D)   (12 + (D))          // Sign, 10 digits of uint32_t, point and decimals
+
+// " B0:" temperature " /" target " B@0:" pwm
+#define STATUS_HEATER_LEN     (6 + STATUS_FLOAT_LEN(2) + 2 + STATUS_INT_LEN + 4 + 2 * STATUS_BYTE_LEN)
+
+// Active hotend, first bed, chamber and cooler, then the lists of hotends, beds and chambers, MCU, DHT and fans
+#define STATUS_TEMP_SIZE      ( STATUS_HEATER_LEN * (MAX_HOTEND + MAX_BED + MAX_CHAMBER + MAX_COOLER + 3)   \
+                              + 10 + 2 * STATUS_INT_LEN + 20 + 2 * STATUS_FLOAT_LEN(1)                      \
+                              + (4 + 2 * STATUS_BYTE_LEN) * MAX_FAN )
+
+// " X: " position for each axis and EOL
+#define STATUS_POSITION_SIZE  ((4 + STATUS_FLOAT_LEN(3)) * XYZE + 1)
+
+#if ENABLED(JSON_OUTPUT)
+  // Fixed text, then E and XYZ, tool, fan, speed, flow of each extruder, bed, and current, active and state of each hotend
+  #define STATUS_JSON_SIZE    ( 256 + 4 * STATUS_FLOAT_LEN(2) + 2 * STATUS_BYTE_LEN + STATUS_INT_LEN  \
+                              + (STATUS_INT_LEN + 1) * MAX_EXTRUDER                                   \
+                              + STATUS_FLOAT_LEN(1) + STATUS_INT_LEN                                  \
+                              + (STATUS_FLOAT_LEN(1) + STATUS_INT_LEN + 4) * MAX_HOTEND )
+#else
+  #define STATUS_JSON_SIZE    1
+#endif
+
+StatusSnapshot statusSnapshot;
+
+static char temp_buffer[STATUS_TEMP_SIZE],
+            position_buffer[STATUS_POSITION_SIZE],
+            json_buffer[STATUS_JSON_SIZE];
+
+/** Public Parameters */
+uint16_t StatusSnapshot::auto_report_ms[SNAPSHOT_COUNT] = { 0 };
+
+/** Private Parameters */
+StatusText StatusSnapshot::text[SNAPSHOT_COUNT] = {
+  StatusText(temp_buffer, STATUS_TEMP_SIZE),
+  StatusText(position_buffer, STATUS_POSITION_SIZE),
+  StatusText(json_buffer, STATUS_JSON_SIZE)
+};
+
+short_timer_t StatusSnapshot::refresh_timer[SNAPSHOT_COUNT],
+              StatusSnapshot::auto_report_timer[SNAPSHOT_COUNT];
+
+uint8_t StatusSnapshot::pending   = 0,
+        StatusSnapshot::deferred  = 0;
+
+/** StatusText Function */
+void StatusText::add(const char c) {
+  if (length < size) buffer[length++] = c;
+  else overflow = true;
+}
+
+void StatusText::add_P(PGM_P str) {
+  char c;
+  while ((c = pgm_read_byte(str++))) add(c);
+}
+
+void StatusText::add(const int32_t value) {
+  char digit[10];
+  uint8_t n = 0;
+  uint32_t v = value < 0 ? -value : value;
+  if (value < 0) add('-');
+  do { digit[n++] = '0' + v % 10; v /= 10; } while (v);
+  while (n) add(digit[--n]);
+}
+
+void StatusText::add(const float value, const uint8_t digits) {
+
+  if (isnan(value)) { add_P(PSTR("nan")); return; }
+
+  float v = value;
+  if (v < 0.0f) { add('-'); v = -v; }
+
+  // Round correctly so that print(1.999, 2) prints as "2.00"
+  float rounding = 0.5f;
+  for (uint8_t i = 0; i < digits; i++) rounding *= 0.1f;
+  v += rounding;
+
+  const uint32_t int_part = uint32_t(v);
+  add(int32_t(int_part));
+
+  if (digits > 0) {
+    add('.');
+    float remainder = v - float(int_part);
+    for (uint8_t i = 0; i < digits; i++) {
+      remainder *= 10.0f;
+      const uint8_t d = uint8_t(remainder);
+      add(char('0' + d));
+      remainder -= d;
+    }
+  }
+
+}
+
+/** Public Function */
+void StatusSnapshot::spin() {
+
+  const bool temp_enabled = !printer.isSuspendAutoreport() && printer.isAutoreportTemp();
+
+  LOOP_L_N(s, SNAPSHOT_COUNT) {
+
+    if ((s != SNAPSHOT_TEMP || temp_enabled) && auto_report_timer[s].expired(auto_report_ms[s])) {
+      // The report of the last period is still waiting, send only the new one
+      if (TEST(pending, s)) Com::tx_dropped++;
+      SBI(pending, s);
+    }
+
+    if (!TEST(pending, s)) continue;
+
+    if (!refresh((SnapshotEnum)s, false)) {
+      CBI(pending, s);
+      continue;
+    }
+
+    // Room for the text plus EOL, or time and EOL for JSON
+    if (!Com::tx_ready(text[s].length + (s == SNAPSHOT_JSON ? 24 : 1))) {
+      if (!TEST(deferred, s)) {
+        SBI(deferred, s);
+        Com::tx_deferred++;
+      }
+      continue;
+    }
+
+    CBI(pending, s);
+    CBI(deferred, s);
+
+    text[s].write();
+    if (s == SNAPSHOT_JSON) SERIAL_PRINTF(",\"time\":%lu}\n", (unsigned long)HAL::timeInMilliseconds());
+    else if (s == SNAPSHOT_TEMP) SERIAL_EOL();
+
+  }
+
+}
+
+void StatusSnapshot::report(const SnapshotEnum s) {
+  if (refresh(s, true)) text[s].write();
+}
+
+bool StatusSnapshot::set_auto_report(const SnapshotEnum s, const millis_l ms) {
+  if (ms > 65535UL) {
+    SERIAL_LM(ER, "Auto-report interval out of range (max 65 seconds)");
+    return false;
+  }
+  auto_report_ms[s] = ms;
+  CBI(pending, s);
+  CBI(deferred, s);
+  if (ms) auto_report_timer[s].start();
+  else    auto_report_timer[s].stop();
+  return true;
+}
+
+void StatusSnapshot::invalidate() {
+  LOOP_L_N(s, SNAPSHOT_COUNT) text[s].valid = false;
+}
+
+/** Private Function */
+bool StatusSnapshot::refresh(const SnapshotEnum s, const bool request) {
+
+  StatusText &t = text[s];
+
+  const uint32_t fingerprint =  s == SNAPSHOT_TEMP      ? fingerprint_temp()
+                              : s == SNAPSHOT_POSITION  ? fingerprint_position()
+                              :                           fingerprint_json();
+
+  if (t.valid && t.fingerprint == fingerprint) return true;
+
+  // Auto-reports rebuild a changed text at most once per period, a request always gets the current values
+  if (!request && t.valid && refresh_timer[s].isRunning() && !refresh_timer[s].expired(STATUS_SNAPSHOT_PERIOD, false))
+    return true;
+
+  refresh_timer[s].start();
+
+  t.clear();
+  switch (s) {
+    case SNAPSHOT_TEMP:     build_temp(t);      break;
+    case SNAPSHOT_POSITION: build_position(t);  break;
+    default:                build_json(t);      break;
+  }
+
+  if (t.overflow) {
+    t.valid = false;
+    SERIAL_LMV(ER, "Status report overflow, size:", t.size);
+    return false;
+  }
+
+  t.fingerprint = fingerprint;
+  t.valid = true;
+  return true;
+
+}
+
+// FNV-1a hash of the values as shown, so that noise below the printed digits is ignored
+static void hash_add(uint32_t &hash, const int32_t value) {
+  uint32_t v = value;
+  for (uint8_t i = 0; i < 4; i++) {
+    hash ^= uint8_t(v);
+    hash *= 16777619UL;
+    v >>= 8;
+  }
+}
+
+#define HASH_INIT 2166136261UL
+
+#if HAS_HEATER
+  static void hash_heater(uint32_t &hash, Heater* act) {
+    hash_add(hash, LROUND(act->current_temperature * 100.0f));
+    hash_add(hash, act->isIdle() ? act->deg_idle() : act->deg_target());
+    hash_add(hash, act->pwm_value);
+  }
+#endif
+
+uint32_t StatusSnapshot::fingerprint_temp() {
+  uint32_t hash = HASH_INIT;
+  #if HAS_HOTENDS
+    LOOP_HOTEND() hash_heater(hash, hotends[h]);
+    hash_add(hash, toolManager.active_hotend());
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() hash_heater(hash, beds[h]);
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() hash_heater(hash, chambers[h]);
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() hash_heater(hash, coolers[h]);
+  #endif
+  #if HAS_MCU_TEMPERATURE
+    hash_add(hash, tempManager.mcu_current_temperature);
+    hash_add(hash, tempManager.mcu_highest_temperature);
+  #endif
+  #if HAS_DHT
+    hash_add(hash, LROUND(dhtsensor.temperature * 10.0f));
+    hash_add(hash, LROUND(dhtsensor.humidity * 10.0f));
+  #endif
+  #if HAS_FAN
+    LOOP_FAN() hash_add(hash, fans[f]->speed);
+  #endif
+  return hash;
+}
+
+uint32_t StatusSnapshot::fingerprint_position() {
+  uint32_t hash = HASH_INIT;
+  const xyze_pos_t lpos = mechanics.position.asLogical();
+  LOOP_XYZE(a) hash_add(hash, LROUND(lpos[a] * 1000.0f));
+  return hash;
+}
+
+uint32_t StatusSnapshot::fingerprint_json() {
+  uint32_t hash = HASH_INIT;
+  #if ENABLED(JSON_OUTPUT)
+    hash_add(hash, print_job_counter.isRunning() | (print_job_counter.isPaused() << 1) | (mechanics.isHomedAll() << 2));
+    LOOP_XYZE(a) hash_add(hash, LROUND(mechanics.position[a] * 100.0f));
+    hash_add(hash, toolManager.extruder.active);
+    #if HAS_POWER_SWITCH
+      hash_add(hash, powerManager.is_on());
+    #endif
+    #if HAS_FAN
+      hash_add(hash, fans[0]->speed);
+    #endif
+    hash_add(hash, mechanics.feedrate_percentage);
+    LOOP_EXTRUDER() hash_add(hash, extruders[e]->flow_percentage);
+    #if HAS_BEDS
+      hash_add(hash, LROUND(beds[0]->deg_current() * 10.0f));
+      hash_add(hash, beds[0]->deg_target());
+    #endif
+    #if HAS_HOTENDS
+      LOOP_HOTEND() {
+        hash_add(hash, LROUND(hotends[h]->deg_current() * 10.0f));
+        hash_add(hash, hotends[h]->deg_target());
+      }
+    #endif
+  #endif
+  return hash;
+}
+
+#if HAS_HEATER
+
+  void StatusSnapshot::build_heater(StatusText &t, Heater* act, const bool print_ID) {
+
+    t.add(' ');
+
+    #if HAS_HOTENDS
+      if (act->type == IS_HOTEND) {
+        t.add('T');
+        if (print_ID) t.add(act->data.ID);
+      }
+    #endif
+
+    #if HAS_BEDS
+      if (act->type == IS_BED) {
+        t.add('B');
+        if (print_ID) t.add(act->data.ID);
+      }
+    #endif
+
+    #if HAS_CHAMBERS
+      if (act->type == IS_CHAMBER) {
+        t.add('C');
+        if (print_ID) t.add(act->data.ID);
+      }
+    #endif
+
+    #if HAS_COOLERS
+      if (act->type == IS_COOLER) t.add('W');
+    #endif
+
+    const int16_t targetTemperature = act->isIdle() ? act->deg_idle() : act->deg_target();
+    t.add(':');
+    t.add(act->current_temperature, 2);
+    t.add_P(PSTR(" /"));
+    t.add(targetTemperature);
+
+  }
+
+#endif // HAS_HEATER
+
+/**
+ * Same text as TempManager::report_temperatures and FanManager::report_speed
+ */
+void StatusSnapshot::build_temp(StatusText &t) {
+
+  #if HAS_HOTENDS
+    if (tempManager.heater.hotends > 0) {
+      build_heater(t, hotends[toolManager.active_hotend()], false);
+      t.add_P(PSTR(STR_AT ":"));
+      t.add(hotends[toolManager.active_hotend()]->pwm_value);
+    }
+  #endif
+
+  #if HAS_BEDS
+    if (tempManager.heater.beds > 0) {
+      build_heater(t, beds[0], false);
+      t.add_P(PSTR(STR_BAT ":"));
+      t.add(beds[0]->pwm_value);
+    }
+  #endif
+
+  #if HAS_CHAMBERS
+    if (tempManager.heater.chambers > 0) {
+      build_heater(t, chambers[0], false);
+      t.add_P(PSTR(STR_CAT ":"));
+      t.add(chambers[0]->pwm_value);
+    }
+  #endif
+
+  #if HAS_COOLERS
+    if (tempManager.heater.coolers > 0) {
+      build_heater(t, coolers[0], false);
+      t.add_P(PSTR(STR_CAT ":"));
+      t.add(coolers[0]->pwm_value);
+    }
+  #endif
+
+  #if MAX_HOTEND > 1
+    if (tempManager.heater.hotends > 1) {
+      LOOP_HOTEND() {
+        build_heater(t, hotends[h], true);
+        t.add_P(PSTR(STR_AT));
+        t.add(h);
+        t.add(':');
+        t.add(hotends[h]->pwm_value);
+      }
+    }
+  #endif
+
+  #if MAX_BED > 1
+    if (tempManager.heater.beds > 1) {
+      LOOP_BED() {
+        build_heater(t, beds[h], true);
+        t.add_P(PSTR(STR_BAT));
+        t.add(h);
+        t.add(':');
+        t.add(beds[h]->pwm_value);
+      }
+    }
+  #endif
+
+  #if MAX_CHAMBER > 1
+    if (tempManager.heater.chambers > 1) {
+      LOOP_CHAMBER() {
+        build_heater(t, chambers[h], true);
+        t.add_P(PSTR(STR_CAT));
+        t.add(h);
+        t.add(':');
+        t.add(chambers[h]->pwm_value);
+      }
+    }
+  #endif
+
+  #if HAS_MCU_TEMPERATURE
+    t.add_P(PSTR(" MCU:"));
+    t.add(tempManager.mcu_current_temperature);
+    t.add_P(PSTR(" max:"));
+    t.add(tempManager.mcu_highest_temperature);
+  #endif
+
+  #if HAS_DHT
+    t.add_P(PSTR(" DHT Temp:"));
+    t.add(dhtsensor.temperature, 1);
+    t.add_P(PSTR(" Humidity:"));
+    t.add(dhtsensor.humidity, 1);
+  #endif
+
+  #if !HAS_HEATER
+    t.add_P(PSTR(" T:0"));
+  #endif
+
+  #if HAS_FAN
+    LOOP_FAN() {
+      t.add_P(PSTR(" F"));
+      t.add(f);
+      t.add(':');
+      t.add(fans[f]->speed);
+    }
+  #endif
+
+}
+
+/**
+ * Same text as Mechanics::report_logical_position
+ */
+void StatusSnapshot::build_position(StatusText &t) {
+  const xyze_pos_t lpos = mechanics.position.asLogical();
+  LOOP_XYZE(a) {
+    t.add(' ');
+    t.add(axis_codes[a]);
+    t.add(':');
+    if (lpos[a] >= 0) t.add(' ');
+    t.add(lpos[a], 3);
+  }
+  t.add('\n');
+}
+
+/**
+ * Same text as M408 S0, without the time and the closing brace
+ */
+void StatusSnapshot::build_json(StatusText &t) {
+
+  #if ENABLED(JSON_OUTPUT)
+
+    t.add_P(PSTR("{\"status\":\""));
+    t.add(print_job_counter.isRunning() ? 'P' : print_job_counter.isPaused() ? 'A' : 'I');
+
+    t.add_P(PSTR("\",\"coords\": {\"axesHomed\":["));
+    t.add_P(mechanics.isHomedAll() ? PSTR("1, 1, 1") : PSTR("0, 0, 0"));
+
+    t.add_P(PSTR("],\"extr\":["));
+    t.add(mechanics.position.e, 2);
+    t.add_P(PSTR("],\"xyz\":["));
+    t.add(mechanics.position.x, 2);
+    t.add(',');
+    t.add(mechanics.position.y, 2);
+    t.add(',');
+    t.add(mechanics.position.z, 2);
+
+    t.add_P(PSTR("]},\"currentTool\":"));
+    t.add(uint8_t(toolManager.extruder.active));
+
+    #if HAS_POWER_SWITCH
+      t.add_P(PSTR(",\"params\": {\"atxPower\":"));
+      t.add(powerManager.is_on() ? '1' : '0');
+    #else
+      t.add_P(PSTR(",\"params\": {\"NormPower\":"));
+    #endif
+
+    #if HAS_FAN
+      t.add_P(PSTR(",\"fanPercent\":["));
+      t.add(fans[0]->speed);
+    #endif
+
+    t.add_P(PSTR("],\"speedFactor\":"));
+    t.add(mechanics.feedrate_percentage);
+
+    t.add_P(PSTR(",\"extrFactors\":["));
+    LOOP_EXTRUDER() {
+      if (e) t.add(',');
+      t.add(extruders[e]->flow_percentage);
+    }
+    t.add_P(PSTR("]},\n"));
+
+    t.add_P(PSTR("\"temps\": {"));
+    #if HAS_BEDS
+      t.add_P(PSTR("\"bed\": {\"current\":"));
+      t.add(beds[0]->deg_current(), 1);
+      t.add_P(PSTR(",\"active\":"));
+      t.add(beds[0]->deg_target());
+      t.add_P(PSTR(",\"state\":"));
+      t.add(beds[0]->deg_target() > 0 ? '2' : '1');
+      t.add_P(PSTR("},"));
+    #endif
+
+    t.add_P(PSTR("\"heads\": {\"current\":["));
+    #if HAS_HOTENDS
+      LOOP_HOTEND() {
+        if (h) t.add(',');
+        t.add(hotends[h]->deg_current(), 1);
+      }
+      t.add_P(PSTR("],\"active\":["));
+      LOOP_HOTEND() {
+        if (h) t.add(',');
+        t.add(hotends[h]->deg_target());
+      }
+      t.add_P(PSTR("],\"state\":["));
+      LOOP_HOTEND() {
+        if (h) t.add(',');
+        t.add(hotends[h]->deg_target() > HOTEND_AUTO_FAN_TEMPERATURE ? '2' : '1');
+      }
+    #else
+      t.add_P(PSTR("],\"active\":[],\"state\":["));
+    #endif
+    t.add_P(PSTR("]}}"));
+
+  #else
+
+    UNUSED(t);
+
+  #endif
+
+}
+
+#endif // ENABLED(STATUS_SNAPSHOT)
@@ -0,0 +1,140 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * status_snapshot.h - Pre-serialized status reports for the host
+ *
+ * The text of M105, M114 and M408 is built in a buffer only if the values it
+ * shows are changed, and for auto-reports at most once per STATUS_SNAPSHOT_PERIOD.
+ * Each request, or auto-report, sends the buffer with a single write.
+ * A text that does not fit its buffer is reported as an error, never sent cut.
+ */
+
+#if ENABLED(STATUS_SNAPSHOT)
+
+enum SnapshotEnum : uint8_t { SNAPSHOT_TEMP, SNAPSHOT_POSITION, SNAPSHOT_JSON, SNAPSHOT_COUNT };
+
+class StatusText {
+
+  public: /** Constructor */
+
+    StatusText(char * const buf, const uint16_t buf_size) : size(buf_size), buffer(buf) {}
+
+  public: /** Public Parameters */
+
+    uint16_t  length      = 0;
+    uint32_t  fingerprint = 0;      // Hash of the values shown in the text
+    bool      valid       = false,
+              overflow    = false;  // The text was longer than the buffer
+
+    const uint16_t  size;
+
+  private: /** Private Parameters */
+
+    char * const    buffer;
+
+  public: /** Public Function */
+
+    FORCE_INLINE void clear() { length = 0; overflow = false; }
+
+    void add(const char c);
+    void add_P(PGM_P str);
+    void add(const int32_t value);
+    void add(const float value, const uint8_t digits);
+
+    FORCE_INLINE void add(const int16_t value)  { add(int32_t(value)); }
+    FORCE_INLINE void add(const uint8_t value)  { add(int32_t(value)); }
+
+    // Send all the text with one write
+    FORCE_INLINE void write() const { SERIAL_BUF(buffer, length); }
+
+};
+
+class StatusSnapshot {
+
+  public: /** Constructor */
+
+    StatusSnapshot() {}
+
+  public: /** Public Parameters */
+
+    static uint16_t auto_report_ms[SNAPSHOT_COUNT];
+
+  private: /** Private Parameters */
+
+    static StatusText text[SNAPSHOT_COUNT];
+
+    static short_timer_t  refresh_timer[SNAPSHOT_COUNT],
+                          auto_report_timer[SNAPSHOT_COUNT];
+
+    static uint8_t  pending,    // Auto-reports due but not sent
+                    deferred;   // Auto-reports waiting for TX space
+
+  public: /** Public Function */
+
+    /**
+     * Send the auto-reports that are due. Called by idle()
+     * While moving, a report is held back until the TX buffer has room for it.
+     */
+    static void spin();
+
+    /**
+     * Send a report, refreshing it first if needed
+     */
+    static void report(const SnapshotEnum s);
+
+    /**
+     * Set auto-report interval in milliseconds, 0 to disable
+     * The timers are 16 bit, longer intervals are rejected with an error.
+     */
+    static bool set_auto_report(const SnapshotEnum s, const millis_l ms);
+
+    /**
+     * Invalidate all reports, i.e. after a change of configuration
+     */
+    static void invalidate();
+
+  private: /** Private Function */
+
+    /**
+     * Rebuild the text if needed, false if it did not fit the buffer
+     */
+    static bool refresh(const SnapshotEnum s, const bool request);
+
+    static uint32_t fingerprint_temp();
+    static uint32_t fingerprint_position();
+    static uint32_t fingerprint_json();
+
+    static void build_temp(StatusText &t);
+    static void build_position(StatusText &t);
+    static void build_json(StatusText &t);
+
+    #if HAS_HEATER
+      static void build_heater(StatusText &t, Heater* act, const bool print_ID);
+    #endif
+
+};
+
+extern StatusSnapshot statusSnapshot;
+
+#endif // ENABLED(STATUS_SNAPSHOT)
@@ -0,0 +1,40 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+// Temperature history
+#if ENABLED(TEMP_HISTORY)
+  #if DISABLED(TEMP_HISTORY_SAMPLES) || DISABLED(TEMP_HISTORY_PERIOD)
+    #error "DEPENDENCY ERROR: Missing setting TEMP_HISTORY_SAMPLES or TEMP_HISTORY_PERIOD."
+  #elif TEMP_HISTORY_PERIOD < 100 || TEMP_HISTORY_PERIOD > 25500
+    #error "DEPENDENCY ERROR: TEMP_HISTORY_PERIOD must be between 100 and 25500 ms."
+  #endif
+  #if !HAS_HEATER
+    #error "DEPENDENCY ERROR: TEMP_HISTORY requires at least one heater."
+  #endif
+#endif
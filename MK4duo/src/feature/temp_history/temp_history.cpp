@@ -0,0 +1,330 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * temp_history.cpp - Temperature history of the heaters
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(TEMP_HISTORY)
+
+#define TEMP_HISTORY_ROW_SIZE (12 + 16 * (TEMP_HISTORY_HEATERS))
+
+TempHistory tempHistory;
+
+/** Private Parameters */
+temp_history_sample_t TempHistory::ring[TEMP_HISTORY_SAMPLES][TEMP_HISTORY_HEATERS];
+
+int16_t   TempHistory::base_temp[TEMP_HISTORY_HEATERS]    = { 0 },
+          TempHistory::base_target[TEMP_HISTORY_HEATERS]  = { 0 },
+          TempHistory::last_temp[TEMP_HISTORY_HEATERS]    = { 0 },
+          TempHistory::last_target[TEMP_HISTORY_HEATERS]  = { 0 };
+
+uint32_t  TempHistory::sequence     = 0;
+
+uint16_t  TempHistory::head         = 0,
+          TempHistory::count        = 0;
+
+uint8_t   TempHistory::heaters      = 0,
+          TempHistory::period_count = 0;
+
+#if HAS_SD_SUPPORT
+  SdFile    TempHistory::log_file;
+  uint32_t  TempHistory::logged     = 0;
+  int16_t   TempHistory::log_temp[TEMP_HISTORY_HEATERS]   = { 0 },
+            TempHistory::log_target[TEMP_HISTORY_HEATERS] = { 0 };
+#endif
+
+/** Public Function */
+void TempHistory::spin() {
+
+  if (++period_count < (TEMP_HISTORY_PERIOD) / 100) return;
+  period_count = 0;
+
+  Heater* list[TEMP_HISTORY_HEATERS];
+  const uint8_t n = get_heaters(list);
+  if (n != heaters) {
+    clear();
+    heaters = n;
+  }
+
+  // The first sample is its own base, when full the oldest sample goes into the base
+  if (count == 0) {
+    for (uint8_t i = 0; i < n; i++) {
+      base_temp[i]    = last_temp[i]    = LROUND(list[i]->current_temperature * 4.0f);
+      base_target[i]  = last_target[i]  = list[i]->target_temperature;
+    }
+  }
+  else if (count == TEMP_HISTORY_SAMPLES) {
+    for (uint8_t i = 0; i < n; i++) {
+      base_temp[i]   += ring[head][i].temp;
+      base_target[i] += ring[head][i].target;
+    }
+  }
+
+  temp_history_sample_t * const sample = ring[head];
+  for (uint8_t i = 0; i < n; i++) {
+    const int16_t temp = LROUND(list[i]->current_temperature * 4.0f);
+    sample[i].temp    = constrain(temp - last_temp[i], -127, 127);
+    sample[i].target  = constrain(list[i]->target_temperature - last_target[i], -127, 127);
+    sample[i].pwm     = list[i]->pwm_value;
+    last_temp[i]     += sample[i].temp;
+    last_target[i]   += sample[i].target;
+  }
+
+  if (++head == TEMP_HISTORY_SAMPLES) head = 0;
+  if (count < TEMP_HISTORY_SAMPLES) count++;
+  sequence++;
+
+}
+
+void TempHistory::idle() {
+
+  #if HAS_SD_SUPPORT
+
+    if (!log_file.isOpen()) return;
+
+    temp_history_sample_t sample[TEMP_HISTORY_HEATERS];
+    uint8_t pwm[TEMP_HISTORY_HEATERS];
+    char row[TEMP_HISTORY_ROW_SIZE];
+    uint8_t rows = 0;
+
+    for (; rows < TEMP_HISTORY_LOG_ROWS; rows++) {
+
+      CRITICAL_SECTION_START();
+      const uint32_t seq = sequence;
+      // Samples gone from the ring are lost, go on from the values before the oldest one
+      if (seq - logged >= count) {
+        logged = seq - count;
+        for (uint8_t i = 0; i < heaters; i++) {
+          log_temp[i]   = base_temp[i];
+          log_target[i] = base_target[i];
+        }
+      }
+      const bool found = logged != seq && get_sample(logged + 1, sample);
+      CRITICAL_SECTION_END();
+
+      if (!found) break;
+
+      for (uint8_t i = 0; i < heaters; i++) {
+        log_temp[i]   += sample[i].temp;
+        log_target[i] += sample[i].target;
+        pwm[i]         = sample[i].pwm;
+      }
+
+      const uint8_t len = print_row(row, logged, log_temp, log_target, pwm);
+      if (log_file.write(row, len) != len) {
+        SERIAL_LM(ER, STR_TEMP_HISTORY_LOG_FAILED);
+        stop_log();
+        return;
+      }
+      logged++;
+      if (!(logged & 0x0F)) log_file.sync();
+
+    }
+
+    if (rows > 1) log_file.sync();
+
+  #endif
+
+}
+
+void TempHistory::clear() {
+  CRITICAL_SECTION_START();
+  head = count = 0;
+  sequence = 0;
+  CRITICAL_SECTION_END();
+  #if HAS_SD_SUPPORT
+    logged = 0;
+  #endif
+}
+
+/**
+ * CSV: a header with the period and the heaters, then one row for each sample:
+ * sequence, then temperature, target and PWM of each heater
+ */
+void TempHistory::dump_csv() {
+
+  char row[TEMP_HISTORY_ROW_SIZE];
+
+  temp_history_sample_t sample[TEMP_HISTORY_HEATERS];
+  int16_t temp[TEMP_HISTORY_HEATERS],
+          target[TEMP_HISTORY_HEATERS];
+  uint8_t pwm[TEMP_HISTORY_HEATERS];
+
+  print_header(row);
+  SERIAL_TXT(row);
+
+  CRITICAL_SECTION_START();
+  const uint32_t first = sequence - count;
+  const uint16_t samples = count;
+  for (uint8_t i = 0; i < heaters; i++) {
+    temp[i]   = base_temp[i];
+    target[i] = base_target[i];
+  }
+  CRITICAL_SECTION_END();
+
+  for (uint16_t s = 0; s < samples; s++) {
+    CRITICAL_SECTION_START();
+    const bool found = get_sample(first + s + 1, sample);
+    CRITICAL_SECTION_END();
+    if (!found) {
+      SERIAL_LM(ER, STR_TEMP_HISTORY_OVERRUN);
+      return;
+    }
+    for (uint8_t i = 0; i < heaters; i++) {
+      temp[i]   += sample[i].temp;
+      target[i] += sample[i].target;
+      pwm[i]     = sample[i].pwm;
+    }
+    print_row(row, first + s, temp, target, pwm);
+    SERIAL_TXT(row);
+  }
+
+}
+
+/**
+ * Encoded: THB:<first sequence>,<samples>,<heaters>,<period ms>
+ * then the base temperature (1/4 C) and target of each heater,
+ * then one line of hex bytes (temp, target, pwm for each heater) for each sample
+ */
+void TempHistory::dump_encoded() {
+
+  temp_history_sample_t sample[TEMP_HISTORY_HEATERS];
+  int16_t temp[TEMP_HISTORY_HEATERS],
+          target[TEMP_HISTORY_HEATERS];
+
+  CRITICAL_SECTION_START();
+  const uint32_t first = sequence - count;
+  const uint16_t samples = count;
+  for (uint8_t i = 0; i < heaters; i++) {
+    temp[i]   = base_temp[i];
+    target[i] = base_target[i];
+  }
+  CRITICAL_SECTION_END();
+
+  SERIAL_PRINTF("THB:%lu,%u,%u,%u\n", (unsigned long)first, samples, heaters, (uint16_t)(TEMP_HISTORY_PERIOD));
+  for (uint8_t i = 0; i < heaters; i++) SERIAL_PRINTF(i ? ",%i,%i" : "%i,%i", temp[i], target[i]);
+  SERIAL_EOL();
+
+  for (uint16_t s = 0; s < samples; s++) {
+    CRITICAL_SECTION_START();
+    const bool found = get_sample(first + s + 1, sample);
+    CRITICAL_SECTION_END();
+    if (!found) {
+      SERIAL_LM(ER, STR_TEMP_HISTORY_OVERRUN);
+      return;
+    }
+    const uint8_t * const data = (const uint8_t*)sample;
+    for (uint8_t b = 0; b < heaters * sizeof(temp_history_sample_t); b++) SERIAL_PRINTF("%02X", data[b]);
+    SERIAL_EOL();
+  }
+
+}
+
+#if HAS_SD_SUPPORT
+
+  void TempHistory::start_log() {
+    if (!card.isMounted()) {
+      SERIAL_LM(ER, STR_SD_INIT_FAIL);
+      return;
+    }
+    if (log_file.isOpen()) return;
+    if (!log_file.open(card.fat.vwd(), TEMP_HISTORY_FILE, O_WRITE | O_CREAT | O_APPEND)) {
+      SERIAL_LMT(ER, STR_SD_OPEN_FILE_FAIL, TEMP_HISTORY_FILE);
+      return;
+    }
+    char row[TEMP_HISTORY_ROW_SIZE];
+    log_file.write(row, print_header(row));
+    CRITICAL_SECTION_START();
+    logged = sequence;
+    for (uint8_t i = 0; i < heaters; i++) {
+      log_temp[i]   = last_temp[i];
+      log_target[i] = last_target[i];
+    }
+    CRITICAL_SECTION_END();
+    SERIAL_LMT(ECHO, STR_SD_WRITE_TO_FILE, TEMP_HISTORY_FILE);
+  }
+
+  void TempHistory::stop_log() {
+    if (!log_file.isOpen()) return;
+    log_file.sync();
+    log_file.close();
+    SERIAL_LM(ECHO, STR_SD_FILE_SAVED);
+  }
+
+#endif
+
+/** Private Function */
+uint8_t TempHistory::get_heaters(Heater* list[]) {
+  uint8_t n = 0;
+  #if HAS_HOTENDS
+    LOOP_HOTEND() list[n++] = hotends[h];
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() list[n++] = beds[h];
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() list[n++] = chambers[h];
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() list[n++] = coolers[h];
+  #endif
+  return n;
+}
+
+// Copy the sample number seq (1 is the first since clear), false if it is not in the ring
+bool TempHistory::get_sample(const uint32_t seq, temp_history_sample_t sample[]) {
+  const uint32_t age = sequence - seq;   // 0 for the newest sample
+  if (seq == 0 || age >= count) return false;
+  const uint16_t index = (head + TEMP_HISTORY_SAMPLES - 1 - age) % TEMP_HISTORY_SAMPLES;
+  memcpy(sample, ring[index], heaters * sizeof(temp_history_sample_t));
+  return true;
+}
+
+uint8_t TempHistory::print_header(char * const buf) {
+  Heater* list[TEMP_HISTORY_HEATERS];
+  get_heaters(list);
+  char *p = buf + sprintf_P(buf, PSTR("TH:%u"), (uint16_t)(TEMP_HISTORY_PERIOD));
+  for (uint8_t i = 0; i < heaters; i++) {
+    const char prefix = list[i]->type == IS_BED ? 'B' : list[i]->type == IS_CHAMBER ? 'C' : list[i]->type == IS_COOLER ? 'W' : 'T';
+    p += sprintf_P(p, PSTR(",%c%u,target,pwm"), prefix, list[i]->data.ID);
+  }
+  *p++ = '\n';
+  *p = '\0';
+  return p - buf;
+}
+
+uint8_t TempHistory::print_row(char * const buf, const uint32_t seq, const int16_t temp[], const int16_t target[], const uint8_t pwm[]) {
+  char *p = buf + sprintf_P(buf, PSTR("%lu"), (unsigned long)seq);
+  for (uint8_t i = 0; i < heaters; i++) {
+    const uint16_t quarter = ABS(temp[i]);
+    p += sprintf_P(p, PSTR(",%s%u.%02u,%i,%u"), temp[i] < 0 ? "-" : "", quarter >> 2, (quarter & 3) * 25, target[i], pwm[i]);
+  }
+  *p++ = '\n';
+  *p = '\0';
+  return p - buf;
+}
+
+#endif // ENABLED(TEMP_HISTORY)
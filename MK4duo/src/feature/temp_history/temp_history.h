@@ -0,0 +1,118 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * temp_history.h - Temperature history of the heaters
+ *
+ * Every TEMP_HISTORY_PERIOD the temperature, target and PWM of each heater
+ * are stored in a ring of TEMP_HISTORY_SAMPLES samples, three bytes each:
+ * temperature and target as the difference from the previous sample,
+ * larger steps are spread over the following samples.
+ * M156 dumps the ring as CSV or as the encoded bytes, and can stream every
+ * new sample to a CSV file on the SD.
+ * Sampling goes on during a dump, a host so slow that the ring wraps under
+ * the dump gets an error line at the point of the wrap.
+ * A log that falls behind catches up from the ring, TEMP_HISTORY_LOG_ROWS
+ * rows per idle, samples already gone from the ring leave a gap in the
+ * sequence column.
+ */
+
+#if ENABLED(TEMP_HISTORY)
+
+#define TEMP_HISTORY_HEATERS  ((MAX_HOTEND) + (MAX_BED) + (MAX_CHAMBER) + (MAX_COOLER))
+#define TEMP_HISTORY_FILE     "temphist.csv"
+#define TEMP_HISTORY_LOG_ROWS 4   // Rows written to the SD log in one idle()
+
+struct temp_history_sample_t {
+  int8_t  temp,   // (1/4 C) Change from the previous sample
+          target; // (C)     Change from the previous sample
+  uint8_t pwm;
+};
+
+class TempHistory {
+
+  public: /** Constructor */
+
+    TempHistory() {}
+
+  private: /** Private Parameters */
+
+    static temp_history_sample_t ring[TEMP_HISTORY_SAMPLES][TEMP_HISTORY_HEATERS];
+
+    static int16_t  base_temp[TEMP_HISTORY_HEATERS],    // Values before the oldest sample
+                    base_target[TEMP_HISTORY_HEATERS],
+                    last_temp[TEMP_HISTORY_HEATERS],    // Values of the newest sample
+                    last_target[TEMP_HISTORY_HEATERS];
+
+    static uint32_t sequence;   // Number of samples taken since clear
+
+    static uint16_t head,
+                    count;
+
+    static uint8_t  heaters,
+                    period_count;
+
+    #if HAS_SD_SUPPORT
+      static SdFile   log_file;
+      static uint32_t logged;   // Sequence of the last sample written to the log
+      static int16_t  log_temp[TEMP_HISTORY_HEATERS],   // Values of the last sample written to the log
+                      log_target[TEMP_HISTORY_HEATERS];
+    #endif
+
+  public: /** Public Function */
+
+    /**
+     * Take a sample every TEMP_HISTORY_PERIOD, called from TempManager::spin()
+     */
+    static void spin();
+
+    /**
+     * Write the samples not yet logged to the SD log, called by idle()
+     */
+    static void idle();
+
+    static void clear();
+
+    static void dump_csv();
+    static void dump_encoded();
+
+    #if HAS_SD_SUPPORT
+      static void start_log();
+      static void stop_log();
+      FORCE_INLINE static bool isLogging() { return log_file.isOpen(); }
+    #endif
+
+  private: /** Private Function */
+
+    static uint8_t get_heaters(Heater* list[]);
+
+    static bool get_sample(const uint32_t seq, temp_history_sample_t sample[]);
+
+    static uint8_t print_header(char * const buf);
+    static uint8_t print_row(char * const buf, const uint32_t seq, const int16_t temp[], const int16_t target[], const uint8_t pwm[]);
+
+};
+
+extern TempHistory tempHistory;
+
+#endif // ENABLED(TEMP_HISTORY)
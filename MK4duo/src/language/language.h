@@ -150,6 +150,8 @@
 #define STR_INVALID_EXTRUDER              "Invalid extruder"
 #define STR_INVALID_DRIVER                "Invalid driver"
 #define STR_INVALID_HOTEND                "Invalid hotend"
+#define STR_FAN_STALLED                   "Fan stalled: "
+#define STR_FAN_NO_TACHO                  "Fan without tachometer pin, no RPM control"
 #define STR_INVALID_HEATER                "Invalid heater"
 #define STR_INVALID_SOLENOID              "Invalid solenoid"
 #define STR_ERR_NO_THERMISTORS            "No thermistors - no temperature"
@@ -268,6 +270,18 @@
 #define STR_PID_TEMP_TOO_HIGH             STR_PID_AUTOTUNE_FAILED " Temperature too high"
 #define STR_PID_TEMP_TOO_LOW              STR_PID_AUTOTUNE_FAILED " Temperature too low"
 #define STR_PID_TIMEOUT                   STR_PID_AUTOTUNE_FAILED " timeout"
+#define STR_MPC_AUTOTUNE_PREFIX           "MPC Autotune"
+#define STR_MPC_AUTOTUNE_START            STR_MPC_AUTOTUNE_PREFIX " start"
+#define STR_MPC_AUTOTUNE_FAILED           STR_MPC_AUTOTUNE_PREFIX " failed!"
+#define STR_MPC_AUTOTUNE_FINISHED         STR_MPC_AUTOTUNE_PREFIX " finished!"
+#define STR_MPC_AUTOTUNE_INTERRUPTED      STR_MPC_AUTOTUNE_PREFIX " interrupted!"
+#define STR_MPC_COOLING_TO_AMBIENT        " Cooling to ambient"
+#define STR_MPC_HEATING_PAST_TARGET       " Heating to target"
+#define STR_MPC_MEASURING_LOSSES          " Measuring ambient heat loss"
+#define STR_HEATUP_READY_IN               "Heat-up ready in (s): "
+#define STR_HEATUP_ESTIMATING             "Heat-up estimating ready time"
+#define STR_TEMP_HISTORY_LOG_FAILED       "Temperature history write failed, log closed"
+#define STR_TEMP_HISTORY_OVERRUN          "Temperature history overwritten during the dump, dump stopped"
 #define STR_BIAS                          " bias:"
 #define STR_D                             " d:"
 #define STR_T_MIN                         " min:"
@@ -57,6 +57,9 @@ class FixedMatrix : public MathMatrix<T> {
 
     bool GaussJordan(uint8_t numRows, uint8_t numCols);
 
+    template<uint8_t N>
+    bool LeastSquares(uint8_t numRows, uint8_t numCols, const T rhs[], T solution[], FixedMatrix<T, N, N + 1> &normal) const;
+
     T* GetRow(uint8_t r) { return data[r]; }
 
     const T* GetRow(uint8_t r) const { return data[r]; }
@@ -117,6 +120,35 @@ bool FixedMatrix<T, ROWS, COLS>::GaussJordan(uint8_t numRows, uint8_t numCols) {
   return true;
 }
 
+// Solve the overdetermined system (numRows x numCols of this matrix) * solution = rhs in the least squares sense.
+// The normal equations are built in 'normal' and solved there, so the caller can inspect them afterwards.
+template<class T, uint8_t ROWS, uint8_t COLS>
+template<uint8_t N>
+bool FixedMatrix<T, ROWS, COLS>::LeastSquares(uint8_t numRows, uint8_t numCols, const T rhs[], T solution[], FixedMatrix<T, N, N + 1> &normal) const {
+  if (numCols > N || numRows < numCols) return false;
+
+  for (uint8_t i = 0; i < numCols; ++i) {
+    // The normal matrix is symmetric, so compute only the upper triangle
+    for (uint8_t j = i; j < numCols; ++j) {
+      T temp = (T)0.0;
+      for (uint8_t k = 0; k < numRows; ++k)
+        temp += data[k][i] * data[k][j];
+      normal(i, j) = normal(j, i) = temp;
+    }
+    T temp = (T)0.0;
+    for (uint8_t k = 0; k < numRows; ++k)
+      temp += data[k][i] * rhs[k];
+    normal(i, numCols) = temp;
+  }
+
+  if (!normal.GaussJordan(numCols, numCols + 1)) return false;
+
+  for (uint8_t i = 0; i < numCols; ++i)
+    solution[i] = normal(i, numCols);
+
+  return true;
+}
+
 // Set all elements to a specified value
 template<class T, uint8_t ROWS, uint8_t COLS>
 void FixedMatrix<T, ROWS, COLS>::Fill(T val) {
@@ -0,0 +1,91 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * running_stats.h - streaming mean and variance (Welford)
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * Samples are folded in one at a time, so no sample set is kept and
+ * mean and deviation are known after every sample.
+ */
+
+class running_stats {
+
+  public: /** Constructor */
+
+    running_stats() { reset(); }
+
+  private: /** Private Parameters */
+
+    uint16_t  n, rejects;
+    float     m, m2, lo, hi;
+
+  public: /** Public Function */
+
+    void reset() { n = rejects = 0; m = m2 = 0.0f; lo = 99999.9f; hi = -99999.9f; }
+
+    void add(const float v) {
+      n++;
+      const float d = v - m;
+      m += d / n;
+      m2 += d * (v - m);
+      NOMORE(lo, v);
+      NOLESS(hi, v);
+    }
+
+    /**
+     * A sample further than k deviations from the mean is an outlier.
+     * The deviation is at least min_sigma, so a tight set does not reject everything.
+     * Needs 3 samples before it can tell.
+     */
+    bool is_outlier(const float v, const float k, const float min_sigma=0.0f) const {
+      return k > 0.0f && n >= 3 && ABS(v - m) > k * MAX(sample_sigma(), min_sigma);
+    }
+
+    // Add the sample unless it is an outlier. Return false if rejected.
+    bool add_filtered(const float v, const float k, const float min_sigma=0.0f) {
+      if (is_outlier(v, k, min_sigma)) { rejects++; return false; }
+      add(v);
+      return true;
+    }
+
+    uint16_t count()          const { return n; }
+    uint16_t rejected()       const { return rejects; }
+    float mean()              const { return m; }
+    float minimum()           const { return lo; }
+    float maximum()           const { return hi; }
+    float range()             const { return n ? hi - lo : 0.0f; }
+
+    // Population deviation of the samples seen
+    float sigma()             const { return n ? SQRT(m2 / n) : 0.0f; }
+
+    // Estimated deviation of the source
+    float sample_sigma()      const { return n > 1 ? SQRT(m2 / (n - 1)) : 0.0f; }
+
+    // Standard error of the mean, the confidence of the result
+    float std_error()         const { return n > 1 ? sample_sigma() / SQRT(n) : 0.0f; }
+
+    // True once at least min_count samples agree within limit
+    bool settled(const float limit, const uint16_t min_count=2) const { return n >= min_count && sample_sigma() <= limit; }
+
+};
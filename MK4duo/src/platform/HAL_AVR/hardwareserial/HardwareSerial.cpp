@@ -52,6 +52,9 @@ template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_dropped_bytes = 0;
 template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_buffer_overruns = 0;
 template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_framing_errors = 0;
 template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::rx_max_enqueued = 0;
+template<typename Cfg> uint32_t MKHardwareSerial<Cfg>::tx_blocked_time = 0;
+template<typename Cfg> EmergencyStateEnum MKHardwareSerial<Cfg>::emergency_state = EP_RESET;
+template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::rx_scanned = 0;
 template<typename Cfg> volatile bool MKHardwareSerial<Cfg>::rx_tail_value_not_stable = false;
 template<typename Cfg> volatile uint16_t MKHardwareSerial<Cfg>::rx_tail_value_backup = 0;
 
@@ -247,7 +250,11 @@ void MKHardwareSerial<Cfg>::write(const uint8_t c) {
   if (Cfg::TX_SIZE == 0) {
 
     _written = true;
-    while (!B_UDRE) sw_barrier();
+    if (!B_UDRE) {
+      const uint32_t start = Cfg::TX_BLOCKED ? micros() : 0;
+      while (!B_UDRE) sw_barrier();
+      if (Cfg::TX_BLOCKED) tx_blocked_time += micros() - start;
+    }
     R_UDR = c;
 
   }
@@ -287,9 +294,11 @@ void MKHardwareSerial<Cfg>::write(const uint8_t c) {
         sw_barrier();
       }
     }
-    else {
+    else if (i == tx_buffer.tail) {
       // Interrupts are enabled, just wait until there is space
+      const uint32_t start = Cfg::TX_BLOCKED ? micros() : 0;
       while (i == tx_buffer.tail) sw_barrier();
+      if (Cfg::TX_BLOCKED) tx_blocked_time += micros() - start;
     }
 
     // Store new char. head is always safe to move
@@ -301,6 +310,49 @@ void MKHardwareSerial<Cfg>::write(const uint8_t c) {
   }
 }
 
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::write(const uint8_t* buffer, size_t size) {
+
+  if (Cfg::TX_SIZE == 0 || !ISRS_ENABLED()) {
+    while (size--) write(*buffer++);
+    return;
+  }
+
+  _written = true;
+
+  while (size) {
+
+    uint8_t n = MIN(size, size_t(tx_free()));
+
+    // The ring is full, wait for one byte of space
+    if (!n) {
+      write(*buffer++);
+      size--;
+      continue;
+    }
+
+    // Copy all that fits in the ring, then kick the TX ISR once
+    size -= n;
+    uint8_t h = tx_buffer.head;
+    while (n--) {
+      tx_buffer.buffer[h] = *buffer++;
+      h = (h + 1) & (Cfg::TX_SIZE - 1);
+    }
+    tx_buffer.head = h;
+
+    // Enable TX ISR - Non atomic, but it will eventually enable TX ISR
+    B_UDRIE = 1;
+  }
+
+}
+
+template<typename Cfg>
+uint16_t MKHardwareSerial<Cfg>::tx_free() {
+  // Without TX buffer only the data register can take a byte
+  if (Cfg::TX_SIZE == 0) return B_UDRE ? 1 : 0;
+  return (uint8_t)(tx_buffer.tail - tx_buffer.head - 1) & (Cfg::TX_SIZE - 1);
+}
+
 template<typename Cfg>
 void MKHardwareSerial<Cfg>::flushTX() {
 
@@ -368,12 +420,24 @@ size_t MKHardwareSerial<Cfg>::readBytes(char* buffer, size_t size) {
 
 }
 
+// Feed the bytes stored since the last scan to the emergency parser in one or
+// two chunks (when the ring wraps). Called from the RX ISR only.
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::emergency_scan(const ring_buffer_pos_t h) {
+  ring_buffer_pos_t s = rx_scanned;
+  if (s == h) return;
+  if (h < s) {
+    emergency_parser.update(emergency_state, rx_buffer.buffer + s, Cfg::RX_SIZE - s);
+    s = 0;
+  }
+  emergency_parser.update(emergency_state, rx_buffer.buffer + s, h - s);
+  rx_scanned = h;
+}
+
 // (called with RX interrupts disabled)
 template<typename Cfg>
 FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
 
-  static EmergencyStateEnum emergency_state; // = EP_RESET
-
   // Get the tail - Nothing can alter its value while this ISR is executing, but there's
   // a chance that this ISR interrupted the main process while it was updating the index.
   // The backup mechanism ensures the correct value is always returned.
@@ -393,8 +457,6 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
   // Read the character from the USART
   uint8_t c = R_UDR;
 
-  if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
-
   // If the character is to be stored at the index just before the tail
   // (such that the head would advance to the current tail), the RX FIFO is
   // full, so don't write the character or advance the head.
@@ -402,8 +464,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
     rx_buffer.buffer[h] = c;
     h = i;
   }
-  else if (Cfg::DROPPED_RX && !++rx_dropped_bytes)
-    --rx_dropped_bytes;
+  else {
+    // The byte is lost, scan what is stored and then the byte itself
+    if (Cfg::EMERGENCYPARSER) {
+      emergency_scan(h);
+      emergency_parser.update(emergency_state, c);
+    }
+    if (Cfg::DROPPED_RX && !++rx_dropped_bytes) --rx_dropped_bytes;
+  }
 
   if (Cfg::MAX_RX_QUEUED) {
     // Calculate count of bytes stored into the RX buffer
@@ -447,7 +515,6 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = R_UDR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
@@ -456,8 +523,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
               rx_buffer.buffer[h] = c;
               h = i;
             }
-            else if (Cfg::DROPPED_RX && !++rx_dropped_bytes)
-              --rx_dropped_bytes;
+            else {
+              // The byte is lost, scan what is stored and then the byte itself
+              if (Cfg::EMERGENCYPARSER) {
+                emergency_scan(h);
+                emergency_parser.update(emergency_state, c);
+              }
+              if (Cfg::DROPPED_RX && !++rx_dropped_bytes) --rx_dropped_bytes;
+            }
           }
           sw_barrier();
         }
@@ -486,7 +559,6 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = R_UDR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
@@ -495,8 +567,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
               rx_buffer.buffer[h] = c;
               h = i;
             }
-            else if (Cfg::DROPPED_RX && !++rx_dropped_bytes)
-              --rx_dropped_bytes;
+            else {
+              // The byte is lost, scan what is stored and then the byte itself
+              if (Cfg::EMERGENCYPARSER) {
+                emergency_scan(h);
+                emergency_parser.update(emergency_state, c);
+              }
+              if (Cfg::DROPPED_RX && !++rx_dropped_bytes) --rx_dropped_bytes;
+            }
           }
           sw_barrier();
         }
@@ -507,6 +585,10 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
     }
   }
 
+  // Scan the new bytes at end of line, or before they could be overwritten
+  if (Cfg::EMERGENCYPARSER && (c == '\n' || (ring_buffer_pos_t(h - rx_scanned) & (Cfg::RX_SIZE - 1)) >= Cfg::RX_SIZE / 2))
+    emergency_scan(h);
+
   // Store the new head value - The main loop will retry until the value is stable
   rx_buffer.head = h;
 }
@@ -63,30 +63,12 @@
 uint8_t MCUSR;
 
 /** Private Parameters */
-#if HAS_HOTENDS
-  ADCAveragingFilter HAL::HOTENDsensorFilters[MAX_HOTEND];
-#endif
-#if HAS_BEDS
-  ADCAveragingFilter HAL::BEDsensorFilters[MAX_BED];
-#endif
-#if HAS_CHAMBERS
-  ADCAveragingFilter HAL::CHAMBERsensorFilters[MAX_CHAMBER];
-#endif
-#if HAS_COOLERS
-  ADCAveragingFilter HAL::COOLERsensorFilters[MAX_COOLER];
-#endif
-
-#if ENABLED(FILAMENT_WIDTH_SENSOR)
-  ADCAveragingFilter  HAL::filamentFilter;
-#endif
-
-#if HAS_POWER_CONSUMPTION_SENSOR
-  ADCAveragingFilter  HAL::powerFilter;
-#endif
-
-#if HAS_MCU_TEMPERATURE
-  ADCAveragingFilter  HAL::mcuFilter;
-#endif
+uint16_t  HAL::adc_dma_buffer[2][ADC_DMA_BUFFER_SIZE],
+          HAL::adc_sample_count[NUM_ANALOG_INPUTS]  = { 0 },
+          HAL::adc_value[NUM_ANALOG_INPUTS]         = { 0 },
+          HAL::adc_valid_mask                       = 0;
+uint32_t  HAL::adc_sample_sum[NUM_ANALOG_INPUTS]    = { 0 };
+uint8_t   HAL::adc_dma_index                        = 0;
 
 __attribute__ ((aligned(256)))
 static DeviceVectors ram_tab = { NULL };
@@ -200,17 +182,6 @@ adc_channel_num_t PinToAdcChannel(pin_t pin) {
   return (adc_channel_num_t)g_APinDescription[pin].ulADCChannelNumber;
 }
 
-// Start converting the enabled channels
-void AnalogInStartConversion() {
-  // Clear out any existing conversion complete bits in the status register
-  for (uint32_t chan = 0; chan < 16; ++chan) {
-    if ((adc_get_status(ADC) & (1 << chan)) != 0) {
-      (void)adc_get_channel_value(ADC, static_cast<adc_channel_num_t>(chan));
-    }
-  }
-  ADC->ADC_CR = ADC_CR_START;
-}
-
 // Enable or disable a channel.
 void AnalogInEnablePin(const pin_t r_pin, const bool enable) {
   adc_channel_num_t adc_ch = PinToAdcChannel(r_pin);
@@ -228,14 +199,56 @@ void AnalogInEnablePin(const pin_t r_pin, const bool enable) {
   }
 }   
 
-// Read the most recent 12-bit result from a pin
-uint16_t AnalogInReadPin(const pin_t r_pin) {
+// Read the most recent decimated 12-bit result from a pin, false until the first one is ready
+bool HAL::AnalogInReadPin(const pin_t r_pin, uint16_t &value) {
+  const adc_channel_num_t adc_ch = PinToAdcChannel(r_pin);
+  if ((unsigned int)adc_ch >= NUM_ANALOG_INPUTS || !TEST(adc_valid_mask, adc_ch)) return false;
+  value = adc_value[adc_ch];
+  return true;
+}
 
-  adc_channel_num_t adc_ch = PinToAdcChannel(r_pin);
-  if ((unsigned int)adc_ch < NUM_ANALOG_INPUTS)
-    return adc_get_channel_value(ADC, adc_ch);
-  else
-    return 0;
+// Hand both buffers to the PDC, the ADC runs free and every conversion is stored tagged with its channel
+void HAL::AnalogInDmaStart() {
+  ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+  ADC->ADC_RPR  = (uint32_t)adc_dma_buffer[0];
+  ADC->ADC_RCR  = ADC_DMA_BUFFER_SIZE;
+  ADC->ADC_RNPR = (uint32_t)adc_dma_buffer[1];
+  ADC->ADC_RNCR = ADC_DMA_BUFFER_SIZE;
+  adc_dma_index = 0;
+  ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+}
+
+// Oversample a full buffer: sum NUM_ADC_SAMPLES conversions per channel, then decimate to the average
+void HAL::AnalogInDmaDecimate(const uint16_t *buffer) {
+  for (uint16_t i = 0; i < ADC_DMA_BUFFER_SIZE; i++) {
+    const uint16_t  sample  = buffer[i];
+    const uint8_t   adc_ch  = (sample & ADC_LCDR_CHNB_Msk) >> ADC_LCDR_CHNB_Pos;
+    adc_sample_sum[adc_ch] += sample & ADC_LCDR_LDATA_Msk;
+    if (++adc_sample_count[adc_ch] == NUM_ADC_SAMPLES) {
+      adc_value[adc_ch] = adc_sample_sum[adc_ch] / NUM_ADC_SAMPLES;
+      adc_sample_sum[adc_ch] = 0;
+      adc_sample_count[adc_ch] = 0;
+      SBI(adc_valid_mask, adc_ch);
+    }
+  }
+}
+
+// Decimate every buffer the PDC has filled since the last call and give it back as the next buffer
+void HAL::AnalogInDmaDrain() {
+  if (ADC->ADC_RNCR) return;                  // The PDC is still filling the current buffer
+
+  const bool stalled = ADC->ADC_RCR == 0;     // Both buffers full, the PDC has stopped
+  AnalogInDmaDecimate(adc_dma_buffer[adc_dma_index]);
+
+  if (stalled) {
+    AnalogInDmaDecimate(adc_dma_buffer[adc_dma_index ^ 1]);
+    AnalogInDmaStart();
+  }
+  else {
+    ADC->ADC_RNPR = (uint32_t)adc_dma_buffer[adc_dma_index];
+    ADC->ADC_RNCR = ADC_DMA_BUFFER_SIZE;
+    adc_dma_index ^= 1;
+  }
 }
 
 // Initialize ADC channels
@@ -288,13 +301,13 @@ void HAL::analogStart() {
   #endif
 
   #if ENABLED(FILAMENT_WIDTH_SENSOR)
-    if (WITHIN(FILWIDTH_PIN, 0, 15) {
+    if (WITHIN(FILWIDTH_PIN, 0, 15)) {
       AnalogInEnablePin(FILWIDTH_PIN, true);
     }
   #endif
 
   #if HAS_POWER_CONSUMPTION_SENSOR
-    if (WITHIN(POWER_CONSUMPTION_PIN, 0, 15) {
+    if (WITHIN(POWER_CONSUMPTION_PIN, 0, 15)) {
       AnalogInEnablePin(POWER_CONSUMPTION_PIN, true);
     }
   #endif
@@ -304,31 +317,42 @@ void HAL::analogStart() {
   #endif
 
   // Initialize ADC mode register (some of the following params are not used here)
-  // HW trigger disabled, use external Trigger, 12 bit resolution
-  // core and ref voltage stays on, normal sleep mode, normal not free-run mode
+  // HW trigger disabled, 12 bit resolution
+  // core and ref voltage stays on, normal sleep mode, free-run mode paced by the ADC clock
   // startup time 16 clocks, settling time 17 clocks, no changes on channel switch
   // convert channels in numeric order
   // set prescaler rate  MCK/((PRESCALE+1) * 2)
   // set tracking time  (TRACKTIM+1) * clock periods
   // set transfer period  (TRANSFER * 2 + 3)
   ADC->ADC_MR = ADC_MR_TRGEN_DIS | ADC_MR_TRGSEL_ADC_TRIG0 | ADC_MR_LOWRES_BITS_12 |
-                ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF | ADC_MR_FREERUN_OFF |
+                ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF | ADC_MR_FREERUN_ON |
                 ADC_MR_STARTUP_SUT64 | ADC_MR_SETTLING_AST17 | ADC_MR_ANACH_NONE |
                 ADC_MR_USEQ_NUM_ORDER |
                 ADC_MR_PRESCAL(AD_PRESCALE_FACTOR) |
                 ADC_MR_TRACKTIM(AD_TRACKING_CYCLES) |
                 ADC_MR_TRANSFER(AD_TRANSFER_CYCLES);
 
-  ADC->ADC_IER = 0;             // no ADC interrupts
+  ADC->ADC_EMR = ADC_EMR_TAG;   // channel number in the upper bits of every converted data
+  ADC->ADC_IER = 0;             // no ADC interrupts, the PDC buffers are drained from Tick
   ADC->ADC_COR = 0;             // Single-ended, no offset
 
-  // start first conversion
-  AnalogInStartConversion();
+  // start the PDC, the first conversion is started by free-run mode
+  AnalogInDmaStart();
+  ADC->ADC_CR = ADC_CR_START;
 }
 
 void HAL::AdcChangePin(const pin_t old_pin, const pin_t new_pin) {
   AnalogInEnablePin(old_pin, false);
   AnalogInEnablePin(new_pin, true);
+  // Drop what was accumulated for the new channel, the first value comes from a full set of samples
+  const adc_channel_num_t adc_ch = PinToAdcChannel(new_pin);
+  if ((unsigned int)adc_ch < NUM_ANALOG_INPUTS) {
+    CRITICAL_SECTION_START();
+    adc_sample_sum[adc_ch] = 0;
+    adc_sample_count[adc_ch] = 0;
+    CBI(adc_valid_mask, adc_ch);
+    CRITICAL_SECTION_END();
+  }
 }
 
 // Reset peripherals and cpu
@@ -567,70 +591,64 @@ void HAL::Tick() {
   if (cycle_1s_timer.expired(SECOND_TO_MILLIS(1))) printer.check_periodical_actions();
 
   // Read analog or SPI values
-  if (adc_get_status(ADC)) { // conversion finished?
-
-    #if HAS_HOTENDS
-      LOOP_HOTEND() {
-        if (WITHIN(hotends[h]->data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(HOTENDsensorFilters[h]);
-          currentFilter.process_reading(AnalogInReadPin(hotends[h]->data.sensor.pin));
-          if (currentFilter.IsValid())
-            hotends[h]->data.sensor.adc_raw = currentFilter.GetSum();
-        }
+  AnalogInDmaDrain();
+
+  #if HAS_HOTENDS
+    LOOP_HOTEND() {
+      if (WITHIN(hotends[h]->data.sensor.pin, 0, 15)) {
+        uint16_t raw;
+        if (AnalogInReadPin(hotends[h]->data.sensor.pin, raw))
+          hotends[h]->data.sensor.adc_raw = raw;
       }
-    #endif
-    #if HAS_BEDS
-      LOOP_BED() {
-        if (WITHIN(beds[h]->data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(BEDsensorFilters[h]);
-          currentFilter.process_reading(AnalogInReadPin(beds[h]->data.sensor.pin));
-          if (currentFilter.IsValid())
-            beds[h]->data.sensor.adc_raw = currentFilter.GetSum();
-        }
+    }
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() {
+      if (WITHIN(beds[h]->data.sensor.pin, 0, 15)) {
+        uint16_t raw;
+        if (AnalogInReadPin(beds[h]->data.sensor.pin, raw))
+          beds[h]->data.sensor.adc_raw = raw;
       }
-    #endif
-    #if HAS_CHAMBERS
-      LOOP_CHAMBER() {
-        if (WITHIN(chambers[h]->data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(CHAMBERsensorFilters[h]);
-          currentFilter.process_reading(AnalogInReadPin(chambers[h]->data.sensor.pin));
-          if (currentFilter.IsValid())
-            chambers[h]->data.sensor.adc_raw = currentFilter.GetSum();
-        }
+    }
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() {
+      if (WITHIN(chambers[h]->data.sensor.pin, 0, 15)) {
+        uint16_t raw;
+        if (AnalogInReadPin(chambers[h]->data.sensor.pin, raw))
+          chambers[h]->data.sensor.adc_raw = raw;
       }
-    #endif
-    #if HAS_COOLERS
-      LOOP_COOLER() {
-        if (WITHIN(coolers[h]->data.sensor.pin, 0, 15)) {
-          ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(COOLERsensorFilters[h]);
-          currentFilter.process_reading(AnalogInReadPin(coolers[h]->data.sensor.pin));
-          if (currentFilter.IsValid())
-            coolers[h]->data.sensor.adc_raw = currentFilter.GetSum();
-        }
+    }
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() {
+      if (WITHIN(coolers[h]->data.sensor.pin, 0, 15)) {
+        uint16_t raw;
+        if (AnalogInReadPin(coolers[h]->data.sensor.pin, raw))
+          coolers[h]->data.sensor.adc_raw = raw;
       }
-    #endif
-
-    #if ENABLED(FILAMENT_WIDTH_SENSOR)
-      const_cast<ADCAveragingFilter&>(filamentFilter).process_reading(AnalogInReadPin(FILWIDTH_PIN));
-      if (filamentFilter.IsValid())
-        tempManager.current_raw_filwidth = filamentFilter.GetSum();
-    #endif
-
-    #if HAS_POWER_CONSUMPTION_SENSOR
-      const_cast<ADCAveragingFilter&>(powerFilter).process_reading(AnalogInReadPin(POWER_CONSUMPTION_PIN));
-      if (powerFilter.IsValid())
-        powerManager.current_raw_powconsumption = powerFilter.GetSum();
-    #endif
-
-    #if HAS_MCU_TEMPERATURE
-      const_cast<ADCAveragingFilter&>(mcuFilter).process_reading(AnalogInReadPin(ADC_TEMPERATURE_SENSOR));
-      if (mcuFilter.IsValid())
-        tempManager.mcu_current_temperature_raw = mcuFilter.GetSum();
-    #endif
+    }
+  #endif
 
-  }
+  #if ENABLED(FILAMENT_WIDTH_SENSOR)
+    AnalogInReadPin(FILWIDTH_PIN, tempManager.current_raw_filwidth);
+  #endif
 
-  AnalogInStartConversion();
+  #if HAS_POWER_CONSUMPTION_SENSOR
+    {
+      uint16_t raw;
+      if (AnalogInReadPin(POWER_CONSUMPTION_PIN, raw))
+        powerManager.current_raw_powconsumption = raw;
+    }
+  #endif
+
+  #if HAS_MCU_TEMPERATURE
+    {
+      uint16_t raw;
+      if (AnalogInReadPin(ADC_TEMPERATURE_SENSOR, raw))
+        tempManager.mcu_current_temperature_raw = raw;
+    }
+  #endif
 
   // Tick endstops state, if required
   endstops.Tick();
@@ -191,6 +191,7 @@ typedef uint32_t  ptr_int_t;
 #define AD_RANGE          _BV(ANALOG_INPUT_BITS)
 #define ABS_ZERO        -273.15f
 #define NUM_ADC_SAMPLES   32
+#define ADC_DMA_BUFFER_SIZE 64  // Conversions per PDC buffer, about 3ms of free-run scanning
 #define AD595_MAX        330.0f
 #define AD8495_MAX       660.0f
 
@@ -215,8 +216,6 @@ extern "C" {
 
 extern "C" char *dtostrf (double __val, signed char __width, unsigned char __prec, char *__s);
 
-typedef AveragingFilter<NUM_ADC_SAMPLES> ADCAveragingFilter;
-
 // ISR handler type
 using pfnISR_Handler = void(*)(void);
 
@@ -233,30 +232,12 @@ class HAL {
 
   private: /** Private Parameters */
 
-    #if HAS_HOTENDS
-      static ADCAveragingFilter HOTENDsensorFilters[MAX_HOTEND];
-    #endif
-    #if HAS_BEDS
-      static ADCAveragingFilter BEDsensorFilters[MAX_BED];
-    #endif
-    #if HAS_CHAMBERS
-      static ADCAveragingFilter CHAMBERsensorFilters[MAX_CHAMBER];
-    #endif
-    #if HAS_COOLERS
-      static ADCAveragingFilter COOLERsensorFilters[MAX_COOLER];
-    #endif
-
-    #if ENABLED(FILAMENT_WIDTH_SENSOR)
-      static ADCAveragingFilter filamentFilter;
-    #endif
-
-    #if HAS_POWER_CONSUMPTION_SENSOR
-      static ADCAveragingFilter powerFilter;
-    #endif
-
-    #if HAS_MCU_TEMPERATURE
-      static ADCAveragingFilter mcuFilter;
-    #endif
+    static uint16_t adc_dma_buffer[2][ADC_DMA_BUFFER_SIZE],
+                    adc_sample_count[NUM_ANALOG_INPUTS],
+                    adc_value[NUM_ANALOG_INPUTS],
+                    adc_valid_mask;
+    static uint32_t adc_sample_sum[NUM_ANALOG_INPUTS];
+    static uint8_t  adc_dma_index;
 
   public: /** Public Function */
 
@@ -354,6 +335,13 @@ class HAL {
     // Write token and then write from 512 byte buffer to SPI (for SD card)
     static void spiSendBlock(uint8_t token, const uint8_t* buf);
 
+  private: /** Private Function */
+
+    static bool AnalogInReadPin(const pin_t r_pin, uint16_t &value);
+    static void AnalogInDmaStart();
+    static void AnalogInDmaDecimate(const uint16_t *buffer);
+    static void AnalogInDmaDrain();
+
 };
 
 /**
@@ -44,12 +44,27 @@ template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_dropped_bytes = 0;
 template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_buffer_overruns = 0;
 template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_framing_errors = 0;
 template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::rx_max_enqueued = 0;
+template<typename Cfg> uint32_t MKHardwareSerial<Cfg>::tx_blocked_time = 0;
+template<typename Cfg> EmergencyStateEnum MKHardwareSerial<Cfg>::emergency_state = EP_RESET;
+template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::rx_scanned = 0;
 
 /** Protected Function */
+// Feed the bytes stored since the last scan to the emergency parser in one or
+// two chunks (when the ring wraps). Called from the RX ISR only.
 template<typename Cfg>
-FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
+void MKHardwareSerial<Cfg>::emergency_scan(const ring_buffer_pos_t h) {
+  ring_buffer_pos_t s = rx_scanned;
+  if (s == h) return;
+  if (h < s) {
+    emergency_parser.update(emergency_state, rx_buffer.buffer + s, Cfg::RX_SIZE - s);
+    s = 0;
+  }
+  emergency_parser.update(emergency_state, rx_buffer.buffer + s, h - s);
+  rx_scanned = h;
+}
 
-  static EmergencyStateEnum emergency_state; // = EP_RESET
+template<typename Cfg>
+FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
 
   // Get the tail pointer - Nothing can alter its value while we are at this ISR
   const ring_buffer_pos_t t = rx_buffer.tail;
@@ -63,7 +78,6 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
   // Read the character from the USART
   uint8_t c = HWUART->UART_RHR;
 
-  if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
 
   // If the character is to be stored at the index just before the tail
   // (such that the head would advance to the current tail), the RX FIFO is
@@ -72,8 +86,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
     rx_buffer.buffer[h] = c;
     h = i;
   }
-  else if (Cfg::DROPPED_RX && !++rx_dropped_bytes)
-    --rx_dropped_bytes;
+  else {
+    // The byte is lost, scan what is stored and then the byte itself
+    if (Cfg::EMERGENCYPARSER) {
+      emergency_scan(h);
+      emergency_parser.update(emergency_state, c);
+    }
+    if (Cfg::DROPPED_RX && !++rx_dropped_bytes) --rx_dropped_bytes;
+  }
 
   const ring_buffer_pos_t rx_count = (ring_buffer_pos_t)(h - t) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
   // Calculate count of bytes stored into the RX buffer
@@ -116,7 +136,6 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = HWUART->UART_RHR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
@@ -125,8 +144,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
               rx_buffer.buffer[h] = c;
               h = i;
             }
-            else if (Cfg::DROPPED_RX && !++rx_dropped_bytes)
-              --rx_dropped_bytes;
+            else {
+              // The byte is lost, scan what is stored and then the byte itself
+              if (Cfg::EMERGENCYPARSER) {
+                emergency_scan(h);
+                emergency_parser.update(emergency_state, c);
+              }
+              if (Cfg::DROPPED_RX && !++rx_dropped_bytes) --rx_dropped_bytes;
+            }
           }
           sw_barrier();
         }
@@ -150,7 +175,6 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = HWUART->UART_RHR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
@@ -159,8 +183,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
               rx_buffer.buffer[h] = c;
               h = i;
             }
-            else if (Cfg::DROPPED_RX && !++rx_dropped_bytes)
-              --rx_dropped_bytes;
+            else {
+              // The byte is lost, scan what is stored and then the byte itself
+              if (Cfg::EMERGENCYPARSER) {
+                emergency_scan(h);
+                emergency_parser.update(emergency_state, c);
+              }
+              if (Cfg::DROPPED_RX && !++rx_dropped_bytes) --rx_dropped_bytes;
+            }
           }
           sw_barrier();
         }
@@ -171,6 +201,10 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
     }
   }
 
+  // Scan the new bytes at end of line, or before they could be overwritten
+  if (Cfg::EMERGENCYPARSER && (c == '\n' || (ring_buffer_pos_t(h - rx_scanned) & (Cfg::RX_SIZE - 1)) >= Cfg::RX_SIZE / 2))
+    emergency_scan(h);
+
   // Store the new head value
   rx_buffer.head = h;
 }
@@ -393,7 +427,11 @@ void MKHardwareSerial<Cfg>::write(const uint8_t c) {
   _written = true;
 
   if (Cfg::TX_SIZE == 0) {
-    while (!(HWUART->UART_SR & UART_SR_TXRDY)) sw_barrier();
+    if (!(HWUART->UART_SR & UART_SR_TXRDY)) {
+      const uint32_t start = Cfg::TX_BLOCKED ? micros() : 0;
+      while (!(HWUART->UART_SR & UART_SR_TXRDY)) sw_barrier();
+      if (Cfg::TX_BLOCKED) tx_blocked_time += micros() - start;
+    }
     HWUART->UART_THR = c;
   }
   else {
@@ -423,9 +461,11 @@ void MKHardwareSerial<Cfg>::write(const uint8_t c) {
         sw_barrier();
       }
     }
-    else {
+    else if (i == tx_buffer.tail) {
       // Interrupts are enabled, just wait until there is space
+      const uint32_t start = Cfg::TX_BLOCKED ? micros() : 0;
       while (i == tx_buffer.tail) sw_barrier();
+      if (Cfg::TX_BLOCKED) tx_blocked_time += micros() - start;
     }
 
     // Store new char. head is always safe to move
@@ -438,6 +478,49 @@ void MKHardwareSerial<Cfg>::write(const uint8_t c) {
 
 }
 
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::write(const uint8_t* buffer, size_t size) {
+
+  if (Cfg::TX_SIZE == 0 || !ISRS_ENABLED()) {
+    while (size--) write(*buffer++);
+    return;
+  }
+
+  _written = true;
+
+  while (size) {
+
+    uint8_t n = MIN(size, size_t(tx_free()));
+
+    // The ring is full, wait for one byte of space
+    if (!n) {
+      write(*buffer++);
+      size--;
+      continue;
+    }
+
+    // Copy all that fits in the ring, then kick the TX isr once
+    size -= n;
+    uint8_t h = tx_buffer.head;
+    while (n--) {
+      tx_buffer.buffer[h] = *buffer++;
+      h = (h + 1) & (Cfg::TX_SIZE - 1);
+    }
+    tx_buffer.head = h;
+
+    // Enable TX isr - Non atomic, but it will eventually enable TX isr
+    HWUART->UART_IER = UART_IER_TXRDY;
+  }
+
+}
+
+template<typename Cfg>
+uint16_t MKHardwareSerial<Cfg>::tx_free() {
+  // Without TX buffer only the holding register can take a byte
+  if (Cfg::TX_SIZE == 0) return (HWUART->UART_SR & UART_SR_TXRDY) ? 1 : 0;
+  return (uint8_t)(tx_buffer.tail - tx_buffer.head - 1) & (Cfg::TX_SIZE - 1);
+}
+
 template<typename Cfg>
 void MKHardwareSerial<Cfg>::flushTX() {
 
@@ -74,9 +74,15 @@ class MKHardwareSerial {
 
     static ring_buffer_pos_t rx_max_enqueued;
 
+    static uint32_t tx_blocked_time;
+
+    static EmergencyStateEnum emergency_state;
+    static ring_buffer_pos_t  rx_scanned;
+
   protected: /** Protected Function */
 
     FORCE_INLINE static void store_rxd_char();
+    static void emergency_scan(const ring_buffer_pos_t h);
     FORCE_INLINE static void _tx_thr_empty_irq(void);
 
     static void UART_ISR(void);
@@ -99,7 +105,11 @@ class MKHardwareSerial {
     FORCE_INLINE static ring_buffer_pos_t rxMaxEnqueued() { return Cfg::MAX_RX_QUEUED ? rx_max_enqueued : 0; }
 
     FORCE_INLINE static void write(const char* str) { while (*str) write(*str++); }
-    FORCE_INLINE static void write(const uint8_t* buffer, size_t size) { while (size--) write(*buffer++); }
+    FORCE_INLINE static uint32_t blockedTime() { return Cfg::TX_BLOCKED ? tx_blocked_time : 0; }
+    FORCE_INLINE static void clearBlockedTime() { tx_blocked_time = 0; }
+
+    static uint16_t tx_free();
+    static void write(const uint8_t* buffer, size_t size);
     FORCE_INLINE static void print(const String& s) { for (int i = 0; i < (int)s.length(); i++) write(s[i]); }
     FORCE_INLINE static void print(const char* str) { write(str); }
 
@@ -31,34 +31,51 @@ int32_t HAL_VREF = 0;
 uint8_t MCUSR;
 
 /** Private Parameters */
-#if HAS_HOTENDS
-  ADCAveragingFilter  HAL::HOTENDsensorFilters[MAX_HOTEND];
-#endif
-#if HAS_BEDS
-  ADCAveragingFilter  HAL::BEDsensorFilters[MAX_BED];
-#endif
-#if HAS_CHAMBERS
-  ADCAveragingFilter  HAL::CHAMBERsensorFilters[MAX_CHAMBER];
-#endif
-#if HAS_COOLERS
-  ADCAveragingFilter  HAL::COOLERsensorFilters[MAX_COOLER];
-#endif
+#if HAS_ADC_DMA
 
-#if ENABLED(FILAMENT_WIDTH_SENSOR)
-  ADCAveragingFilter  HAL::filamentFilter;
-#endif
+  uint16_t  HAL::adc_dma_buffer[2 * ADC_DMA_SCANS * ADC_DMA_MAX_CHANNELS],
+            HAL::adc_sample_count[ADC_DMA_MAX_CHANNELS] = { 0 },
+            HAL::adc_value[ADC_DMA_MAX_CHANNELS]        = { 0 },
+            HAL::adc_valid_mask                         = 0;
+  uint32_t  HAL::adc_sample_sum[ADC_DMA_MAX_CHANNELS]   = { 0 };
+  pin_t     HAL::adc_pin[ADC_DMA_MAX_CHANNELS];
+  uint8_t   HAL::adc_channels                           = 0;
 
-#if HAS_POWER_CONSUMPTION_SENSOR
-  ADCAveragingFilter  HAL::powerFilter;
-#endif
+  static ADC_HandleTypeDef  adc_handle;
+  static DMA_HandleTypeDef  adc_dma_handle;
 
-#if HAS_MCU_TEMPERATURE
-  ADCAveragingFilter  HAL::mcuFilter;
-#endif
+#else
 
-#if HAS_VREF_MONITOR
-  ADCAveragingFilter  HAL::vrefFilter;
-#endif
+  #if HAS_HOTENDS
+    ADCAveragingFilter  HAL::HOTENDsensorFilters[MAX_HOTEND];
+  #endif
+  #if HAS_BEDS
+    ADCAveragingFilter  HAL::BEDsensorFilters[MAX_BED];
+  #endif
+  #if HAS_CHAMBERS
+    ADCAveragingFilter  HAL::CHAMBERsensorFilters[MAX_CHAMBER];
+  #endif
+  #if HAS_COOLERS
+    ADCAveragingFilter  HAL::COOLERsensorFilters[MAX_COOLER];
+  #endif
+
+  #if ENABLED(FILAMENT_WIDTH_SENSOR)
+    ADCAveragingFilter  HAL::filamentFilter;
+  #endif
+
+  #if HAS_POWER_CONSUMPTION_SENSOR
+    ADCAveragingFilter  HAL::powerFilter;
+  #endif
+
+  #if HAS_MCU_TEMPERATURE
+    ADCAveragingFilter  HAL::mcuFilter;
+  #endif
+
+  #if HAS_VREF_MONITOR
+    ADCAveragingFilter  HAL::vrefFilter;
+  #endif
+
+#endif // HAS_ADC_DMA
 
 // Return available memory
 extern "C" {
@@ -91,44 +108,224 @@ void HAL::showStartReason() {
   __HAL_RCC_CLEAR_RESET_FLAGS();
 }
 
+#if HAS_ADC_DMA
+
+  #define ADC_NO_CHANNEL 0xFF
+
+  // ADC1 channel of an analog input, ADC_NO_CHANNEL if ADC1 can't convert it.
+  // On the F4 the ADC_CHANNEL_x values are the channel numbers.
+  static uint32_t AnalogInChannel(const pin_t pin) {
+    const PinName pn = analogInputToPinName(pin);
+    #if HAS_MCU_TEMPERATURE
+      if (pn == PADC_TEMP) return ADC_CHANNEL_TEMPSENSOR;
+    #endif
+    #if HAS_VREF_MONITOR
+      if (pn == PADC_VREF) return ADC_CHANNEL_VREFINT;
+    #endif
+    if (pn == NC || pinmap_peripheral(pn, PinMap_ADC) != ADC1) return ADC_NO_CHANNEL;
+    return STM_PIN_CHANNEL(pinmap_function(pn, PinMap_ADC));
+  }
+
+  // Add a pin to the ADC1 regular sequence
+  void HAL::AnalogInAddPin(const pin_t pin) {
+    if (adc_channels >= ADC_DMA_MAX_CHANNELS || AnalogInChannel(pin) == ADC_NO_CHANNEL) return;
+    LOOP_L_N(i, adc_channels) if (adc_pin[i] == pin) return;
+    adc_pin[adc_channels++] = pin;
+  }
+
+  // Read the most recent decimated 12-bit result from a pin, false until the first one is ready
+  bool HAL::AnalogInReadPin(const pin_t pin, uint16_t &value) {
+    LOOP_L_N(i, adc_channels) {
+      if (adc_pin[i] == pin) {
+        if (!TEST(adc_valid_mask, i)) return false;
+        value = adc_value[i];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * ADC1 scans the sequence continuously and DMA2 Stream0 stores every
+   * conversion in a circular buffer of two halves. The half and full
+   * transfer flags are polled from Tick, no interrupt is used.
+   */
+  void HAL::AnalogInDmaStart() {
+
+    if (adc_handle.Instance) {
+      HAL_ADC_Stop_DMA(&adc_handle);
+      HAL_DMA_DeInit(&adc_dma_handle);
+    }
+
+    // Partial sums belong to the previous sequence
+    ZERO(adc_sample_sum);
+    ZERO(adc_sample_count);
+
+    if (!adc_channels) return;
+
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    adc_handle.Instance                   = ADC1;
+    adc_handle.Init.ClockPrescaler        = ADC_CLOCK_SYNC_PCLK_DIV8;
+    adc_handle.Init.Resolution            = ADC_RESOLUTION_12B;
+    adc_handle.Init.ScanConvMode          = ENABLE;
+    adc_handle.Init.ContinuousConvMode    = ENABLE;
+    adc_handle.Init.DiscontinuousConvMode = DISABLE;
+    adc_handle.Init.NbrOfDiscConversion   = 0;
+    adc_handle.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;
+    adc_handle.Init.ExternalTrigConv      = ADC_SOFTWARE_START;
+    adc_handle.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
+    adc_handle.Init.NbrOfConversion       = adc_channels;
+    adc_handle.Init.DMAContinuousRequests = ENABLE;
+    adc_handle.Init.EOCSelection          = ADC_EOC_SEQ_CONV;
+    HAL_ADC_Init(&adc_handle);
+
+    // Longest sampling time: about 44us per conversion at 90MHz APB2
+    ADC_ChannelConfTypeDef config;
+    config.SamplingTime = ADC_SAMPLETIME_480CYCLES;
+    config.Offset       = 0;
+    LOOP_L_N(i, adc_channels) {
+      config.Channel  = AnalogInChannel(adc_pin[i]);
+      config.Rank     = i + 1;
+      HAL_ADC_ConfigChannel(&adc_handle, &config);
+    }
+
+    adc_dma_handle.Instance                 = DMA2_Stream0;
+    adc_dma_handle.Init.Channel             = DMA_CHANNEL_0;
+    adc_dma_handle.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    adc_dma_handle.Init.PeriphInc           = DMA_PINC_DISABLE;
+    adc_dma_handle.Init.MemInc              = DMA_MINC_ENABLE;
+    adc_dma_handle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    adc_dma_handle.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    adc_dma_handle.Init.Mode                = DMA_CIRCULAR;
+    adc_dma_handle.Init.Priority            = DMA_PRIORITY_LOW;
+    adc_dma_handle.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&adc_dma_handle);
+    __HAL_LINKDMA(&adc_handle, DMA_Handle, adc_dma_handle);
+
+    HAL_ADC_Start_DMA(&adc_handle, (uint32_t*)adc_dma_buffer, 2 * ADC_DMA_SCANS * adc_channels);
+
+    // Polled from Tick: keep the status flags, drop the interrupts enabled by the HAL
+    __HAL_DMA_DISABLE_IT(&adc_dma_handle, DMA_IT_TC | DMA_IT_HT | DMA_IT_TE | DMA_IT_DME);
+    __HAL_ADC_DISABLE_IT(&adc_handle, ADC_IT_OVR);
+  }
+
+  // Oversample half buffer: sum NUM_ADC_SAMPLES conversions per channel, then decimate to the average
+  void HAL::AnalogInDmaDecimate(const uint16_t *buffer) {
+    LOOP_L_N(scan, ADC_DMA_SCANS) {
+      LOOP_L_N(i, adc_channels) {
+        adc_sample_sum[i] += *buffer++;
+        if (++adc_sample_count[i] == NUM_ADC_SAMPLES) {
+          adc_value[i] = adc_sample_sum[i] / NUM_ADC_SAMPLES;
+          adc_sample_sum[i] = 0;
+          adc_sample_count[i] = 0;
+          SBI(adc_valid_mask, i);
+        }
+      }
+    }
+  }
+
+  // Decimate the halves the DMA has filled since the last call
+  void HAL::AnalogInDmaDrain() {
+    if (!adc_channels) return;
+    if (__HAL_DMA_GET_FLAG(&adc_dma_handle, __HAL_DMA_GET_HT_FLAG_INDEX(&adc_dma_handle))) {
+      __HAL_DMA_CLEAR_FLAG(&adc_dma_handle, __HAL_DMA_GET_HT_FLAG_INDEX(&adc_dma_handle));
+      AnalogInDmaDecimate(adc_dma_buffer);
+    }
+    if (__HAL_DMA_GET_FLAG(&adc_dma_handle, __HAL_DMA_GET_TC_FLAG_INDEX(&adc_dma_handle))) {
+      __HAL_DMA_CLEAR_FLAG(&adc_dma_handle, __HAL_DMA_GET_TC_FLAG_INDEX(&adc_dma_handle));
+      AnalogInDmaDecimate(adc_dma_buffer + ADC_DMA_SCANS * adc_channels);
+    }
+  }
+
+#endif // HAS_ADC_DMA
+
 // Initialize ADC channels
 void HAL::analogStart() {
 
-  analogReadResolution(ANALOG_INPUT_BITS);
+  #if !HAS_ADC_DMA
+    analogReadResolution(ANALOG_INPUT_BITS);
+  #endif
 
   #if HAS_HOTENDS
     LOOP_HOTEND() {
       SET_INPUT_ANALOG(hotends[h]->data.sensor.pin);
+      #if HAS_ADC_DMA
+        AnalogInAddPin(hotends[h]->data.sensor.pin);
+      #endif
     }
   #endif
   #if HAS_BEDS
     LOOP_BED() {
       SET_INPUT_ANALOG(beds[h]->data.sensor.pin);
+      #if HAS_ADC_DMA
+        AnalogInAddPin(beds[h]->data.sensor.pin);
+      #endif
     }
   #endif
   #if HAS_CHAMBERS
     LOOP_CHAMBER() {
       SET_INPUT_ANALOG(chambers[h]->data.sensor.pin);
+      #if HAS_ADC_DMA
+        AnalogInAddPin(chambers[h]->data.sensor.pin);
+      #endif
     }
   #endif
   #if HAS_COOLERS
     LOOP_COOLER() {
       SET_INPUT_ANALOG(coolers[h]->data.sensor.pin);
+      #if HAS_ADC_DMA
+        AnalogInAddPin(coolers[h]->data.sensor.pin);
+      #endif
     }
   #endif
 
   #if ENABLED(FILAMENT_WIDTH_SENSOR)
     SET_INPUT_ANALOG(FILWIDTH_PIN);
+    #if HAS_ADC_DMA
+      AnalogInAddPin(FILWIDTH_PIN);
+    #endif
   #endif
 
   #if HAS_POWER_CONSUMPTION_SENSOR
     SET_INPUT_ANALOG(POWER_CONSUMPTION_PIN);
+    #if HAS_ADC_DMA
+      AnalogInAddPin(POWER_CONSUMPTION_PIN);
+    #endif
+  #endif
+
+  #if HAS_ADC_DMA
+    #if HAS_MCU_TEMPERATURE
+      AnalogInAddPin(ATEMP);
+    #endif
+    #if HAS_VREF_MONITOR
+      AnalogInAddPin(AVREF);
+    #endif
+    AnalogInDmaStart();
   #endif
 
 }
 
-void HAL::AdcChangePin(const pin_t, const pin_t new_pin) {
+void HAL::AdcChangePin(const pin_t old_pin, const pin_t new_pin) {
   SET_INPUT_ANALOG(new_pin);
+  #if HAS_ADC_DMA
+    // Take the place of the old pin in the sequence, the first value comes from a full set of samples
+    if (AnalogInChannel(new_pin) == ADC_NO_CHANNEL) return;
+    CRITICAL_SECTION_START();
+    uint8_t i = 0;
+    while (i < adc_channels && adc_pin[i] != old_pin) i++;
+    if (i < adc_channels) {
+      adc_pin[i] = new_pin;
+      CBI(adc_valid_mask, i);
+    }
+    else
+      AnalogInAddPin(new_pin);
+    AnalogInDmaStart();
+    CRITICAL_SECTION_END();
+  #else
+    UNUSED(old_pin);
+  #endif
 }
 
 // Reset peripherals and cpu
@@ -200,62 +397,127 @@ void HAL::Tick() {
   // Event every second
   if (cycle_1s_timer.expired(SECOND_TO_MILLIS(1))) printer.check_periodical_actions();
 
-  #if HAS_HOTENDS
-    LOOP_HOTEND() {
-      ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(HOTENDsensorFilters[h]);
-      currentFilter.process_reading(analogRead(hotends[h]->data.sensor.pin));
-      if (currentFilter.IsValid())
-        hotends[h]->data.sensor.adc_raw = currentFilter.GetSum();
-    }
-  #endif
-  #if HAS_BEDS
-    LOOP_BED() {
-      ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(BEDsensorFilters[h]);
-      currentFilter.process_reading(analogRead(beds[h]->data.sensor.pin));
-      if (currentFilter.IsValid())
-        beds[h]->data.sensor.adc_raw = currentFilter.GetSum();
-    }
-  #endif
-  #if HAS_CHAMBERS
-    LOOP_CHAMBER() {
-      ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(CHAMBERsensorFilters[h]);
-      currentFilter.process_reading(analogRead(chambers[h]->data.sensor.pin));
-      if (currentFilter.IsValid())
-        chambers[h]->data.sensor.adc_raw = currentFilter.GetSum();
-    }
-  #endif
-  #if HAS_COOLERS
-    LOOP_COOLER() {
-      ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(COOLERsensorFilters[h]);
-      currentFilter.process_reading(analogRead(coolers[h]->data.sensor.pin));
-      if (currentFilter.IsValid())
-        coolers[h]->data.sensor.adc_raw = currentFilter.GetSum();
-    }
-  #endif
-
-  #if ENABLED(FILAMENT_WIDTH_SENSOR)
-    const_cast<ADCAveragingFilter&>(filamentFilter).process_reading(analogRead(FILWIDTH_PIN));
-    if (filamentFilter.IsValid())
-      tempManager.current_raw_filwidth = filamentFilter.GetSum();
-  #endif
-
-  #if HAS_POWER_CONSUMPTION_SENSOR
-    const_cast<ADCAveragingFilter&>(powerFilter).process_reading(analogRead(POWER_CONSUMPTION_PIN));
-    if (powerFilter.IsValid())
-      powerManager.current_raw_powconsumption = powerFilter.GetSum();
-  #endif
-
-  #if HAS_MCU_TEMPERATURE
-    const_cast<ADCAveragingFilter&>(mcuFilter).process_reading(analogRead(ATEMP));
-    if (mcuFilter.IsValid())
-      tempManager.mcu_current_temperature_raw = mcuFilter.GetSum();
-  #endif
-
-  #if HAS_VREF_MONITOR
-    const_cast<ADCAveragingFilter&>(vrefFilter).process_reading(analogRead(AVREF));
-    if (mcuFilter.IsValid())
-      HAL_VREF = 1210 * AD_RANGE / vrefFilter.GetSum(); // ADC sample to mV
-  #endif
+  #if HAS_ADC_DMA
+
+    AnalogInDmaDrain();
+
+    #if HAS_HOTENDS
+      LOOP_HOTEND() {
+        uint16_t raw;
+        if (AnalogInReadPin(hotends[h]->data.sensor.pin, raw))
+          hotends[h]->data.sensor.adc_raw = raw;
+      }
+    #endif
+    #if HAS_BEDS
+      LOOP_BED() {
+        uint16_t raw;
+        if (AnalogInReadPin(beds[h]->data.sensor.pin, raw))
+          beds[h]->data.sensor.adc_raw = raw;
+      }
+    #endif
+    #if HAS_CHAMBERS
+      LOOP_CHAMBER() {
+        uint16_t raw;
+        if (AnalogInReadPin(chambers[h]->data.sensor.pin, raw))
+          chambers[h]->data.sensor.adc_raw = raw;
+      }
+    #endif
+    #if HAS_COOLERS
+      LOOP_COOLER() {
+        uint16_t raw;
+        if (AnalogInReadPin(coolers[h]->data.sensor.pin, raw))
+          coolers[h]->data.sensor.adc_raw = raw;
+      }
+    #endif
+
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      AnalogInReadPin(FILWIDTH_PIN, tempManager.current_raw_filwidth);
+    #endif
+
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      {
+        uint16_t raw;
+        if (AnalogInReadPin(POWER_CONSUMPTION_PIN, raw))
+          powerManager.current_raw_powconsumption = raw;
+      }
+    #endif
+
+    #if HAS_MCU_TEMPERATURE
+      {
+        uint16_t raw;
+        if (AnalogInReadPin(ATEMP, raw))
+          tempManager.mcu_current_temperature_raw = raw;
+      }
+    #endif
+
+    #if HAS_VREF_MONITOR
+      {
+        uint16_t raw;
+        if (AnalogInReadPin(AVREF, raw) && raw)
+          HAL_VREF = 1210 * AD_RANGE / raw; // ADC sample to mV
+      }
+    #endif
+
+  #else
+
+    #if HAS_HOTENDS
+      LOOP_HOTEND() {
+        ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(HOTENDsensorFilters[h]);
+        currentFilter.process_reading(analogRead(hotends[h]->data.sensor.pin));
+        if (currentFilter.IsValid())
+          hotends[h]->data.sensor.adc_raw = currentFilter.GetSum();
+      }
+    #endif
+    #if HAS_BEDS
+      LOOP_BED() {
+        ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(BEDsensorFilters[h]);
+        currentFilter.process_reading(analogRead(beds[h]->data.sensor.pin));
+        if (currentFilter.IsValid())
+          beds[h]->data.sensor.adc_raw = currentFilter.GetSum();
+      }
+    #endif
+    #if HAS_CHAMBERS
+      LOOP_CHAMBER() {
+        ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(CHAMBERsensorFilters[h]);
+        currentFilter.process_reading(analogRead(chambers[h]->data.sensor.pin));
+        if (currentFilter.IsValid())
+          chambers[h]->data.sensor.adc_raw = currentFilter.GetSum();
+      }
+    #endif
+    #if HAS_COOLERS
+      LOOP_COOLER() {
+        ADCAveragingFilter& currentFilter = const_cast<ADCAveragingFilter&>(COOLERsensorFilters[h]);
+        currentFilter.process_reading(analogRead(coolers[h]->data.sensor.pin));
+        if (currentFilter.IsValid())
+          coolers[h]->data.sensor.adc_raw = currentFilter.GetSum();
+      }
+    #endif
+
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      const_cast<ADCAveragingFilter&>(filamentFilter).process_reading(analogRead(FILWIDTH_PIN));
+      if (filamentFilter.IsValid())
+        tempManager.current_raw_filwidth = filamentFilter.GetSum();
+    #endif
+
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      const_cast<ADCAveragingFilter&>(powerFilter).process_reading(analogRead(POWER_CONSUMPTION_PIN));
+      if (powerFilter.IsValid())
+        powerManager.current_raw_powconsumption = powerFilter.GetSum();
+    #endif
+
+    #if HAS_MCU_TEMPERATURE
+      const_cast<ADCAveragingFilter&>(mcuFilter).process_reading(analogRead(ATEMP));
+      if (mcuFilter.IsValid())
+        tempManager.mcu_current_temperature_raw = mcuFilter.GetSum();
+    #endif
+
+    #if HAS_VREF_MONITOR
+      const_cast<ADCAveragingFilter&>(vrefFilter).process_reading(analogRead(AVREF));
+      if (mcuFilter.IsValid())
+        HAL_VREF = 1210 * AD_RANGE / vrefFilter.GetSum(); // ADC sample to mV
+    #endif
+
+  #endif // HAS_ADC_DMA
 
   // Tick endstops state, if required
   endstops.Tick();
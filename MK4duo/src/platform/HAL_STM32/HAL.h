@@ -139,6 +139,16 @@ typedef uint32_t  ptr_int_t;
 #define AD595_MAX          330.0f
 #define AD8495_MAX         660.0f
 
+// On the F4 the analog inputs are scanned by ADC1 into a circular DMA buffer,
+// the other families read them one by one with analogRead
+#if defined(STM32F4xx)
+  #define HAS_ADC_DMA           1
+  #define ADC_DMA_MAX_CHANNELS 16   // Regular sequence length of ADC1
+  #define ADC_DMA_SCANS         8   // Scans of all the channels in each half of the buffer
+#else
+  #define HAS_ADC_DMA           0
+#endif
+
 #define GET_PIN_MAP_PIN(index) index
 #define GET_PIN_MAP_INDEX(pin) pin
 #define PARSED_PIN_INDEX(code, dval) parser.intval(code, dval)
@@ -173,34 +183,48 @@ class HAL {
 
   private: /** Private Parameters */
 
-    #if HAS_HOTENDS
-      static ADCAveragingFilter HOTENDsensorFilters[MAX_HOTEND];
-    #endif
-    #if HAS_BEDS
-      static ADCAveragingFilter BEDsensorFilters[MAX_BED];
-    #endif
-    #if HAS_CHAMBERS
-      static ADCAveragingFilter CHAMBERsensorFilters[MAX_CHAMBER];
-    #endif
-    #if HAS_COOLERS
-      static ADCAveragingFilter COOLERsensorFilters[MAX_COOLER];
-    #endif
-
-    #if ENABLED(FILAMENT_WIDTH_SENSOR)
-      static ADCAveragingFilter filamentFilter;
-    #endif
-
-    #if HAS_POWER_CONSUMPTION_SENSOR
-      static ADCAveragingFilter powerFilter;
-    #endif
-
-    #if HAS_MCU_TEMPERATURE
-      static ADCAveragingFilter mcuFilter;
-    #endif
-
-    #if HAS_VREF_MONITOR
-      static ADCAveragingFilter vrefFilter;
-    #endif
+    #if HAS_ADC_DMA
+
+      static uint16_t adc_dma_buffer[2 * ADC_DMA_SCANS * ADC_DMA_MAX_CHANNELS],
+                      adc_sample_count[ADC_DMA_MAX_CHANNELS],
+                      adc_value[ADC_DMA_MAX_CHANNELS],
+                      adc_valid_mask;
+      static uint32_t adc_sample_sum[ADC_DMA_MAX_CHANNELS];
+      static pin_t    adc_pin[ADC_DMA_MAX_CHANNELS];
+      static uint8_t  adc_channels;
+
+    #else
+
+      #if HAS_HOTENDS
+        static ADCAveragingFilter HOTENDsensorFilters[MAX_HOTEND];
+      #endif
+      #if HAS_BEDS
+        static ADCAveragingFilter BEDsensorFilters[MAX_BED];
+      #endif
+      #if HAS_CHAMBERS
+        static ADCAveragingFilter CHAMBERsensorFilters[MAX_CHAMBER];
+      #endif
+      #if HAS_COOLERS
+        static ADCAveragingFilter COOLERsensorFilters[MAX_COOLER];
+      #endif
+
+      #if ENABLED(FILAMENT_WIDTH_SENSOR)
+        static ADCAveragingFilter filamentFilter;
+      #endif
+
+      #if HAS_POWER_CONSUMPTION_SENSOR
+        static ADCAveragingFilter powerFilter;
+      #endif
+
+      #if HAS_MCU_TEMPERATURE
+        static ADCAveragingFilter mcuFilter;
+      #endif
+
+      #if HAS_VREF_MONITOR
+        static ADCAveragingFilter vrefFilter;
+      #endif
+
+    #endif // HAS_ADC_DMA
 
   public: /** Public Function */
 
@@ -258,6 +282,16 @@ class HAL {
 
     static void showStartReason();
 
+  private: /** Private Function */
+
+    #if HAS_ADC_DMA
+      static void AnalogInAddPin(const pin_t pin);
+      static bool AnalogInReadPin(const pin_t pin, uint16_t &value);
+      static void AnalogInDmaStart();
+      static void AnalogInDmaDecimate(const uint16_t *buffer);
+      static void AnalogInDmaDrain();
+    #endif
+
     static void resetHardware();
 
     // SPI related functions
@@ -57,6 +57,24 @@ FSTRINGVALUE(DISMISS_BTN, "Dismiss");
 /** Public Parameters */
 int8_t Com::serial_port_index = -1;
 
+uint16_t  Com::tx_deferred  = 0,
+          Com::tx_dropped   = 0;
+
+/** Private Function */
+namespace {
+
+  // Only the MK4duo serial drivers know their TX space and blocked time
+  template<typename S> auto tx_free_of(S &s, int) -> decltype(uint16_t(s.tx_free())) { return s.tx_free(); }
+  template<typename S> uint16_t tx_free_of(S&, long) { return 0xFFFF; }
+
+  template<typename S> auto blocked_time_of(S &s, int) -> decltype(uint32_t(s.blockedTime())) { return s.blockedTime(); }
+  template<typename S> uint32_t blocked_time_of(S&, long) { return 0; }
+
+  template<typename S> auto clear_blocked_time_of(S &s, int) -> decltype(s.clearBlockedTime()) { s.clearBlockedTime(); }
+  template<typename S> void clear_blocked_time_of(S&, long) {}
+
+}
+
 /** Public Function */
 void Com::setBaudrate() {
   uint32_t serial_connect_timeout = millis() + 1000UL;
@@ -108,12 +126,16 @@ bool Com::serialDataAvailable(const uint8_t index) {
 
 // Functions for serial printing from PROGMEM. (Saves loads of SRAM.)
 void Com::printPGM(PGM_P str) {
+  char buf[16];
+  uint8_t n = 0;
   while (char c = pgm_read_byte(str++)) {
-    if (serial_port_index == -1 || serial_port_index == 0) MKSERIAL1.write(c);
-    #if NUM_SERIAL > 1
-      if (serial_port_index == -1 || serial_port_index == 1) MKSERIAL2.write(c);
-    #endif
+    buf[n++] = c;
+    if (n == sizeof(buf)) {
+      SERIAL_BUF(buf, n);
+      n = 0;
+    }
   }
+  if (n) SERIAL_BUF(buf, n);
 }
 
 void Com::print_spaces(uint8_t count) {
@@ -156,3 +178,169 @@ void Com::serial_delay(const millis_l ms) {
   HAL::delayMilliseconds(ms);
   printer.setSuspendAutoreport(was);
 }
+
+void Com::printf_P(PGM_P fmt, ...) {
+  static char line[SERIAL_LINE_SIZE];
+  va_list args;
+  va_start(args, fmt);
+  const uint8_t len = format_P(line, sizeof(line), fmt, args);
+  va_end(args);
+  SERIAL_BUF(line, len);
+}
+
+/**
+ * Format into buf, truncating at size - 1 chars. Return the length.
+ *
+ * Supported: %c %s %S (string in PROGMEM) %d %i %u %x %X %f %%
+ * with optional 0 flag, width, precision (%f only, default 2) and l for long.
+ */
+uint8_t Com::format_P(char * const buf, const uint8_t size, PGM_P fmt, va_list args) {
+
+  uint8_t len = 0;
+
+  auto put = [&](const char c) { if (len < size - 1) buf[len++] = c; };
+
+  char c;
+  while ((c = pgm_read_byte(fmt++))) {
+
+    if (c != '%') { put(c); continue; }
+
+    bool    zero_pad  = false,
+            is_long   = false;
+    uint8_t width     = 0,
+            precision = 2;
+
+    c = pgm_read_byte(fmt++);
+    if (c == '0') { zero_pad = true; c = pgm_read_byte(fmt++); }
+    while (NUMERIC(c)) { width = width * 10 + c - '0'; c = pgm_read_byte(fmt++); }
+    if (c == '.') {
+      precision = 0;
+      c = pgm_read_byte(fmt++);
+      while (NUMERIC(c)) { precision = precision * 10 + c - '0'; c = pgm_read_byte(fmt++); }
+      NOMORE(precision, 6);
+    }
+    if (c == 'l') { is_long = true; c = pgm_read_byte(fmt++); }
+
+    // Number text, built backwards from the end
+    char num[24];
+    uint8_t n = sizeof(num);
+    bool negative = false;
+
+    auto put_digits = [&](uint32_t v, const uint8_t base) {
+      do { const uint8_t d = v % base; num[--n] = d < 10 ? '0' + d : (c == 'X' ? 'A' : 'a') + d - 10; v /= base; } while (v && n);
+    };
+
+    switch (c) {
+      case 'c':
+        put(char(va_arg(args, int)));
+        continue;
+      case 's': {
+        const char *s = va_arg(args, const char*);
+        while (*s) put(*s++);
+      } continue;
+      case 'S': {
+        PGM_P s = va_arg(args, PGM_P);
+        while (char ch = pgm_read_byte(s++)) put(ch);
+      } continue;
+      case 'd': case 'i': {
+        const int32_t v = is_long ? va_arg(args, long) : va_arg(args, int);
+        negative = v < 0;
+        put_digits(negative ? -v : v, 10);
+      } break;
+      case 'u':
+        put_digits(is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int), 10);
+        break;
+      case 'x': case 'X':
+        put_digits(is_long ? va_arg(args, unsigned long) : va_arg(args, unsigned int), 16);
+        break;
+      case 'f': {
+        float v = va_arg(args, double);
+        if (isnan(v) || isinf(v)) {
+          const char *s = isnan(v) ? "nan" : "inf";
+          while (*s) put(*s++);
+          continue;
+        }
+        negative = v < 0;
+        if (negative) v = -v;
+        float rounding = 0.5f;
+        for (uint8_t i = 0; i < precision; i++) rounding *= 0.1f;
+        v += rounding;
+        const uint32_t int_part = uint32_t(v);
+        if (precision) {
+          uint32_t frac = uint32_t((v - int_part) * 1000000.0f);
+          for (uint8_t i = precision; i < 6; i++) frac /= 10;
+          for (uint8_t i = 0; i < precision; i++) { num[--n] = '0' + frac % 10; frac /= 10; }
+          num[--n] = '.';
+        }
+        put_digits(int_part, 10);
+      } break;
+      case '%':
+        put('%');
+        continue;
+      case '\0':
+        fmt--;
+        continue;
+      default:
+        put('%');
+        put(c);
+        continue;
+    }
+
+    // Sign, padding and number
+    const uint8_t num_len = sizeof(num) - n + negative;
+    if (negative && zero_pad) put('-');
+    for (uint8_t i = num_len; i < width; i++) put(zero_pad ? '0' : ' ');
+    if (negative && !zero_pad) put('-');
+    while (n < sizeof(num)) put(num[n++]);
+
+  }
+
+  buf[len] = '\0';
+  return len;
+
+}
+
+uint16_t Com::tx_free() {
+  #if TX_BUFFER_SIZE > 0
+    uint16_t free_bytes = 0xFFFF;
+    if (serial_port_index == -1 || serial_port_index == 0) NOMORE(free_bytes, tx_free_of(MKSERIAL1, 0));
+    #if NUM_SERIAL > 1
+      if (serial_port_index == -1 || serial_port_index == 1) NOMORE(free_bytes, tx_free_of(MKSERIAL2, 0));
+    #endif
+    return free_bytes;
+  #else
+    // Without TX buffer every write waits, so there is nothing to gain in deferring
+    return 0xFFFF;
+  #endif
+}
+
+bool Com::tx_ready(const uint16_t len) {
+  #if TX_BUFFER_SIZE > 0
+    // A text longer than the buffer can never fit, it goes when the buffer is empty
+    return !planner.has_blocks_queued() || tx_free() >= MIN(len, uint16_t(TX_BUFFER_SIZE - 1));
+  #else
+    UNUSED(len);
+    return true;
+  #endif
+}
+
+uint32_t Com::tx_blocked_time() {
+  uint32_t blocked = blocked_time_of(MKSERIAL1, 0);
+  #if NUM_SERIAL > 1
+    blocked += blocked_time_of(MKSERIAL2, 0);
+  #endif
+  return blocked;
+}
+
+void Com::print_stats() {
+  SERIAL_STR(ECHO);
+  SERIAL_PRINTF("TX blocked:%lums deferred:%u dropped:%u\n", (unsigned long)(tx_blocked_time() / 1000UL), tx_deferred, tx_dropped);
+}
+
+void Com::reset_stats() {
+  clear_blocked_time_of(MKSERIAL1, 0);
+  #if NUM_SERIAL > 1
+    clear_blocked_time_of(MKSERIAL2, 0);
+  #endif
+  tx_deferred = tx_dropped = 0;
+}
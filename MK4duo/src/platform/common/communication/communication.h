@@ -53,12 +53,18 @@ FSTRINGVAR(M24_CMD);            // M24 command
 FSTRINGVAR(CONTINUE_BTN);       // Continue button
 FSTRINGVAR(DISMISS_BTN);        // Dismiss button
 
+// Size of the line buffer of SERIAL_PRINTF
+#define SERIAL_LINE_SIZE 96
+
 class Com {
 
   public: /** Public Parameters */
 
     static int8_t serial_port_index;
 
+    static uint16_t tx_deferred,  // Low priority lines that waited for TX space
+                    tx_dropped;   // Low priority lines replaced before they could be sent
+
   public: /** Public Function */
 
     static void setBaudrate();
@@ -82,6 +88,23 @@ class Com {
     // A delay to provide brittle hosts time to receive bytes
     static void serial_delay(const millis_l ms);
 
+    // printf-style output, formatted in a line buffer and sent with one write
+    static void printf_P(PGM_P fmt, ...);
+    static uint8_t format_P(char * const buf, const uint8_t size, PGM_P fmt, va_list args);
+
+    // Free bytes in the TX buffer of the active ports
+    static uint16_t tx_free();
+
+    // True if low priority output of len bytes can be sent without delaying motion,
+    // output longer than the TX buffer is ready when the buffer is empty
+    static bool tx_ready(const uint16_t len);
+
+    // Time in microseconds spent waiting for TX space
+    static uint32_t tx_blocked_time();
+
+    static void print_stats();
+    static void reset_stats();
+
 };
 
 // MACRO FOR SERIAL
@@ -107,6 +130,8 @@ class Com {
 #define SERIAL_TXT(txt)               SERIAL_OUT(print, txt)
 #define SERIAL_VAL(V...)              SERIAL_OUT(print, V)
 #define SERIAL_CHR(c)                 SERIAL_OUT(write, c)
+#define SERIAL_BUF(buf,len)           SERIAL_OUT(write, (const uint8_t*)(buf), len)
+#define SERIAL_PRINTF(fmt,V...)       Com::printf_P(PSTR(fmt), ##V)
 #define SERIAL_EOL()                  SERIAL_CHR('\n')
 
 #define SERIAL_SP(C)                  Com::print_spaces(C)
@@ -54,6 +54,7 @@ struct MK4duoSerialHostCfg {
   static constexpr bool RX_OVERRUNS       = HAS_STATS_RX_BUFFER_OVERRUNS;
   static constexpr bool RX_FRAMING_ERRORS = HAS_STATS_RX_FRAMING_ERRORS;
   static constexpr bool MAX_RX_QUEUED     = HAS_STATS_MAX_RX_QUEUED;
+  static constexpr bool TX_BLOCKED        = HAS_STATS_TX_BLOCKED;
 };
 
 template <uint8_t serial>
@@ -67,4 +68,5 @@ struct MK4duoSerialCfg {
   static constexpr bool RX_OVERRUNS       = false;
   static constexpr bool RX_FRAMING_ERRORS = false;
   static constexpr bool MAX_RX_QUEUED     = false;
+  static constexpr bool TX_BLOCKED        = false;
 };
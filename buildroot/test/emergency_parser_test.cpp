@@ -0,0 +1,131 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * emergency_parser_test.cpp - Chunked scan of the emergency parser
+ *
+ * Random streams of emergency commands, other commands and noise are
+ * fed to the parser byte by byte and in random chunks. Both ways must
+ * run the same actions in the same order and end in the same state.
+ */
+
+#include "MK4duo.h"
+
+#define EMERGENCY_PARSER
+
+#define MAX_ACTIONS 256
+
+static char     actions[MAX_ACTIONS];
+static uint16_t actions_count = 0;
+
+static void log_action(const char a) { if (actions_count < MAX_ACTIONS) actions[actions_count++] = a; }
+
+// Firmware objects used by the parser
+struct {
+  void setWaitForUser(const bool)   { log_action('U'); }
+  void setWaitForHeatUp(const bool) { log_action('H'); }
+  void quickstop_stepper()          { log_action('Q'); }
+} printer;
+
+struct {
+  void response_handler(const uint8_t response) { log_action('0' + response); }
+} host_action;
+
+#include "src/feature/emergency_parser/emergency_parser.h"
+#include "src/feature/emergency_parser/emergency_parser.cpp"
+
+static const char * const tokens[] = {
+  "M108", "M112", "M410", "M876 S1", "M876 S", "M876", "M87", "M1128",
+  "N12 M112", "N-1 M410", " M108", "G1 X10 M112", "M105", "M11", "M41 0",
+  "T0", ";M112", "S9", " ", "\r", "\n", "\n", "\n", "\n"
+};
+
+static uint32_t seed = 12345;
+
+static uint32_t rnd(const uint32_t n) {
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 8) % n;
+}
+
+static uint16_t make_stream(uint8_t * const buf, const uint16_t size) {
+  uint16_t len = 0;
+  while (len < size - 16) {
+    if (rnd(8) == 0)
+      buf[len++] = uint8_t(rnd(256));     // Noise, even a NUL
+    else {
+      const char *t = tokens[rnd(COUNT(tokens))];
+      while (*t) buf[len++] = *t++;
+    }
+  }
+  return len;
+}
+
+int main() {
+
+  uint8_t stream[512];
+  char    expected[MAX_ACTIONS];
+  uint16_t expected_count;
+
+  for (uint32_t run = 0; run < 20000; run++) {
+
+    const uint16_t len = make_stream(stream, rnd(sizeof(stream) - 32) + 32);
+
+    // Reference, one byte at a time
+    EmergencyStateEnum ref_state = EP_RESET;
+    actions_count = 0;
+    emergency_parser.killed_by_M112 = false;
+    for (uint16_t i = 0; i < len; i++) emergency_parser.update(ref_state, stream[i]);
+    const bool ref_killed = emergency_parser.killed_by_M112;
+    expected_count = actions_count;
+    memcpy(expected, actions, actions_count);
+
+    // Chunks of random size, some empty
+    for (uint8_t split = 0; split < 8; split++) {
+      EmergencyStateEnum state = EP_RESET;
+      actions_count = 0;
+      emergency_parser.killed_by_M112 = false;
+      uint16_t pos = 0;
+      while (pos < len) {
+        const uint16_t n = MIN(uint16_t(rnd(split & 1 ? 8 : 80)), uint16_t(len - pos));
+        emergency_parser.update(state, stream + pos, n);
+        pos += n;
+      }
+
+      HOST_CHECK(emergency_parser.killed_by_M112 == ref_killed, "run %u split %u: M112 missed or extra", run, split);
+      HOST_CHECK(state == ref_state, "run %u split %u: state %u, byte by byte %u", run, split, state, ref_state);
+      HOST_CHECK(actions_count == expected_count && !memcmp(actions, expected, actions_count),
+                 "run %u split %u: %u actions, byte by byte %u", run, split, actions_count, expected_count);
+      if (host_test_failures) return HOST_TEST_RESULT("emergency_parser");
+    }
+
+  }
+
+  // A command split across chunks is still found
+  EmergencyStateEnum state = EP_RESET;
+  emergency_parser.killed_by_M112 = false;
+  const char * const parts[] = { "G28\nM", "1", "12", "\n" };
+  for (uint8_t i = 0; i < COUNT(parts); i++)
+    emergency_parser.update(state, (const uint8_t*)parts[i], strlen(parts[i]));
+  HOST_CHECK(emergency_parser.killed_by_M112, "M112 split across chunks not found");
+
+  return HOST_TEST_RESULT("emergency_parser");
+}
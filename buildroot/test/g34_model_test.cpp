@@ -0,0 +1,166 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * g34_model_test.cpp - Gantry model of G34
+ *
+ * A simulated gantry on three Z steppers, with the probe points away from
+ * the steppers and a pitch error on each leadscrew, is aligned as G34 does:
+ * probe, update the model from the last moves, solve all the moves at once.
+ * It must reach the accuracy target in a few iterations from any start, never
+ * slower than the plain correction of one stepper at a time (10 at worst),
+ * with a noisy probe and any allowed amplification, the learned gains must
+ * stay in range, and moves shorter than the noise must not be learned.
+ */
+
+#include "MK4duo.h"
+
+#define Z_STEPPER_COUNT 3
+
+#include "src/commands/gcode/calibrate/g34_model.h"
+
+#define TEST_ACCURACY   0.02f   // (mm) G34 T
+#define TEST_NOISE      0.005f  // (mm) Peak probe noise
+#define TEST_MIN_SIGMA  0.005f  // (mm) Probe::min_sigma()
+#define TEST_RUNS       200
+#define TEST_MAX_ITER   30
+
+static uint32_t seed = 1;
+
+static float random_range(const float lo, const float hi) {
+  seed = seed * 1103515245UL + 12345UL;
+  return lo + ((seed >> 16) & 0x7FFF) * ((hi - lo) / 32767.0f);
+}
+
+// Gantry plane through the stepper heights, probed away from the steppers
+struct gantry_t {
+
+  float sx[Z_STEPPER_COUNT], sy[Z_STEPPER_COUNT],   // Steppers
+        px[Z_STEPPER_COUNT], py[Z_STEPPER_COUNT],   // Probe points
+        pitch[Z_STEPPER_COUNT],                     // Height for 1mm of the stepper
+        h[Z_STEPPER_COUNT],
+        offset;
+
+  void init() {
+    const float X[] = { -20, 320, 150 }, Y[] = { 0, 0, 330 };
+    for (uint8_t i = 0; i < Z_STEPPER_COUNT; i++) {
+      sx[i] = X[i];
+      sy[i] = Y[i];
+      px[i] = X[i] * 0.7f + 45 + random_range(-10, 10);
+      py[i] = Y[i] * 0.7f + 40 + random_range(-10, 10);
+      pitch[i] = random_range(0.95f, 1.05f);
+      h[i] = random_range(-2, 2);
+    }
+    offset = 0;
+  }
+
+  float height_at(const float x, const float y) {
+    const float d  = (sy[1] - sy[2]) * (sx[0] - sx[2]) + (sx[2] - sx[1]) * (sy[0] - sy[2]),
+                w0 = ((sy[1] - sy[2]) * (x - sx[2]) + (sx[2] - sx[1]) * (y - sy[2])) / d,
+                w1 = ((sy[2] - sy[0]) * (x - sx[2]) + (sx[0] - sx[2]) * (y - sy[2])) / d;
+    return w0 * h[0] + w1 * h[1] + (1 - w0 - w1) * h[2];
+  }
+
+  // Probed Z at each point, the higher the gantry the higher the reading
+  void probe(float z[]) {
+    for (uint8_t i = 0; i < Z_STEPPER_COUNT; i++)
+      z[i] = offset - height_at(px[i], py[i]) + random_range(-(TEST_NOISE), TEST_NOISE);
+  }
+
+  void move(const uint8_t i, const float d) { h[i] += pitch[i] * d; offset += d; }
+
+};
+
+static float max_gain_error = 0;
+
+// Align as G34 does, return the iterations to reach the target
+static uint8_t align(gantry_t &gantry, const float amplification) {
+  const float min_move = (G34_MODEL_MIN_MOVE) * MAX(TEST_ACCURACY, TEST_MIN_SIGMA);
+  g34_model_t model;
+  g34_init_model(model, amplification);
+  float z[Z_STEPPER_COUNT], last_z[Z_STEPPER_COUNT] = { 0 }, moves[Z_STEPPER_COUNT] = { 0 };
+
+  for (uint8_t iteration = 0; iteration < TEST_MAX_ITER; iteration++) {
+    gantry.probe(z);
+
+    if (iteration > 0) g34_update_model(model, last_z, z, moves, min_move, SIGN(amplification));
+    for (uint8_t i = 0; i < Z_STEPPER_COUNT; i++) {
+      last_z[i] = z[i];
+      const float gain = g34_gain(model, i);
+      NOLESS(max_gain_error, MAX(G34_MODEL_MIN_GAIN - gain, gain - G34_MODEL_MAX_GAIN, 0.0f));
+    }
+
+    if (!g34_solve(model, z, moves)) {
+      g34_init_model(model, amplification);
+      continue;
+    }
+
+    float z_min = z[0];
+    for (uint8_t i = 1; i < Z_STEPPER_COUNT; i++) NOMORE(z_min, z[i]);
+    bool success = true;
+    for (uint8_t i = 0; i < Z_STEPPER_COUNT; i++) {
+      if (z[i] - z_min > TEST_ACCURACY) success = false;
+      gantry.move(i, moves[i]);
+    }
+    if (success) return iteration + 1;
+  }
+  return TEST_MAX_ITER + 1;
+}
+
+int main() {
+
+  gantry_t gantry;
+
+  // Any start, any allowed amplification
+  const float amp[] = { 1.0f, 0.5f, 2.0f };
+  for (uint8_t a = 0; a < COUNT(amp); a++) {
+    uint16_t sum = 0, worst = 0;
+    seed = 1;
+    for (uint16_t run = 0; run < TEST_RUNS; run++) {
+      gantry.init();
+      const uint8_t n = align(gantry, amp[a]);
+      sum += n;
+      NOLESS(worst, n);
+    }
+    printf("A%.1f iterations mean %.2f worst %i\n", amp[a], float(sum) / (TEST_RUNS), worst);
+    HOST_CHECK(sum <= 4.5f * (TEST_RUNS) && worst <= 10, "A%.1f: mean %.2f worst %i iterations", amp[a], float(sum) / (TEST_RUNS), worst);
+  }
+  HOST_CHECK(max_gain_error < 1e-4f, "gain out of range by %.5f", max_gain_error);
+
+  g34_model_t model, before;
+  g34_init_model(model, 1.0f);
+  before = model;
+
+  // A move within the noise is not learned
+  const float z_old[] = { 0, 0, 0 }, z_noise[] = { 0.01f, -0.01f, 0 }, small_move[] = { 0.05f, 0, 0 };
+  HOST_CHECK(!g34_update_model(model, z_old, z_noise, small_move, 0.08f, 1), "small move learned");
+  for (uint8_t r = 0; r < Z_STEPPER_COUNT; r++)
+    for (uint8_t c = 0; c < Z_STEPPER_COUNT; c++)
+      HOST_CHECK(model(r, c) == before(r, c), "model changed by a small move at %i,%i", r, c);
+
+  // A wild reading is clamped to the gain range
+  const float z_wild[] = { -5, 2.5f, 2.5f }, big_move[] = { 1, 0, 0 };
+  HOST_CHECK(g34_update_model(model, z_old, z_wild, big_move, 0.08f, 1), "big move not learned");
+  HOST_CHECK(ABS(g34_gain(model, 0) - (G34_MODEL_MAX_GAIN)) < 1e-4f, "gain %.4f not clamped to %.1f", g34_gain(model, 0), G34_MODEL_MAX_GAIN);
+
+  return HOST_TEST_RESULT("g34_model");
+}
@@ -0,0 +1,351 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * heater_control_test.cpp - Closed loop step responses and protections of the heaters
+ *
+ * Heater and HeaterSimulation are built as on the printer and run every
+ * PID_SAMPLE_TIME as in TempManager::spin(), with the default settings:
+ * the simulated plants of M309 feed the sensor path, check_and_power()
+ * runs the thermal protection and the PID or MPC controller.
+ * The rise time, overshoot, settling time and final error of each step
+ * response are checked against limits that leave a margin over the
+ * current results, they are there to catch a controller change that
+ * makes the regulation worse. An open heater, a heater lost while
+ * holding and an open sensor must stop the heater with the right error,
+ * a heater lost by an MPC hotend through the thermal model.
+ */
+
+#include "MK4duo.h"
+
+#define HEATER_SIMULATION
+#define MPC_TEMP
+#define THERMAL_PROTECTION_MODEL
+
+#include "Configuration_Temperature.h"
+
+// Host build of one hotend and one bed
+#define HOTENDS           1
+#define BEDS              1
+#define MAX_HOTEND        1
+#define MAX_BED           1
+#define MAX_CHAMBER       0
+#define MAX_COOLER        0
+#define HAS_HOTENDS       1
+#define HAS_BEDS          1
+#define HAS_HEATER_HE0    1
+#define HAS_FAN           1
+#define HEATER_OVERSHOOT  10
+#define ANALOG_INPUT_BITS 12
+#define AD_RANGE          _BV(ANALOG_INPUT_BITS)
+#define ABS_ZERO          -273.15f
+#define OUTPUT_LOW        0x4
+#define OUTPUT_HIGH       0x5
+#define HIGH              0x1
+#define LOW               0x0
+#define HAL_VOLTAGE_PIN   3.3f
+#define SOFT_PWM_MASK     0x7F
+#define BOARD_NAME        "Host"
+
+// Simulated clock, advanced by the test
+static millis_l sim_ms = 0;
+static millis_l millis() { return sim_ms; }
+
+#include "src/lib/timer.h"
+
+// Messages
+#define PROGMEM
+#define PGM_P           const char*
+#define PSTR(s)         s
+#define pgm_read_word(A) (*(const uint16_t*)(A))
+
+#include "src/language/language.h"
+
+// Serial output is not checked, the values are only evaluated
+template <typename... Args> static void host_print(const Args&...) {}
+
+#define SERIAL_STR(str)                 NOOP
+#define SERIAL_MSG(msg)                 host_print(msg)
+#define SERIAL_EOL()                    NOOP
+#define SERIAL_CHR(c)                   host_print(c)
+#define SERIAL_LM(str,msg)              host_print(msg)
+#define SERIAL_SM(str,msg)              host_print(msg)
+#define SERIAL_EM(msg)                  host_print(msg)
+#define SERIAL_MV(msg,val,V...)         host_print(msg, val, ##V)
+#define SERIAL_SMV(str,msg,val,V...)    host_print(msg, val, ##V)
+#define SERIAL_EMV(msg,val,V...)        host_print(msg, val, ##V)
+#define DEBUG_SMV(str,msg,val,V...)     host_print(msg, val, ##V)
+#define DEBUG_MV(msg,val,V...)          host_print(msg, val, ##V)
+#define DEBUG_EOL()                     NOOP
+#define LCD_MESSAGEPGM(msg)             NOOP
+#define LCD_ALERTMESSAGEPGM_P(msg)      host_print(msg)
+
+#include "src/core/tempmanager/sensor/sensor.h"
+#include "src/core/tempmanager/sensor/sensor_table.h"
+#include "src/core/tempmanager/pid/pid.h"
+#include "src/core/tempmanager/mpc/mpc.h"
+#include "src/core/tempmanager/runaway/runaway.h"
+#include "src/core/tempmanager/heater/heater.h"
+#include "src/core/tempmanager/simulation/heater_plant.h"
+#include "src/core/tempmanager/simulation/simulation.h"
+#include "host/mpc_defaults.h"
+
+// Firmware objects used by the heater, the fan speed is set by the test
+struct {
+  bool isRunning()                  { return true; }
+  bool isWaitForHeatUp()            { return false; }
+  bool isAutoreportTemp()           { return false; }
+  void setWaitForHeatUp(const bool) {}
+  void setAutoreportTemp(const bool){}
+  bool debugFeature()               { return false; }
+  void idle()                       {}
+  void reset_move_timer()           {}
+} printer;
+
+struct {
+  struct {
+    uint8_t hotends = HOTENDS, beds = BEDS, lpq_len = 0;
+  } heater;
+  uint8_t pwm_soft_count = 0;
+  void disable_all_heaters()        {}
+} tempManager;
+
+struct {
+  struct { uint8_t active = 0; } extruder;
+  uint8_t active_hotend()           { return 0; }
+} toolManager;
+
+struct {
+  float get_extrusion_rate(const uint8_t, const millis_l) { return 0.0f; }
+} planner;
+
+struct {
+  void playtone(const uint16_t, const uint16_t) {}
+} sound;
+
+#define NOTE_G4 392
+#define NOTE_E5 659
+
+// The last status message tells which protection stopped the heater
+struct {
+  const char *status = "";
+  void set_status_P(const char * const msg) { status = msg; }
+  void reset_status()               { status = ""; }
+  void update()                     {}
+} lcdui;
+
+struct {
+  void store()                      {}
+} eeprom;
+
+struct HAL {
+  static void digitalWrite(const pin_t, const uint8_t)  {}
+  static void pinMode(const pin_t, const uint8_t)       {}
+  static void analogWrite(const pin_t, const uint8_t, const uint16_t=0) {}
+};
+
+struct fan_mock_t {
+  uint8_t speed = 0, scaled_speed = 128;
+  void set_speed(const uint8_t s)   { speed = s; }
+  uint8_t actual_speed()            { return speed; }
+};
+fan_mock_t fan0;
+fan_mock_t* fans[1] = { &fan0 };
+
+#include "src/core/tempmanager/heater/heater.cpp"
+#include "src/core/tempmanager/simulation/simulation.cpp"
+
+enum ControlEnum : uint8_t { CONTROL_PID, CONTROL_MPC };
+
+struct step_limits_t {
+  float rise, overshoot, settle, error;
+};
+
+static Heater hotend(IS_HOTEND, HOTEND_CHECK_INTERVAL, HOTEND_HYSTERESIS, WATCH_HOTEND_PERIOD, WATCH_HOTEND_INCREASE),
+              bed(IS_BED, BED_CHECK_INTERVAL, BED_HYSTERESIS, WATCH_BED_PERIOD, WATCH_BED_INCREASE);
+
+// Hotend 0 as TempManager::hotends_factory_parameters() sets it, with the thermal protection on
+static void setup_hotend(const ControlEnum control) {
+  constexpr float HEKp[] = HOTEND_Kp, HEKi[] = HOTEND_Ki, HEKd[] = HOTEND_Kd;
+  hotend.data.pin       = NoPin;
+  hotend.data.ID        = 0;
+  hotend.data.temp.min  = HOTEND_0_MINTEMP;
+  hotend.data.temp.max  = HOTEND_0_MAXTEMP;
+  hotend.data.pid.Kp    = HEKp[0];
+  hotend.data.pid.Ki    = HEKi[0];
+  hotend.data.pid.Kd    = HEKd[0];
+  hotend.data.pid.Kc    = 0;
+  hotend.data.pid.drive.min = POWER_DRIVE_MIN;
+  hotend.data.pid.drive.max = POWER_DRIVE_MAX;
+  hotend.data.pid.Max   = POWER_MAX;
+  hotend.data.mpc = mpc_data_t();
+  if (control == CONTROL_MPC) init_mpc(hotend.data.mpc);
+  hotend.data.sensor.type       = TEMP_SENSOR_HE0;
+  hotend.data.sensor.res_25     = HOT0_R25;
+  hotend.data.sensor.beta       = HOT0_BETA;
+  hotend.data.sensor.pullup_res = THERMISTOR_SERIES_RS;
+  hotend.data.sensor.shC        = 0;
+  hotend.data.sensor.adc_low_offset  = 0;
+  hotend.data.sensor.adc_high_offset = 0;
+  hotend.resetFlag();
+  hotend.setUsePid(true);
+  hotend.setPidTuned(true);
+  hotend.setThermalProtection(true);
+  hotend.init();
+}
+
+// The default configuration has no bed sensor, the bed gets the thermistor of hotend 0
+static void setup_bed() {
+  constexpr float BEDKp[] = BED_Kp, BEDKi[] = BED_Ki, BEDKd[] = BED_Kd;
+  bed.data.pin          = NoPin;
+  bed.data.ID           = 0;
+  bed.data.temp.min     = BED_MINTEMP;
+  bed.data.temp.max     = BED_MAXTEMP;
+  bed.data.pid.Kp       = BEDKp[0];
+  bed.data.pid.Ki       = BEDKi[0];
+  bed.data.pid.Kd       = BEDKd[0];
+  bed.data.pid.Kc       = 0;
+  bed.data.pid.drive.min = BED_POWER_DRIVE_MIN;
+  bed.data.pid.drive.max = BED_POWER_DRIVE_MAX;
+  bed.data.pid.Max      = BED_POWER_MAX;
+  bed.data.sensor.type        = TEMP_SENSOR_HE0;
+  bed.data.sensor.res_25      = HOT0_R25;
+  bed.data.sensor.beta        = HOT0_BETA;
+  bed.data.sensor.pullup_res  = THERMISTOR_SERIES_RS;
+  bed.data.sensor.shC         = 0;
+  bed.data.sensor.adc_low_offset  = 0;
+  bed.data.sensor.adc_high_offset = 0;
+  bed.resetFlag();
+  bed.setUsePid(true);
+  bed.setPidTuned(true);
+  bed.setThermalProtection(true);
+  bed.init();
+}
+
+/**
+ * Set the target from ambient, or keep on with the current one, and run the
+ * temperature cycles of TempManager::spin() for the given time.
+ * Stop early if the heater faults.
+ */
+static step_metrics_t run(Heater * const act, const int16_t target, const uint16_t seconds, const bool from_ambient=true) {
+  const uint32_t steps = uint32_t(seconds) * 1000UL / (PID_SAMPLE_TIME);
+  step_metrics_t metrics;
+  metrics.init(SIM_AMBIENT_TEMP, target, PID_dT, steps);
+  lcdui.reset_status();
+  if (from_ambient) {
+    heaterSim.get_plant(act).reset();
+    act->update_current_temperature();
+    act->set_target_temp(target);
+  }
+  for (uint32_t i = 0; i < steps && !act->isFault(); i++) {
+    sim_ms += PID_SAMPLE_TIME;
+    heaterSim.spin();
+    act->update_current_temperature();
+    act->check_and_power();
+    metrics.add(act->current_temperature);
+  }
+  return metrics;
+}
+
+static void check(const char * const name, step_metrics_t m, const step_limits_t &limit) {
+  printf("%-28s rise %6.1fs overshoot %5.2fC settle %6.1fs error %6.3fC\n", name,
+         m.reached() ? m.rise_time() : -1.0f, m.overshoot(), m.settled() ? m.settle_time : -1.0f, m.final_error());
+  HOST_CHECK(m.reached(), "%s: target not reached", name);
+  HOST_CHECK(m.rise_time() <= limit.rise, "%s: rise %.1fs > %.1fs", name, m.rise_time(), limit.rise);
+  HOST_CHECK(m.overshoot() <= limit.overshoot, "%s: overshoot %.2fC > %.2fC", name, m.overshoot(), limit.overshoot);
+  HOST_CHECK(m.settled() && m.settle_time <= limit.settle, "%s: settle %.1fs > %.1fs", name, m.settle_time, limit.settle);
+  HOST_CHECK(ABS(m.final_error()) <= limit.error, "%s: error %.3fC > %.3fC", name, m.final_error(), limit.error);
+  HOST_CHECK(!hotend.isFault() && !bed.isFault(), "%s: heater stopped with %s", name, lcdui.status);
+}
+
+// Run the heater into the fault and check the error, return the seconds to the stop
+static float check_fault(const char * const name, Heater * const act, const int16_t target, const uint16_t seconds, const char * const error, const bool from_ambient=true) {
+  const millis_l start = sim_ms;
+  run(act, target, seconds, from_ambient);
+  const float stop = (sim_ms - start) * 0.001f;
+  printf("%-28s stopped after %6.1fs with %s\n", name, stop, lcdui.status);
+  HOST_CHECK(act->isFault() && !act->isActive() && act->pwm_value == 0, "%s: heater not stopped", name);
+  HOST_CHECK(lcdui.status == error, "%s: stopped with %s instead of %s", name, lcdui.status, error);
+  return stop;
+}
+
+int main() {
+
+  hotends[0] = &hotend;
+  beds[0]    = &bed;
+  heaterSim.init();
+  setup_bed();
+
+  // Hotend with PID
+  setup_hotend(CONTROL_PID);
+  check("hotend PID 200C", run(&hotend, 200, 600), { 85, 3.0, 130, 0.1 });
+
+  // Hotend with MPC, with the part fan and with a heater weaker than the model
+  setup_hotend(CONTROL_MPC);
+  check("hotend MPC 200C", run(&hotend, 200, 600), { 85, 1.0, 120, 0.1 });
+  setup_hotend(CONTROL_MPC);
+  fan0.speed = 255;
+  check("hotend MPC 200C fan 255", run(&hotend, 200, 600), { 95, 1.0, 130, 0.1 });
+  fan0.speed = 0;
+  heater_plant_t &plant = heaterSim.get_plant(&hotend);
+  plant.power *= 0.8f;
+  setup_hotend(CONTROL_MPC);
+  check("hotend MPC 200C 80% power", run(&hotend, 200, 600), { 115, 1.5, 170, 0.1 });
+  heaterSim.init();
+
+  // Bed with PID
+  check("bed PID 60C", run(&bed, 60, 1800), { 100, 4.0, 400, 0.1 });
+  bed.set_target_temp(0);
+
+  // An open heater never heats, the watch period stops it
+  setup_hotend(CONTROL_MPC);
+  plant.fault = SIM_FAULT_HEATER;
+  const float watch = check_fault("hotend open heater", &hotend, 200, 120, GET_TEXT(MSG_HEATING_FAILED));
+  HOST_CHECK(watch <= WATCH_HOTEND_PERIOD + 1, "open heater: stopped after %.1fs > %is", watch, WATCH_HOTEND_PERIOD + 1);
+  HOST_CHECK(ABS(plant.block_temp - SIM_AMBIENT_TEMP) < 0.1f, "open heater heated to %.1fC", plant.block_temp);
+  plant.fault = SIM_FAULT_NONE;
+
+  // A heater lost while holding: the hysteresis check stops it with PID, the thermal model with MPC
+  setup_hotend(CONTROL_PID);
+  check("hotend PID 200C hold", run(&hotend, 200, 300), { 85, 3.0, 130, 0.1 });
+  plant.fault = SIM_FAULT_HEATER;
+  const float runaway = check_fault("hotend PID heater lost", &hotend, 200, 300, GET_TEXT(MSG_THERMAL_RUNAWAY), false);
+  HOST_CHECK(runaway <= THERMAL_PROTECTION_PERIOD + 30, "PID heater lost: stopped after %.1fs > %is", runaway, THERMAL_PROTECTION_PERIOD + 30);
+  plant.fault = SIM_FAULT_NONE;
+
+  setup_hotend(CONTROL_MPC);
+  check("hotend MPC 200C hold", run(&hotend, 200, 300), { 85, 1.0, 120, 0.1 });
+  plant.fault = SIM_FAULT_HEATER;
+  const float model = check_fault("hotend MPC heater lost", &hotend, 200, 300, GET_TEXT(MSG_THERMAL_RUNAWAY), false);
+  HOST_CHECK(model <= 15, "MPC heater lost: stopped after %.1fs > 15s", model);
+  plant.fault = SIM_FAULT_NONE;
+
+
+  // An open sensor reads below the minimum temperature
+  setup_hotend(CONTROL_MPC);
+  plant.fault = SIM_FAULT_SENSOR_OPEN;
+  const float mintemp = check_fault("hotend open sensor", &hotend, 200, 60, GET_TEXT(MSG_ERR_MINTEMP));
+  HOST_CHECK(mintemp <= MAX_CONSECUTIVE_LOW_TEMP * PID_dT + 0.01f, "open sensor: stopped after %.1fs", mintemp);
+  plant.fault = SIM_FAULT_NONE;
+
+  return HOST_TEST_RESULT("heater_control");
+}
@@ -0,0 +1,62 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * MK4duo.h - Host stand-in for the main include
+ *
+ * The host tests compile firmware sources against this file instead of
+ * the real MK4duo.h, see buildroot/bin/run_host_tests. Only the lib modules
+ * that build without a board are included, each test declares the few
+ * firmware objects its sources use before including them.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// From the Arduino core
+#ifndef sq
+  #define sq(x) ((x)*(x))
+#endif
+#ifndef constrain
+  #define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#endif
+
+#include "src/lib/macros.h"
+#include "src/lib/types.h"
+#include "src/lib/enum.h"
+#include "src/lib/matrix.h"
+#include "src/lib/running_stats.h"
+
+// Checks of the host tests
+static int host_test_failures = 0;
+
+#define HOST_CHECK(COND, ...) do{ if (!(COND)) { host_test_failures++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } }while(0)
+
+#define HOST_TEST_RESULT(NAME) (printf("%s: %s\n", NAME, host_test_failures ? "FAILED" : "passed"), host_test_failures ? 1 : 0)
@@ -0,0 +1,40 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * mpc_defaults.h - Thermal model of hotend 0 from Configuration_Temperature.h
+ *
+ * Shared by the host tests that run an MPC hotend, include it after mpc.h.
+ */
+
+static void init_mpc(mpc_data_t &mpc) {
+  constexpr float P[] = MPC_HEATER_POWER, C[] = MPC_BLOCK_HEAT_CAPACITY, R[] = MPC_SENSOR_RESPONSIVENESS,
+                  A[] = MPC_AMBIENT_XFER_COEFF, F[] = MPC_AMBIENT_XFER_COEFF_FAN255, E[] = MPC_FILAMENT_HEAT_CAPACITY_PERMM;
+  mpc.heater_power                  = P[0];
+  mpc.block_heat_capacity           = C[0];
+  mpc.sensor_responsiveness         = R[0];
+  mpc.ambient_xfer_coeff_fan0       = A[0];
+  mpc.fan255_adjustment             = F[0] - A[0];
+  mpc.filament_heat_capacity_permm  = E[0];
+  mpc.init();
+}
@@ -0,0 +1,173 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mesh_slot_test.cpp - Packed UBL mesh slots
+ *
+ * Meshes go through pack_mesh() and unpack_mesh() and must come back
+ * within half a micrometre, with the unprobed points still unprobed and
+ * the points too far from the mean clamped. The slot is then written to
+ * and read from an EEPROM image as EEPROM::store_mesh() and load_mesh()
+ * do, the CRC of an intact slot must match and a flipped bit anywhere
+ * after the CRC must not.
+ */
+
+#include "MK4duo.h"
+
+// An odd count of points, so the slot ends with padding
+#define GRID_MAX_POINTS_X 7
+#define GRID_MAX_POINTS_Y 5
+
+#include "src/core/eeprom/mesh_slot.h"
+
+typedef float mesh_t[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+
+// As in utility.cpp, which needs the serial
+void crc16(uint16_t *crc, const void * const data, uint16_t cnt) {
+  uint8_t *ptr = (uint8_t *)data;
+  while (cnt--) {
+    *crc = (uint16_t)(*crc ^ (uint16_t)(((uint16_t)*ptr++) << 8));
+    for (uint8_t i = 0; i < 8; i++)
+      *crc = (uint16_t)((*crc & 0x8000) ? ((uint16_t)(*crc << 1) ^ 0x1021) : (*crc << 1));
+  }
+}
+
+// EEPROM image with the byte by byte CRC of the platform write_data() and read_data()
+static uint8_t eeprom[sizeof(mesh_slot_t) + 16];
+
+static void write_data(int &pos, const uint8_t *value, uint16_t size, uint16_t *crc) {
+  while (size--) { eeprom[pos++] = *value; crc16(crc, value, 1); value++; }
+}
+
+static void read_data(int &pos, uint8_t *value, uint16_t size, uint16_t *crc) {
+  while (size--) { *value = eeprom[pos++]; crc16(crc, value, 1); value++; }
+}
+
+// As EEPROM::store_mesh()
+static void store_slot(mesh_slot_t &packed, const int slot_pos) {
+  int pos = slot_pos + sizeof(packed.crc);
+  packed.crc = 0;
+  write_data(pos, MESH_SLOT_DATA(packed), &packed.crc);
+  uint16_t dummy_crc = 0;
+  pos = slot_pos;
+  write_data(pos, (uint8_t *)&packed.crc, sizeof(packed.crc), &dummy_crc);
+}
+
+// As EEPROM::load_mesh(), return false on a CRC mismatch
+static bool load_slot(mesh_slot_t &packed, const int slot_pos) {
+  int pos = slot_pos;
+  uint16_t crc = 0, stored_crc = 0;
+  read_data(pos, (uint8_t *)&stored_crc, sizeof(stored_crc), &crc);
+  crc = 0;
+  read_data(pos, MESH_SLOT_DATA(packed), &crc);
+  return crc == stored_crc;
+}
+
+static uint32_t seed = 1;
+
+static float random_mm(const float range) {
+  seed = seed * 1103515245UL + 12345UL;
+  return ((seed >> 16) & 0x7FFF) * (2.0f * range / 32767.0f) - range;
+}
+
+// Pack and unpack, return the largest error of the probed points
+static float round_trip(const mesh_t &mesh, mesh_t &back, mesh_slot_t &packed) {
+  pack_mesh(packed, mesh);
+  unpack_mesh(packed, back);
+  float max_error = 0;
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+      HOST_CHECK(isnan(mesh[x][y]) == isnan(back[x][y]), "point %i,%i: probed %i, unpacked %i", x, y, !isnan(mesh[x][y]), !isnan(back[x][y]));
+      if (!isnan(mesh[x][y])) NOLESS(max_error, ABS(back[x][y] - mesh[x][y]));
+    }
+  return max_error;
+}
+
+int main() {
+
+  mesh_t mesh, back;
+  mesh_slot_t packed;
+
+  // Layout: the CRC first, the data right after it up to the end of the slot
+  HOST_CHECK(offsetof(mesh_slot_t, bed_temp) == sizeof(packed.crc), "data starts at %i", int(offsetof(mesh_slot_t, bed_temp)));
+  HOST_CHECK(sizeof(mesh_slot_t) <= sizeof(mesh_t) / 2 + 12, "slot of %i bytes for a mesh of %i", int(sizeof(mesh_slot_t)), int(sizeof(mesh_t)));
+
+  // Random meshes around an offset, with unprobed points
+  for (uint8_t n = 0; n < 100; n++) {
+    const float offset = random_mm(5.0f);
+    for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+      for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+        mesh[x][y] = (x + y + n) % 7 == 0 ? NAN : offset + random_mm(2.0f);
+    const float error = round_trip(mesh, back, packed);
+    HOST_CHECK(error <= 0.00051f, "mesh %i: error %.6fmm", n, error);
+  }
+
+  // Nothing probed
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      mesh[x][y] = NAN;
+  round_trip(mesh, back, packed);
+  HOST_CHECK(packed.mean == 0.0f, "unprobed mesh: mean %f", packed.mean);
+
+  // Points too far from the mean are clamped, not taken as unprobed
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      mesh[x][y] = 0.0f;
+  mesh[0][0] = 100.0f;
+  mesh[1][0] = -100.0f;
+  mesh[2][0] = NAN;
+  round_trip(mesh, back, packed);
+  HOST_CHECK(packed.z_um[0][0] == INT16_MAX && packed.z_um[1][0] == INT16_MIN + 1, "clamped to %i and %i", packed.z_um[0][0], packed.z_um[1][0]);
+
+  // Store and load a slot
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      mesh[x][y] = x == y ? NAN : random_mm(1.0f);
+  pack_mesh(packed, mesh);
+  packed.bed_temp = 605;
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  const int slot_pos = 8;
+  store_slot(packed, slot_pos);
+
+  mesh_slot_t loaded;
+  HOST_CHECK(load_slot(loaded, slot_pos), "CRC of the stored slot does not match");
+  HOST_CHECK(loaded.bed_temp == 605, "bed temperature %i", loaded.bed_temp);
+  unpack_mesh(loaded, back);
+  mesh_t expected;
+  unpack_mesh(packed, expected);
+  for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+    for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+      HOST_CHECK(isnan(back[x][y]) ? isnan(expected[x][y]) : back[x][y] == expected[x][y], "loaded point %i,%i differs", x, y);
+
+  // A flipped bit anywhere in the slot is found, the CRC itself included
+  uint16_t missed = 0;
+  for (uint16_t i = slot_pos; i < slot_pos + sizeof(mesh_slot_t); i++)
+    for (uint8_t b = 0; b < 8; b++) {
+      eeprom[i] ^= _BV(b);
+      if (load_slot(loaded, slot_pos)) missed++;
+      eeprom[i] ^= _BV(b);
+    }
+  HOST_CHECK(missed == 0, "%i flipped bits not found", missed);
+  HOST_CHECK(load_slot(loaded, slot_pos), "CRC of the restored slot does not match");
+
+  return HOST_TEST_RESULT("mesh_slot");
+}
@@ -0,0 +1,118 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * runaway_model_test.cpp - Model based thermal runaway detector
+ *
+ * An MPC hotend holds the target on the simulated plant of M309, with a
+ * noisy sensor, and the detector runs from the time the target is reached
+ * as in Heater::runaway_model_check(). A heater weaker or stronger than the
+ * model and part fan changes must not trip it, with a clean or a noisy
+ * sensor; an open heater and a detached sensor must trip it well before
+ * THERMAL_PROTECTION_PERIOD.
+ */
+
+#include "MK4duo.h"
+
+#define HEATER_SIMULATION
+#define MPC_TEMP
+#define THERMAL_PROTECTION_MODEL
+
+#include "Configuration_Temperature.h"
+#include "src/core/tempmanager/pid/pid.h"
+#include "src/core/tempmanager/mpc/mpc.h"
+#include "src/core/tempmanager/simulation/heater_plant.h"
+#include "src/core/tempmanager/runaway/runaway.h"
+#include "host/mpc_defaults.h"
+
+#define TEST_TARGET     200.0f  // (C)
+#define TEST_HOLD       600     // (s) Hold after the target is reached
+#define TEST_FAULT_AT   300     // (s) Fault injected after the target is reached
+
+static uint32_t seed = 1;
+
+// Uniform noise in -peak..peak
+static float noise(const float peak) {
+  seed = seed * 1103515245UL + 12345UL;
+  return ((seed >> 16) & 0x7FFF) * (2.0f * peak / 32767.0f) - peak;
+}
+
+/**
+ * Heat up and hold, toggle the part fan every minute of the hold and
+ * inject the fault. Return the seconds from the fault to the trip,
+ * or -1 if the detector never tripped.
+ */
+static float run(const float power_scale, const float peak_noise, const SimFaultEnum fault) {
+  const float hotend_plant[] = SIM_HOTEND_PLANT;
+  const uint32_t per_second = 1000UL / (PID_SAMPLE_TIME);
+  heater_plant_t plant;
+  mpc_data_t mpc;
+  runaway_model_t runaway;
+
+  plant.init(hotend_plant);
+  plant.power *= power_scale;
+  init_mpc(mpc);
+  runaway.init();
+  seed = 1;
+
+  uint8_t pwm = 0, fan_speed = 0;
+  uint32_t held = 0;
+  for (uint32_t i = 0; i < 1200UL * per_second; i++) {
+    plant.update(PID_dT, pwm, fan_speed);
+    const float temp = plant.sensor_temp + noise(peak_noise);
+    if (held || temp >= TEST_TARGET) {
+      if (held == TEST_FAULT_AT * per_second) plant.fault = fault;
+      if (runaway.check(mpc, temp, pwm, fan_speed, 0.0f, THERMAL_PROTECTION_MODEL_LIMIT))
+        return fault == SIM_FAULT_NONE ? held * PID_dT : float(held) * PID_dT - (TEST_FAULT_AT);
+      if (++held == TEST_HOLD * per_second) return -1.0f;
+      if (held % (60 * per_second) == 0) fan_speed = fan_speed ? 0 : 255;
+    }
+    pwm = mpc.compute(TEST_TARGET, temp, POWER_MAX, fan_speed, 0.0f);
+  }
+  return -1.0f;
+}
+
+int main() {
+
+  const float scale[] = { 1.0f, 0.8f, 1.2f },
+              peak[]  = { 0.05f, 0.3f };
+
+  for (uint8_t n = 0; n < COUNT(peak); n++) {
+
+    // No false trip
+    for (uint8_t i = 0; i < COUNT(scale); i++) {
+      const float trip = run(scale[i], peak[n], SIM_FAULT_NONE);
+      printf("%3i%% power, noise %.2fC: hold       %s\n", int(scale[i] * 100), peak[n], trip < 0.0f ? "no trip" : "TRIPPED");
+      HOST_CHECK(trip < 0.0f, "%i%% power, noise %.2fC: tripped %.1fs into the hold", int(scale[i] * 100), peak[n], trip);
+    }
+
+    // Faults are found
+    const float open = run(0.8f, peak[n], SIM_FAULT_HEATER),
+                detached = run(0.8f, peak[n], SIM_FAULT_SENSOR_DETACHED);
+    printf("noise %.2fC: open heater tripped in     %5.1fs\n", peak[n], open);
+    printf("noise %.2fC: detached sensor tripped in %5.1fs\n", peak[n], detached);
+    HOST_CHECK(open >= 0.0f && open < 0.5f * (THERMAL_PROTECTION_PERIOD), "open heater: trip in %.1fs", open);
+    HOST_CHECK(detached >= 0.0f && detached < 5.0f, "detached sensor: trip in %.1fs", detached);
+  }
+
+  return HOST_TEST_RESULT("runaway_model");
+}